@@ -3,6 +3,9 @@
 
 #include "BaseEnemy.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Game/TPPLockOnSubsystem.h"
+#include "Game/TPPSignificanceSubsystem.h"
+#include "Debug/TPPStartupProfiler.h"
 
 // Sets default values
 ABaseEnemy::ABaseEnemy()
@@ -19,8 +22,43 @@ FVector ABaseEnemy::GetLockOnLocation()
 // Called when the game starts or when spawned
 void ABaseEnemy::BeginPlay()
 {
+	FTPPScopedStartupTimer StartupTimer(this);
 	Super::BeginPlay();
 	StartingPosition = GetActorLocation();
+
+	UTPPSignificanceSubsystem* SignificanceSubsystem = UTPPSignificanceSubsystem::Get(this);
+	if (SignificanceSubsystem)
+	{
+		SignificanceSubsystem->RegisterActor(this);
+	}
+
+	UTPPLockOnSubsystem* LockOnSubsystem = UTPPLockOnSubsystem::Get(this);
+	if (LockOnSubsystem && bCanBeLockedOnto)
+	{
+		LockOnSubsystem->RegisterTarget(this);
+	}
+}
+
+void ABaseEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UTPPSignificanceSubsystem* SignificanceSubsystem = UTPPSignificanceSubsystem::Get(this);
+	if (SignificanceSubsystem)
+	{
+		SignificanceSubsystem->UnregisterActor(this);
+	}
+
+	UTPPLockOnSubsystem* LockOnSubsystem = UTPPLockOnSubsystem::Get(this);
+	if (LockOnSubsystem)
+	{
+		LockOnSubsystem->UnregisterTarget(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ABaseEnemy::OnSignificanceTierChanged(ETPPSignificanceTier NewTier, const FTPPSignificanceTierSettings& TierSettings)
+{
+	SetActorTickInterval(TierSettings.TickInterval);
 }
 
 // Called every frame
@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Debug/TPPInputRecording.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace TPPInputRecording
+{
+	static const uint32 FileMagic = 0x49505054; // 'TPPI'
+	static const int32 FileVersion = 1;
+
+	/** Flags marking which fields of a frame differ from the previous frame */
+	enum EFrameField : uint8
+	{
+		DeltaTime = 1 << 0,
+		MoveForward = 1 << 1,
+		MoveRight = 1 << 2,
+		FireWeapon = 1 << 3,
+		ControlRotation = 1 << 4,
+		Actions = 1 << 5
+	};
+}
+
+void FTPPInputRecording::Reset()
+{
+	MapName.Reset();
+	StartLocation = FVector::ZeroVector;
+	StartRotation = FRotator::ZeroRotator;
+	Frames.Reset();
+}
+
+FArchive& operator<<(FArchive& Ar, FTPPInputRecording& Recording)
+{
+	using namespace TPPInputRecording;
+
+	uint32 Magic = FileMagic;
+	int32 Version = FileVersion;
+	Ar << Magic;
+	Ar << Version;
+	if (Ar.IsLoading() && (Magic != FileMagic || Version != FileVersion))
+	{
+		Ar.SetError();
+		return Ar;
+	}
+
+	Ar << Recording.MapName;
+	Ar << Recording.StartLocation;
+	Ar << Recording.StartRotation;
+
+	int32 NumFrames = Recording.Frames.Num();
+	Ar << NumFrames;
+	if (Ar.IsLoading())
+	{
+		if (NumFrames < 0)
+		{
+			Ar.SetError();
+			return Ar;
+		}
+		Recording.Frames.SetNum(NumFrames);
+	}
+
+	// Input rarely changes every frame, so only write the fields that differ from the previous frame. Comparisons are exact to keep replays lossless.
+	FTPPRecordedInputFrame PreviousFrame;
+	for (int32 i = 0; i < NumFrames && !Ar.IsError(); ++i)
+	{
+		FTPPRecordedInputFrame& Frame = Recording.Frames[i];
+
+		uint8 ChangedFields = 0;
+		if (Ar.IsSaving())
+		{
+			ChangedFields |= Frame.DeltaTime != PreviousFrame.DeltaTime ? EFrameField::DeltaTime : 0;
+			ChangedFields |= Frame.MoveForwardValue != PreviousFrame.MoveForwardValue ? EFrameField::MoveForward : 0;
+			ChangedFields |= Frame.MoveRightValue != PreviousFrame.MoveRightValue ? EFrameField::MoveRight : 0;
+			ChangedFields |= Frame.FireWeaponAxisValue != PreviousFrame.FireWeaponAxisValue ? EFrameField::FireWeapon : 0;
+			ChangedFields |= !Frame.ControlRotation.Equals(PreviousFrame.ControlRotation, 0.0f) ? EFrameField::ControlRotation : 0;
+			ChangedFields |= (Frame.PressedActions | Frame.ReleasedActions) != 0 ? EFrameField::Actions : 0;
+		}
+		else
+		{
+			Frame = PreviousFrame;
+			Frame.PressedActions = 0;
+			Frame.ReleasedActions = 0;
+		}
+
+		Ar << ChangedFields;
+		if (ChangedFields & EFrameField::DeltaTime)
+		{
+			Ar << Frame.DeltaTime;
+		}
+		if (ChangedFields & EFrameField::MoveForward)
+		{
+			Ar << Frame.MoveForwardValue;
+		}
+		if (ChangedFields & EFrameField::MoveRight)
+		{
+			Ar << Frame.MoveRightValue;
+		}
+		if (ChangedFields & EFrameField::FireWeapon)
+		{
+			Ar << Frame.FireWeaponAxisValue;
+		}
+		if (ChangedFields & EFrameField::ControlRotation)
+		{
+			Ar << Frame.ControlRotation;
+		}
+		if (ChangedFields & EFrameField::Actions)
+		{
+			Ar << Frame.PressedActions;
+			Ar << Frame.ReleasedActions;
+		}
+
+		// Pawn trace changes every frame while moving so it is always written.
+		Ar << Frame.PawnLocation;
+		Ar << Frame.PawnVelocity;
+
+		PreviousFrame = Frame;
+	}
+
+	return Ar;
+}
+
+bool FTPPInputRecording::SaveToFile(const FString& Filename) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Writer << const_cast<FTPPInputRecording&>(*this);
+
+	return FFileHelper::SaveArrayToFile(Bytes, *GetRecordingPath(Filename));
+}
+
+bool FTPPInputRecording::LoadFromFile(const FString& Filename)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *GetRecordingPath(Filename)))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	Reader << *this;
+	if (Reader.IsError())
+	{
+		Reset();
+		return false;
+	}
+
+	return true;
+}
+
+FString FTPPInputRecording::GetRecordingPath(const FString& Filename)
+{
+	FString RecordingPath = Filename;
+	if (FPaths::GetExtension(RecordingPath).IsEmpty())
+	{
+		RecordingPath += TEXT(".tppinput");
+	}
+
+	if (FPaths::IsRelative(RecordingPath))
+	{
+		RecordingPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("InputRecordings"), RecordingPath);
+	}
+
+	return RecordingPath;
+}
@@ -0,0 +1,210 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Debug/TPPLatencySubsystem.h"
+#include "Engine/World.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+CSV_DEFINE_CATEGORY(TPPLatency, true);
+
+const float FTPPLatencyHistogram::BucketLimits[] = { 1.0f, 2.0f, 4.0f, 8.0f, 16.0f, 33.0f, 50.0f, 66.0f, 100.0f, 150.0f, 250.0f };
+
+FTPPLatencyHistogram::FTPPLatencyHistogram()
+{
+	Reset();
+}
+
+void FTPPLatencyHistogram::AddSample(float LatencyMs)
+{
+	int32 BucketIndex = 0;
+	while (BucketIndex < NumBuckets - 1 && LatencyMs > BucketLimits[BucketIndex])
+	{
+		++BucketIndex;
+	}
+
+	++BucketCounts[BucketIndex];
+	MinLatency = NumSamples == 0 ? LatencyMs : FMath::Min(MinLatency, LatencyMs);
+	MaxLatency = FMath::Max(MaxLatency, LatencyMs);
+	TotalLatency += LatencyMs;
+	++NumSamples;
+}
+
+void FTPPLatencyHistogram::Reset()
+{
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		BucketCounts[i] = 0;
+	}
+
+	NumSamples = 0;
+	MinLatency = 0.0f;
+	MaxLatency = 0.0f;
+	TotalLatency = 0.0;
+}
+
+float FTPPLatencyHistogram::GetPercentileUpperBound(float Percentile) const
+{
+	const uint32 TargetCount = FMath::CeilToInt(NumSamples * Percentile);
+	uint32 Count = 0;
+	for (int32 i = 0; i < NumBuckets - 1; ++i)
+	{
+		Count += BucketCounts[i];
+		if (Count >= TargetCount)
+		{
+			return BucketLimits[i];
+		}
+	}
+
+	return MaxLatency;
+}
+
+FString FTPPLatencyHistogram::ToString() const
+{
+	FString Result = FString::Printf(TEXT("n=%u min=%.2f avg=%.2f max=%.2f p50<=%.0f p95<=%.0f |"), NumSamples, MinLatency, NumSamples > 0 ? TotalLatency / NumSamples : 0.0, MaxLatency,
+		GetPercentileUpperBound(.5f), GetPercentileUpperBound(.95f));
+
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		if (i < NumBuckets - 1)
+		{
+			Result += FString::Printf(TEXT(" <=%.0f:%u"), BucketLimits[i], BucketCounts[i]);
+		}
+		else
+		{
+			Result += FString::Printf(TEXT(" >%.0f:%u"), BucketLimits[i - 1], BucketCounts[i]);
+		}
+	}
+
+	return Result;
+}
+
+UTPPLatencySubsystem* UTPPLatencySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UTPPLatencySubsystem>() : nullptr;
+}
+
+bool UTPPLatencySubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	return Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+uint16 UTPPLatencySubsystem::BeginSequence(const UObject* Owner, ETPPLatencyTrace Trace, double StartTime)
+{
+	// 0 is never used, so it can mean no sequence.
+	LastSequenceId = LastSequenceId == MAX_uint16 ? 1 : LastSequenceId + 1;
+	AddSequence(Owner, Trace, LastSequenceId, StartTime);
+	return LastSequenceId;
+}
+
+void UTPPLatencySubsystem::MarkStage(const UObject* Owner, ETPPLatencyTrace Trace, uint16 SequenceId, ETPPLatencyStage Stage)
+{
+	if (SequenceId == 0 || Stage >= ETPPLatencyStage::MAX)
+	{
+		return;
+	}
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	const FTPPLatencySequence* Sequence = FindSequence(Owner, Trace, SequenceId);
+	if (!Sequence)
+	{
+		AddSequence(Owner, Trace, SequenceId, CurrentTime);
+		return;
+	}
+
+	const float LatencyMs = (float)((CurrentTime - Sequence->StartTime) * 1000.0);
+	StageHistograms[(int32)Stage].AddSample(LatencyMs);
+
+#if CSV_PROFILER
+	static const TArray<FName> StageStatNames = []()
+	{
+		TArray<FName> Names;
+		const UEnum* StageEnum = StaticEnum<ETPPLatencyStage>();
+		for (int32 i = 0; i < (int32)ETPPLatencyStage::MAX; ++i)
+		{
+			Names.Add(FName(*StageEnum->GetNameStringByValue(i)));
+		}
+		return Names;
+	}();
+	FCsvProfiler::RecordCustomStat(StageStatNames[(int32)Stage], CSV_CATEGORY_INDEX(TPPLatency), LatencyMs, ECsvCustomStatOp::Set);
+#endif
+}
+
+void UTPPLatencySubsystem::MarkLatestStage(const UObject* Owner, ETPPLatencyTrace Trace, ETPPLatencyStage Stage, bool bEndSequence)
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+	for (int32 i = 1; i <= MaxOpenSequences; ++i)
+	{
+		const FTPPLatencySequence& Sequence = OpenSequences[(NextSequenceSlot - i + MaxOpenSequences) % MaxOpenSequences];
+		if (Sequence.SequenceId != 0 && Sequence.Trace == Trace && Sequence.Owner == Owner && CurrentTime - Sequence.StartTime <= MaxSequenceAge)
+		{
+			const uint16 SequenceId = Sequence.SequenceId;
+			MarkStage(Owner, Trace, SequenceId, Stage);
+			if (bEndSequence)
+			{
+				EndSequence(Owner, Trace, SequenceId);
+			}
+			return;
+		}
+	}
+}
+
+void UTPPLatencySubsystem::EndSequence(const UObject* Owner, ETPPLatencyTrace Trace, uint16 SequenceId)
+{
+	FTPPLatencySequence* Sequence = FindSequence(Owner, Trace, SequenceId);
+	if (Sequence)
+	{
+		*Sequence = FTPPLatencySequence();
+	}
+}
+
+void UTPPLatencySubsystem::DumpHistograms() const
+{
+	const UEnum* StageEnum = StaticEnum<ETPPLatencyStage>();
+	for (int32 i = 0; i < StageHistograms.Num(); ++i)
+	{
+		const FString StageName = StageEnum->GetNameStringByValue(i);
+		const FString Histogram = StageHistograms[i].ToString();
+		UE_LOG(LogTemp, Log, TEXT("Latency %s (ms): %s"), *StageName, *Histogram);
+		CSV_METADATA(*FString::Printf(TEXT("TPPLatency.%s"), *StageName), *Histogram);
+	}
+}
+
+void UTPPLatencySubsystem::ResetHistograms()
+{
+	for (int32 i = 0; i < StageHistograms.Num(); ++i)
+	{
+		StageHistograms[i].Reset();
+	}
+}
+
+FTPPLatencySequence* UTPPLatencySubsystem::FindSequence(const UObject* Owner, ETPPLatencyTrace Trace, uint16 SequenceId)
+{
+	const double CurrentTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < MaxOpenSequences; ++i)
+	{
+		FTPPLatencySequence& Sequence = OpenSequences[i];
+		if (Sequence.SequenceId == SequenceId && Sequence.Trace == Trace && Sequence.Owner == Owner)
+		{
+			return CurrentTime - Sequence.StartTime <= MaxSequenceAge ? &Sequence : nullptr;
+		}
+	}
+
+	return nullptr;
+}
+
+FTPPLatencySequence& UTPPLatencySubsystem::AddSequence(const UObject* Owner, ETPPLatencyTrace Trace, uint16 SequenceId, double StartTime)
+{
+	FTPPLatencySequence& Sequence = OpenSequences[NextSequenceSlot];
+	NextSequenceSlot = (NextSequenceSlot + 1) % MaxOpenSequences;
+
+	Sequence.Owner = Owner;
+	Sequence.Trace = Trace;
+	Sequence.SequenceId = SequenceId;
+	Sequence.StartTime = StartTime;
+	return Sequence;
+}
@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Debug/TPPStartupProfiler.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+static TAutoConsoleVariable<int32> CVarTPPDeferStartupInit(
+	TEXT("TPP.DeferStartupInit"),
+	0,
+	TEXT("If 1, HUD widgets and asset streaming requests are created the frame after BeginPlay instead of during map load."),
+	ECVF_Default);
+
+FTPPStartupProfiler& FTPPStartupProfiler::Get()
+{
+	static FTPPStartupProfiler Profiler;
+	return Profiler;
+}
+
+void FTPPStartupProfiler::Initialize()
+{
+	if (!FParse::Param(FCommandLine::Get(), TEXT("TPPProfileStartup")))
+	{
+		return;
+	}
+
+	bIsRecording = true;
+
+	// The game module loads at the end of engine pre-init, so this is the engine's startup time rather than anything the module does.
+	AddTime(TEXT("Engine Pre-Init"), FPlatformTime::Seconds() - GStartTime);
+
+	FCoreUObjectDelegates::PreLoadMap.AddRaw(this, &FTPPStartupProfiler::OnPreLoadMap);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FTPPStartupProfiler::OnPostLoadMap);
+	FCoreDelegates::OnEndFrame.AddRaw(this, &FTPPStartupProfiler::OnEndFrame);
+}
+
+void FTPPStartupProfiler::Shutdown()
+{
+	FCoreUObjectDelegates::PreLoadMap.RemoveAll(this);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+	FCoreDelegates::OnEndFrame.RemoveAll(this);
+	bIsRecording = false;
+}
+
+void FTPPStartupProfiler::AddTime(const FString& Name, double Seconds)
+{
+	if (bIsRecording)
+	{
+		FTPPStartupEntry& Entry = Entries.FindOrAdd(Name);
+		Entry.TotalSeconds += Seconds;
+		++Entry.Count;
+	}
+}
+
+bool FTPPStartupProfiler::ShouldDeferStartupInit()
+{
+	return CVarTPPDeferStartupInit.GetValueOnGameThread() != 0;
+}
+
+void FTPPStartupProfiler::OnPreLoadMap(const FString& MapName)
+{
+	LoadingMapName = MapName;
+	MapLoadStartTime = FPlatformTime::Seconds();
+}
+
+void FTPPStartupProfiler::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	if (MapLoadStartTime <= 0.0 || !LoadedWorld || !LoadedWorld->IsGameWorld())
+	{
+		return;
+	}
+
+	// Actors begin play while the map loads, so map load time includes the BeginPlay entries.
+	FirstFrameStartTime = FPlatformTime::Seconds();
+	LastFrameEndTime = FirstFrameStartTime;
+	NumFramesSinceMapLoad = 0;
+	MapLoadUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	AddTime(FString::Printf(TEXT("Map Load %s"), *LoadingMapName), FirstFrameStartTime - MapLoadStartTime);
+	MapLoadStartTime = 0.0;
+}
+
+void FTPPStartupProfiler::OnEndFrame()
+{
+	if (FirstFrameStartTime <= 0.0)
+	{
+		return;
+	}
+
+	// Work deferred with SetTimerForNextTick during map load has run by the end of the second frame, so the same span is recorded whether or not it is deferred.
+	const double FrameEndTime = FPlatformTime::Seconds();
+	++NumFramesSinceMapLoad;
+	AddTime(NumFramesSinceMapLoad == 1 ? TEXT("First Frame") : TEXT("Second Frame"), FrameEndTime - LastFrameEndTime);
+	LastFrameEndTime = FrameEndTime;
+
+	if (NumFramesSinceMapLoad >= NumFramesToRecord)
+	{
+		AddTime(TEXT("Map Load To Second Frame End"), FrameEndTime - FirstFrameStartTime);
+		Report();
+	}
+}
+
+void FTPPStartupProfiler::Report()
+{
+	Entries.ValueSort([](const FTPPStartupEntry& A, const FTPPStartupEntry& B) { return A.TotalSeconds > B.TotalSeconds; });
+
+	FString ReportText = FString::Printf(TEXT("ThirdPersonProject startup (deferred init %s)\n"), ShouldDeferStartupInit() ? TEXT("on") : TEXT("off"));
+	ReportText += FString::Printf(TEXT("%10s %6s  %s\n"), TEXT("ms"), TEXT("count"), TEXT("step"));
+	for (const TPair<FString, FTPPStartupEntry>& Entry : Entries)
+	{
+		ReportText += FString::Printf(TEXT("%10.2f %6d  %s\n"), Entry.Value.TotalSeconds * 1000.0, Entry.Value.Count, *Entry.Key);
+	}
+
+	const double BytesPerMB = 1024.0 * 1024.0;
+	ReportText += FString::Printf(TEXT("Resident memory: %.1f MB after map load, %.1f MB after the second frame\n"),
+		MapLoadUsedPhysical / BytesPerMB, FPlatformMemory::GetStats().UsedPhysical / BytesPerMB);
+
+	UE_LOG(LogTemp, Log, TEXT("%s"), *ReportText);
+
+	const FString ReportPath = FPaths::ProfilingDir() / FString::Printf(TEXT("TPPStartup-%s.txt"), *FDateTime::Now().ToString());
+	FFileHelper::SaveStringToFile(ReportText, *ReportPath);
+
+	Shutdown();
+	Entries.Empty();
+	FirstFrameStartTime = 0.0;
+	NumFramesSinceMapLoad = 0;
+}
+
+FTPPScopedStartupTimer::FTPPScopedStartupTimer(const TCHAR* InName)
+{
+	if (FTPPStartupProfiler::Get().IsRecording())
+	{
+		Name = InName;
+		StartTime = FPlatformTime::Seconds();
+	}
+}
+
+FTPPScopedStartupTimer::FTPPScopedStartupTimer(const UObject* Object)
+{
+	if (Object && FTPPStartupProfiler::Get().IsRecording())
+	{
+		Name = FString::Printf(TEXT("BeginPlay %s"), *Object->GetClass()->GetName());
+		StartTime = FPlatformTime::Seconds();
+	}
+}
+
+FTPPScopedStartupTimer::~FTPPScopedStartupTimer()
+{
+	if (StartTime > 0.0)
+	{
+		FTPPStartupProfiler::Get().AddTime(Name, FPlatformTime::Seconds() - StartTime);
+	}
+}
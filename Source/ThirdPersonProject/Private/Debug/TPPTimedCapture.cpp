@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Debug/TPPTimedCapture.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CoreDelegates.h"
+#if !UE_SERVER
+#include "Framework/Application/SlateApplication.h"
+#endif
+
+void FTPPTimedCapture::Start(int32 InNumFrames)
+{
+	if (IsCapturing() || !CanStart())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Unable to start capture of %s. A capture is already in progress, or there is nothing to time."), Description);
+		return;
+	}
+
+	NumFramesLeft = FMath::Max(InNumFrames, 1);
+	NumFrames = 0;
+	TotalSeconds = 0.0;
+	MaxSeconds = 0.0;
+
+	BindDelegates();
+}
+
+void FTPPTimedCapture::AddFrame(double FrameSeconds)
+{
+	TotalSeconds += FrameSeconds;
+	MaxSeconds = FMath::Max(MaxSeconds, FrameSeconds);
+	++NumFrames;
+
+	if (--NumFramesLeft <= 0)
+	{
+		UnbindDelegates();
+		UE_LOG(LogTemp, Log, TEXT("%s over %d frames: %.3f ms average, %.3f ms worst%s"), Description, NumFrames, TotalSeconds * 1000.0 / NumFrames, MaxSeconds * 1000.0, *GetExtraSummary());
+	}
+}
+
+FTPPFramePerfCapture& FTPPFramePerfCapture::Get()
+{
+	static FTPPFramePerfCapture Capture;
+	return Capture;
+}
+
+void FTPPFramePerfCapture::BindDelegates()
+{
+	LastFrameEndTime = 0.0;
+	MaxUsedPhysical = 0;
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FTPPFramePerfCapture::OnEndFrame);
+}
+
+void FTPPFramePerfCapture::UnbindDelegates()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+}
+
+FString FTPPFramePerfCapture::GetExtraSummary() const
+{
+	const double BytesPerMB = 1024.0 * 1024.0;
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	return FString::Printf(TEXT(". Resident memory: %.1f MB now, %.1f MB most during capture, %.1f MB process peak"),
+		MemoryStats.UsedPhysical / BytesPerMB, MaxUsedPhysical / BytesPerMB, MemoryStats.PeakUsedPhysical / BytesPerMB);
+}
+
+void FTPPFramePerfCapture::OnEndFrame()
+{
+	const double FrameEndTime = FPlatformTime::Seconds();
+	MaxUsedPhysical = FMath::Max<uint64>(MaxUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+
+	// The frame the capture started in began before it, so timing starts from its end.
+	const double PreviousFrameEndTime = LastFrameEndTime;
+	LastFrameEndTime = FrameEndTime;
+	if (PreviousFrameEndTime > 0.0)
+	{
+		AddFrame(FrameEndTime - PreviousFrameEndTime);
+	}
+}
+
+#if !UE_SERVER
+
+FTPPSlateTimingCapture& FTPPSlateTimingCapture::Get()
+{
+	static FTPPSlateTimingCapture Capture;
+	return Capture;
+}
+
+bool FTPPSlateTimingCapture::CanStart() const
+{
+	return FSlateApplication::IsInitialized();
+}
+
+void FTPPSlateTimingCapture::BindDelegates()
+{
+	TickStartTime = 0.0;
+
+	FSlateApplication& SlateApplication = FSlateApplication::Get();
+	PreTickHandle = SlateApplication.OnPreTick().AddRaw(this, &FTPPSlateTimingCapture::OnPreTick);
+	PostTickHandle = SlateApplication.OnPostTick().AddRaw(this, &FTPPSlateTimingCapture::OnPostTick);
+}
+
+void FTPPSlateTimingCapture::UnbindDelegates()
+{
+	FSlateApplication& SlateApplication = FSlateApplication::Get();
+	SlateApplication.OnPreTick().Remove(PreTickHandle);
+	SlateApplication.OnPostTick().Remove(PostTickHandle);
+}
+
+void FTPPSlateTimingCapture::OnPreTick(float DeltaTime)
+{
+	TickStartTime = FPlatformTime::Seconds();
+}
+
+void FTPPSlateTimingCapture::OnPostTick(float DeltaTime)
+{
+	if (TickStartTime > 0.0)
+	{
+		AddFrame(FPlatformTime::Seconds() - TickStartTime);
+		TickStartTime = 0.0;
+	}
+}
+
+#endif
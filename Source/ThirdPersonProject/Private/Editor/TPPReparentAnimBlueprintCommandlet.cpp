@@ -0,0 +1,139 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Editor/TPPReparentAnimBlueprintCommandlet.h"
+#include "TPPAnimInstance.h"
+
+#if WITH_EDITOR
+#include "Animation/AnimBlueprint.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_VariableSet.h"
+#include "Kismet2/BlueprintEditorUtilities.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#endif
+
+namespace TPPReparentAnimBlueprint
+{
+	static const TCHAR* DefaultAnimBlueprint = TEXT("/Game/Mannequin/Animations/ThirdPerson_AnimBP");
+}
+
+UTPPReparentAnimBlueprintCommandlet::UTPPReparentAnimBlueprintCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UTPPReparentAnimBlueprintCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString AnimBlueprintPath = TPPReparentAnimBlueprint::DefaultAnimBlueprint;
+	FParse::Value(*Params, TEXT("AnimBlueprint="), AnimBlueprintPath);
+
+	UAnimBlueprint* AnimBlueprint = LoadObject<UAnimBlueprint>(nullptr, *AnimBlueprintPath);
+	if (!AnimBlueprint)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Unable to load anim blueprint %s"), *AnimBlueprintPath);
+		return 1;
+	}
+
+	if (AnimBlueprint->ParentClass && AnimBlueprint->ParentClass->IsChildOf(UTPPAnimInstance::StaticClass()))
+	{
+		UE_LOG(LogTemp, Display, TEXT("%s is already parented to %s"), *AnimBlueprintPath, *AnimBlueprint->ParentClass->GetName());
+		return 0;
+	}
+
+	// Find blueprint variables that the native class replaces. Only exact type matches are replaced so the anim graph pins stay valid.
+	const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
+	TArray<FName> ReplacedVariables;
+	for (const FBPVariableDescription& Variable : AnimBlueprint->NewVariables)
+	{
+		const FProperty* NativeProperty = UTPPAnimInstance::StaticClass()->FindPropertyByName(Variable.VarName);
+		if (!NativeProperty)
+		{
+			continue;
+		}
+
+		FEdGraphPinType NativePinType;
+		if (K2Schema->ConvertPropertyToPinType(NativeProperty, NativePinType) && NativePinType == Variable.VarType)
+		{
+			ReplacedVariables.Add(Variable.VarName);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s has a different type to the native property and was left on the blueprint"), *Variable.VarName.ToString());
+		}
+	}
+
+	// The native properties are read only to blueprints, so the event graph nodes that used to set them are removed and the exec chain is joined up around them.
+	TArray<UEdGraph*> Graphs;
+	AnimBlueprint->GetAllGraphs(Graphs);
+	for (UEdGraph* Graph : Graphs)
+	{
+		TArray<UK2Node_VariableSet*> SetNodes;
+		Graph->GetNodesOfClass(SetNodes);
+		for (UK2Node_VariableSet* SetNode : SetNodes)
+		{
+			if (!ReplacedVariables.Contains(SetNode->GetVarName()))
+			{
+				continue;
+			}
+
+			UEdGraphPin* ExecPin = SetNode->GetExecPin();
+			UEdGraphPin* ThenPin = SetNode->GetThenPin();
+			if (ExecPin && ThenPin)
+			{
+				for (UEdGraphPin* InputLink : ExecPin->LinkedTo)
+				{
+					for (UEdGraphPin* OutputLink : ThenPin->LinkedTo)
+					{
+						InputLink->MakeLinkTo(OutputLink);
+					}
+				}
+			}
+
+			FBlueprintEditorUtils::RemoveNode(AnimBlueprint, SetNode, true);
+		}
+	}
+
+	// Move the remaining getters onto a temporary name so the blueprint variable no longer shadows the native one once reparented.
+	for (const FName& VariableName : ReplacedVariables)
+	{
+		FBlueprintEditorUtils::RenameMemberVariable(AnimBlueprint, VariableName, *FString::Printf(TEXT("%s_Replaced"), *VariableName.ToString()));
+	}
+
+	FBlueprintEditorUtils::ChangeBlueprintParent(AnimBlueprint, UTPPAnimInstance::StaticClass());
+
+	for (const FName& VariableName : ReplacedVariables)
+	{
+		const FName TemporaryName = *FString::Printf(TEXT("%s_Replaced"), *VariableName.ToString());
+		FBlueprintEditorUtils::ReplaceVariableReferences(AnimBlueprint, TemporaryName, VariableName);
+		FBlueprintEditorUtils::RemoveMemberVariable(AnimBlueprint, TemporaryName);
+		UE_LOG(LogTemp, Display, TEXT("%s now reads the native property"), *VariableName.ToString());
+	}
+
+	FKismetEditorUtilities::CompileBlueprint(AnimBlueprint);
+	if (AnimBlueprint->Status == BS_Error)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s failed to compile after reparenting. The package was not saved."), *AnimBlueprintPath);
+		return 1;
+	}
+
+	UPackage* Package = AnimBlueprint->GetOutermost();
+	const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+	if (!UPackage::SavePackage(Package, nullptr, RF_Standalone, *Filename))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to save %s"), *Filename);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Reparented %s to %s, replacing %d variables"), *AnimBlueprintPath, *UTPPAnimInstance::StaticClass()->GetName(), ReplacedVariables.Num());
+	return 0;
+#else
+	UE_LOG(LogTemp, Error, TEXT("Anim blueprints can only be reparented in the editor"));
+	return 1;
+#endif
+}
@@ -0,0 +1,208 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Game/TPPAssetStreamingSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Streamed Assets"), STAT_TPPStreamedAssets, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Proximity Preloads Requested"), STAT_TPPProximityPreloadsRequested, STATGROUP_ThirdPersonProject);
+
+UTPPAssetStreamingSubsystem* UTPPAssetStreamingSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UTPPAssetStreamingSubsystem>() : nullptr;
+}
+
+void UTPPAssetStreamingSubsystem::RequestAssets(const UObject* Requester, const TArray<FSoftObjectPath>& Assets)
+{
+	if (!Requester)
+	{
+		return;
+	}
+
+	// Reference the new assets before releasing the old ones, so assets in both sets stay loaded.
+	TArray<FSoftObjectPath> PreviousAssets;
+	RequesterAssets.RemoveAndCopyValue(Requester, PreviousAssets);
+
+	TArray<FSoftObjectPath>& HeldAssets = RequesterAssets.Add(Requester);
+	for (const FSoftObjectPath& Asset : Assets)
+	{
+		if (!Asset.IsNull() && !HeldAssets.Contains(Asset))
+		{
+			HeldAssets.Add(Asset);
+			AddAssetReference(Asset);
+		}
+	}
+
+	for (const FSoftObjectPath& Asset : PreviousAssets)
+	{
+		RemoveAssetReference(Asset);
+	}
+}
+
+void UTPPAssetStreamingSubsystem::ReleaseAssets(const UObject* Requester)
+{
+	TArray<FSoftObjectPath> HeldAssets;
+	if (RequesterAssets.RemoveAndCopyValue(Requester, HeldAssets))
+	{
+		for (const FSoftObjectPath& Asset : HeldAssets)
+		{
+			RemoveAssetReference(Asset);
+		}
+	}
+}
+
+void UTPPAssetStreamingSubsystem::RegisterProximityPreload(AActor* Actor, const TArray<FSoftObjectPath>& Assets)
+{
+	if (!Actor || Assets.Num() == 0)
+	{
+		return;
+	}
+
+	UnregisterProximityPreload(Actor);
+
+	FTPPProximityPreload& NewPreload = ProximityPreloads.AddDefaulted_GetRef();
+	NewPreload.Actor = Actor;
+	NewPreload.Assets = Assets;
+
+	// Check straight away so actors spawned next to a player don't wait for the next update.
+	TimeSinceProximityUpdate = ProximityUpdateInterval;
+}
+
+void UTPPAssetStreamingSubsystem::UnregisterProximityPreload(AActor* Actor)
+{
+	for (int32 i = ProximityPreloads.Num() - 1; i >= 0; --i)
+	{
+		if (ProximityPreloads[i].Actor == Actor)
+		{
+			if (ProximityPreloads[i].bIsRequested)
+			{
+				DEC_DWORD_STAT(STAT_TPPProximityPreloadsRequested);
+				ReleaseAssets(Actor);
+			}
+			ProximityPreloads.RemoveAtSwap(i, 1, false);
+		}
+	}
+}
+
+void UTPPAssetStreamingSubsystem::Deinitialize()
+{
+	for (TPair<FSoftObjectPath, FTPPStreamedAsset>& StreamedAsset : StreamedAssets)
+	{
+		if (StreamedAsset.Value.Handle.IsValid())
+		{
+			StreamedAsset.Value.Handle->ReleaseHandle();
+		}
+	}
+
+	DEC_DWORD_STAT_BY(STAT_TPPStreamedAssets, StreamedAssets.Num());
+	StreamedAssets.Empty();
+	RequesterAssets.Empty();
+	ProximityPreloads.Empty();
+
+	Super::Deinitialize();
+}
+
+ETickableTickType UTPPAssetStreamingSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UTPPAssetStreamingSubsystem::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return World && World->IsGameWorld() && ProximityPreloads.Num() > 0;
+}
+
+TStatId UTPPAssetStreamingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTPPAssetStreamingSubsystem, STATGROUP_Tickables);
+}
+
+void UTPPAssetStreamingSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceProximityUpdate += DeltaTime;
+	if (TimeSinceProximityUpdate >= ProximityUpdateInterval)
+	{
+		TimeSinceProximityUpdate = 0.0f;
+		UpdateProximityPreloads();
+	}
+}
+
+void UTPPAssetStreamingSubsystem::AddAssetReference(const FSoftObjectPath& Asset)
+{
+	FTPPStreamedAsset& StreamedAsset = StreamedAssets.FindOrAdd(Asset);
+	if (StreamedAsset.RefCount++ == 0)
+	{
+		INC_DWORD_STAT(STAT_TPPStreamedAssets);
+		StreamedAsset.Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Asset);
+	}
+}
+
+void UTPPAssetStreamingSubsystem::RemoveAssetReference(const FSoftObjectPath& Asset)
+{
+	FTPPStreamedAsset* StreamedAsset = StreamedAssets.Find(Asset);
+	if (!StreamedAsset || --StreamedAsset->RefCount > 0)
+	{
+		return;
+	}
+
+	// Releasing the handle lets the asset be garbage collected once nothing else references it.
+	if (StreamedAsset->Handle.IsValid())
+	{
+		StreamedAsset->Handle->ReleaseHandle();
+	}
+
+	StreamedAssets.Remove(Asset);
+	DEC_DWORD_STAT(STAT_TPPStreamedAssets);
+}
+
+void UTPPAssetStreamingSubsystem::UpdateProximityPreloads()
+{
+	TArray<FVector, TInlineAllocator<4>> LocalPawnLocations;
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		const APawn* LocalPawn = PlayerController && PlayerController->IsLocalController() ? PlayerController->GetPawn() : nullptr;
+		if (LocalPawn)
+		{
+			LocalPawnLocations.Add(LocalPawn->GetActorLocation());
+		}
+	}
+
+	const float PreloadDistanceSquared = ProximityPreloadDistance * ProximityPreloadDistance;
+	const float ReleaseDistanceSquared = ProximityReleaseDistance * ProximityReleaseDistance;
+	for (int32 i = ProximityPreloads.Num() - 1; i >= 0; --i)
+	{
+		FTPPProximityPreload& Preload = ProximityPreloads[i];
+		const AActor* Actor = Preload.Actor.Get();
+		if (!Actor)
+		{
+			ProximityPreloads.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		float ClosestDistanceSquared = BIG_NUMBER;
+		for (const FVector& PawnLocation : LocalPawnLocations)
+		{
+			ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, FVector::DistSquared(PawnLocation, Actor->GetActorLocation()));
+		}
+
+		if (!Preload.bIsRequested && ClosestDistanceSquared <= PreloadDistanceSquared)
+		{
+			Preload.bIsRequested = true;
+			INC_DWORD_STAT(STAT_TPPProximityPreloadsRequested);
+			RequestAssets(Actor, Preload.Assets);
+		}
+		else if (Preload.bIsRequested && ClosestDistanceSquared > ReleaseDistanceSquared)
+		{
+			Preload.bIsRequested = false;
+			DEC_DWORD_STAT(STAT_TPPProximityPreloadsRequested);
+			ReleaseAssets(Actor);
+		}
+	}
+}
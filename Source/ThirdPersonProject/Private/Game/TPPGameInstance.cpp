@@ -5,14 +5,18 @@
 #include "ThirdPersonProject/TPPPlayerCharacter.h"
 #include "TPPHUD.h"
 #include "Kismet/GameplayStatics.h"
+#include "Debug/TPPStartupProfiler.h"
 
 UTPPGameInstance* UTPPGameInstance::Instance = nullptr;
 
 void UTPPGameInstance::Init()
 {
+	FTPPScopedStartupTimer StartupTimer(TEXT("Game Instance Init"));
+
 	Super::Init();
 
 	AimProperties = NewObject<UTPPAimProperties>(this, AimPropertiesClass);
+	InputProperties = InputPropertiesClass ? NewObject<UTPPInputProperties>(this, InputPropertiesClass) : nullptr;
 	Instance = this;
 }
 
@@ -0,0 +1,414 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Game/TPPLockOnSubsystem.h"
+#include "Algo/Sort.h"
+#include "BaseEnemy.h"
+#include "Engine/World.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Lock On Refit"), STAT_TPPLockOnRefit, STATGROUP_ThirdPersonProject);
+DECLARE_CYCLE_STAT(TEXT("Lock On Query"), STAT_TPPLockOnQuery, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Lock On Targets"), STAT_TPPLockOnTargets, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lock On Reinsertions"), STAT_TPPLockOnReinsertions, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lock On Nodes Visited"), STAT_TPPLockOnNodesVisited, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Lock On Line Of Sight Traces"), STAT_TPPLockOnLineOfSightTraces, STATGROUP_ThirdPersonProject);
+
+namespace TPPLockOn
+{
+	/** Cone half angle in radians, kept under 90 degrees so the cone is convex */
+	float GetClampedHalfAngle(const FTPPLockOnQuery& Query)
+	{
+		return FMath::DegreesToRadians(FMath::Clamp(Query.ConeHalfAngle, 0.0f, 89.0f));
+	}
+
+	float GetSurfaceArea(const FBox& Box)
+	{
+		const FVector Size = Box.GetSize();
+		return 2.0f * (Size.X * Size.Y + Size.Y * Size.Z + Size.Z * Size.X);
+	}
+
+	/** Conservative test of a sphere against the query cone. May accept spheres just outside it. */
+	bool SphereIntersectsCone(const FVector& Center, float Radius, const FTPPLockOnQuery& Query, float SinHalfAngle, float CosHalfAngle)
+	{
+		const FVector ToCenter = Center - Query.ViewLocation;
+		const float DistanceAlongAxis = ToCenter | Query.ViewDirection;
+		if (DistanceAlongAxis < -Radius || DistanceAlongAxis - Radius > Query.MaxDistance)
+		{
+			return false;
+		}
+
+		const float DistanceFromAxis = FMath::Sqrt(FMath::Max(ToCenter.SizeSquared() - DistanceAlongAxis * DistanceAlongAxis, 0.0f));
+		return DistanceFromAxis * CosHalfAngle - DistanceAlongAxis * SinHalfAngle <= Radius;
+	}
+}
+
+UTPPLockOnSubsystem* UTPPLockOnSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UTPPLockOnSubsystem>() : nullptr;
+}
+
+void UTPPLockOnSubsystem::RegisterTarget(ABaseEnemy* Target)
+{
+	if (!Target || TargetLeaves.Contains(Target))
+	{
+		return;
+	}
+
+	const int32 LeafIndex = AllocateNode();
+	FTPPLockOnTreeNode& Leaf = Nodes[LeafIndex];
+	Leaf.Target = Target;
+	Leaf.TargetLocation = Target->GetLockOnLocation();
+	Leaf.Bounds = GetLeafBounds(Leaf.TargetLocation);
+	InsertLeaf(LeafIndex);
+	TargetLeaves.Add(Target, LeafIndex);
+
+	SET_DWORD_STAT(STAT_TPPLockOnTargets, TargetLeaves.Num());
+}
+
+void UTPPLockOnSubsystem::UnregisterTarget(ABaseEnemy* Target)
+{
+	int32 LeafIndex;
+	if (TargetLeaves.RemoveAndCopyValue(Target, LeafIndex))
+	{
+		RemoveLeaf(LeafIndex);
+		ReleaseNode(LeafIndex);
+	}
+
+	SET_DWORD_STAT(STAT_TPPLockOnTargets, TargetLeaves.Num());
+}
+
+ABaseEnemy* UTPPLockOnSubsystem::FindBestTarget(const FTPPLockOnQuery& Query) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPPLockOnQuery);
+
+	const UWorld* World = GetWorld();
+	if (!World || RootNode == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	float SinHalfAngle, CosHalfAngle;
+	FMath::SinCos(&SinHalfAngle, &CosHalfAngle, TPPLockOn::GetClampedHalfAngle(Query));
+
+	// Best scoring targets, lowest score first
+	const int32 NumCandidates = FMath::Max(MaxLineOfSightCandidates, 1);
+	TArray<TPair<float, int32>, TInlineAllocator<8>> Candidates;
+
+	TArray<int32, TInlineAllocator<64>> NodeStack;
+	NodeStack.Add(RootNode);
+	while (NodeStack.Num() > 0)
+	{
+		const int32 NodeIndex = NodeStack.Pop(false);
+		const FTPPLockOnTreeNode& Node = Nodes[NodeIndex];
+		INC_DWORD_STAT(STAT_TPPLockOnNodesVisited);
+
+		if (!Node.IsLeaf())
+		{
+			if (TPPLockOn::SphereIntersectsCone(Node.Bounds.GetCenter(), Node.Bounds.GetExtent().Size(), Query, SinHalfAngle, CosHalfAngle))
+			{
+				NodeStack.Add(Node.Children[0]);
+				NodeStack.Add(Node.Children[1]);
+			}
+			continue;
+		}
+
+		if (!IsValid(Node.Target) || !Node.Target->CanEnemyBeLockedOnto())
+		{
+			continue;
+		}
+
+		const float Score = ScoreTarget(Query, CosHalfAngle, Node.TargetLocation);
+		if (Score == MAX_flt || (Candidates.Num() == NumCandidates && Score >= Candidates.Last().Key))
+		{
+			continue;
+		}
+
+		int32 InsertIndex = Candidates.Num();
+		while (InsertIndex > 0 && Candidates[InsertIndex - 1].Key > Score)
+		{
+			--InsertIndex;
+		}
+		Candidates.Insert(TPair<float, int32>(Score, NodeIndex), InsertIndex);
+		if (Candidates.Num() > NumCandidates)
+		{
+			Candidates.Pop(false);
+		}
+	}
+
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(TPPLockOnLineOfSight), false, Query.IgnoredActor);
+	for (const TPair<float, int32>& Candidate : Candidates)
+	{
+		const FTPPLockOnTreeNode& Leaf = Nodes[Candidate.Value];
+		TraceParams.ClearIgnoredActors();
+		TraceParams.AddIgnoredActor(Query.IgnoredActor);
+		TraceParams.AddIgnoredActor(Leaf.Target);
+
+		INC_DWORD_STAT(STAT_TPPLockOnLineOfSightTraces);
+		if (!World->LineTraceTestByChannel(Query.ViewLocation, Leaf.TargetLocation, LineOfSightChannel, TraceParams))
+		{
+			return Leaf.Target;
+		}
+	}
+
+	return nullptr;
+}
+
+float UTPPLockOnSubsystem::GetTargetScore(const FTPPLockOnQuery& Query, const FVector& TargetLocation) const
+{
+	return ScoreTarget(Query, FMath::Cos(TPPLockOn::GetClampedHalfAngle(Query)), TargetLocation);
+}
+
+float UTPPLockOnSubsystem::ScoreTarget(const FTPPLockOnQuery& Query, float CosHalfAngle, const FVector& TargetLocation) const
+{
+	const FVector ToTarget = TargetLocation - Query.ViewLocation;
+	const float DistanceSquared = ToTarget.SizeSquared();
+	if (DistanceSquared > Query.MaxDistance * Query.MaxDistance || DistanceSquared < KINDA_SMALL_NUMBER)
+	{
+		return MAX_flt;
+	}
+
+	const float Distance = FMath::Sqrt(DistanceSquared);
+	const float CosAngle = (ToTarget | Query.ViewDirection) / Distance;
+	if (CosAngle < CosHalfAngle)
+	{
+		return MAX_flt;
+	}
+
+	return AngleScoreWeight * (1.0f - CosAngle) / FMath::Max(1.0f - CosHalfAngle, KINDA_SMALL_NUMBER) + DistanceScoreWeight * Distance / FMath::Max(Query.MaxDistance, 1.0f);
+}
+
+ETickableTickType UTPPLockOnSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UTPPLockOnSubsystem::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return World && World->IsGameWorld() && TargetLeaves.Num() > 0;
+}
+
+TStatId UTPPLockOnSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTPPLockOnSubsystem, STATGROUP_Tickables);
+}
+
+void UTPPLockOnSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPPLockOnRefit);
+
+	for (const TPair<ABaseEnemy*, int32>& TargetLeaf : TargetLeaves)
+	{
+		FTPPLockOnTreeNode& Leaf = Nodes[TargetLeaf.Value];
+		Leaf.TargetLocation = TargetLeaf.Key->GetLockOnLocation();
+		if (Leaf.Bounds.IsInsideOrOn(Leaf.TargetLocation))
+		{
+			continue;
+		}
+
+		INC_DWORD_STAT(STAT_TPPLockOnReinsertions);
+		RemoveLeaf(TargetLeaf.Value);
+		Nodes[TargetLeaf.Value].Bounds = GetLeafBounds(Nodes[TargetLeaf.Value].TargetLocation);
+		InsertLeaf(TargetLeaf.Value);
+	}
+
+	// Incremental insertion doesn't rotate the tree, so rebuild once it is well past the balanced height.
+	if (GetTreeHeight() > GetMaxTreeHeight(TargetLeaves.Num()))
+	{
+		RebuildTree();
+	}
+}
+
+int32 UTPPLockOnSubsystem::AllocateNode()
+{
+	int32 NodeIndex = FreeNode;
+	if (NodeIndex != INDEX_NONE)
+	{
+		FreeNode = Nodes[NodeIndex].Parent;
+		Nodes[NodeIndex] = FTPPLockOnTreeNode();
+	}
+	else
+	{
+		NodeIndex = Nodes.AddDefaulted();
+	}
+
+	return NodeIndex;
+}
+
+void UTPPLockOnSubsystem::ReleaseNode(int32 NodeIndex)
+{
+	FTPPLockOnTreeNode& Node = Nodes[NodeIndex];
+	Node.Target = nullptr;
+	Node.Height = INDEX_NONE;
+	Node.Parent = FreeNode;
+	FreeNode = NodeIndex;
+}
+
+void UTPPLockOnSubsystem::InsertLeaf(int32 LeafIndex)
+{
+	if (RootNode == INDEX_NONE)
+	{
+		RootNode = LeafIndex;
+		Nodes[LeafIndex].Parent = INDEX_NONE;
+		return;
+	}
+
+	// Descend towards the sibling that grows the total surface area the least.
+	const FBox LeafBounds = Nodes[LeafIndex].Bounds;
+	int32 SiblingIndex = RootNode;
+	while (!Nodes[SiblingIndex].IsLeaf())
+	{
+		const FTPPLockOnTreeNode& Node = Nodes[SiblingIndex];
+		const float CombinedArea = TPPLockOn::GetSurfaceArea(Node.Bounds + LeafBounds);
+		const float Cost = 2.0f * CombinedArea;
+		const float InheritanceCost = 2.0f * (CombinedArea - TPPLockOn::GetSurfaceArea(Node.Bounds));
+
+		float ChildCosts[2];
+		for (int32 i = 0; i < 2; ++i)
+		{
+			const FTPPLockOnTreeNode& Child = Nodes[Node.Children[i]];
+			ChildCosts[i] = TPPLockOn::GetSurfaceArea(Child.Bounds + LeafBounds) + InheritanceCost;
+			if (!Child.IsLeaf())
+			{
+				ChildCosts[i] -= TPPLockOn::GetSurfaceArea(Child.Bounds);
+			}
+		}
+
+		if (Cost < ChildCosts[0] && Cost < ChildCosts[1])
+		{
+			break;
+		}
+
+		SiblingIndex = ChildCosts[0] < ChildCosts[1] ? Node.Children[0] : Node.Children[1];
+	}
+
+	const int32 NewParentIndex = AllocateNode();
+	const int32 OldParentIndex = Nodes[SiblingIndex].Parent;
+
+	FTPPLockOnTreeNode& NewParent = Nodes[NewParentIndex];
+	NewParent.Parent = OldParentIndex;
+	NewParent.Children[0] = SiblingIndex;
+	NewParent.Children[1] = LeafIndex;
+	Nodes[SiblingIndex].Parent = NewParentIndex;
+	Nodes[LeafIndex].Parent = NewParentIndex;
+
+	if (OldParentIndex == INDEX_NONE)
+	{
+		RootNode = NewParentIndex;
+	}
+	else
+	{
+		FTPPLockOnTreeNode& OldParent = Nodes[OldParentIndex];
+		OldParent.Children[OldParent.Children[0] == SiblingIndex ? 0 : 1] = NewParentIndex;
+	}
+
+	RefitAncestors(NewParentIndex);
+}
+
+void UTPPLockOnSubsystem::RemoveLeaf(int32 LeafIndex)
+{
+	if (LeafIndex == RootNode)
+	{
+		RootNode = INDEX_NONE;
+		return;
+	}
+
+	const int32 ParentIndex = Nodes[LeafIndex].Parent;
+	const FTPPLockOnTreeNode& Parent = Nodes[ParentIndex];
+	const int32 GrandParentIndex = Parent.Parent;
+	const int32 SiblingIndex = Parent.Children[0] == LeafIndex ? Parent.Children[1] : Parent.Children[0];
+
+	Nodes[SiblingIndex].Parent = GrandParentIndex;
+	if (GrandParentIndex == INDEX_NONE)
+	{
+		RootNode = SiblingIndex;
+	}
+	else
+	{
+		FTPPLockOnTreeNode& GrandParent = Nodes[GrandParentIndex];
+		GrandParent.Children[GrandParent.Children[0] == ParentIndex ? 0 : 1] = SiblingIndex;
+	}
+
+	ReleaseNode(ParentIndex);
+	Nodes[LeafIndex].Parent = INDEX_NONE;
+	RefitAncestors(GrandParentIndex);
+}
+
+void UTPPLockOnSubsystem::RefitAncestors(int32 NodeIndex)
+{
+	while (NodeIndex != INDEX_NONE)
+	{
+		FTPPLockOnTreeNode& Node = Nodes[NodeIndex];
+		const FTPPLockOnTreeNode& FirstChild = Nodes[Node.Children[0]];
+		const FTPPLockOnTreeNode& SecondChild = Nodes[Node.Children[1]];
+		Node.Bounds = FirstChild.Bounds + SecondChild.Bounds;
+		Node.Height = 1 + FMath::Max(FirstChild.Height, SecondChild.Height);
+		NodeIndex = Node.Parent;
+	}
+}
+
+void UTPPLockOnSubsystem::RebuildTree()
+{
+	TArray<int32> Leaves;
+	Leaves.Reserve(TargetLeaves.Num());
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		if (Nodes[i].IsLeaf())
+		{
+			Leaves.Add(i);
+		}
+		else if (Nodes[i].Height > 0)
+		{
+			ReleaseNode(i);
+		}
+	}
+
+	RootNode = Leaves.Num() > 0 ? BuildSubtree(Leaves, 0, Leaves.Num()) : INDEX_NONE;
+	if (RootNode != INDEX_NONE)
+	{
+		Nodes[RootNode].Parent = INDEX_NONE;
+	}
+}
+
+int32 UTPPLockOnSubsystem::BuildSubtree(TArray<int32>& Leaves, int32 Start, int32 Count)
+{
+	if (Count == 1)
+	{
+		return Leaves[Start];
+	}
+
+	FBox CenterBounds(ForceInit);
+	for (int32 i = Start; i < Start + Count; ++i)
+	{
+		CenterBounds += Nodes[Leaves[i]].Bounds.GetCenter();
+	}
+
+	const FVector CenterExtent = CenterBounds.GetExtent();
+	const int32 SplitAxis = CenterExtent.X >= CenterExtent.Y && CenterExtent.X >= CenterExtent.Z ? 0 : (CenterExtent.Y >= CenterExtent.Z ? 1 : 2);
+	Algo::Sort(MakeArrayView(Leaves).Slice(Start, Count), [this, SplitAxis](int32 A, int32 B)
+	{
+		return Nodes[A].Bounds.GetCenter()[SplitAxis] < Nodes[B].Bounds.GetCenter()[SplitAxis];
+	});
+
+	const int32 FirstCount = Count / 2;
+	const int32 FirstChildIndex = BuildSubtree(Leaves, Start, FirstCount);
+	const int32 SecondChildIndex = BuildSubtree(Leaves, Start + FirstCount, Count - FirstCount);
+
+	const int32 NodeIndex = AllocateNode();
+	FTPPLockOnTreeNode& Node = Nodes[NodeIndex];
+	Node.Children[0] = FirstChildIndex;
+	Node.Children[1] = SecondChildIndex;
+	Node.Bounds = Nodes[FirstChildIndex].Bounds + Nodes[SecondChildIndex].Bounds;
+	Node.Height = 1 + FMath::Max(Nodes[FirstChildIndex].Height, Nodes[SecondChildIndex].Height);
+	Nodes[FirstChildIndex].Parent = NodeIndex;
+	Nodes[SecondChildIndex].Parent = NodeIndex;
+
+	return NodeIndex;
+}
+
+FBox UTPPLockOnSubsystem::GetLeafBounds(const FVector& TargetLocation) const
+{
+	return FBox::BuildAABB(TargetLocation, FVector(LeafBoundsMargin));
+}
@@ -0,0 +1,264 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Game/TPPPickupSubsystem.h"
+#include "Pickups/TPPPickupBase.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "ThirdPersonProject/TPPPlayerCharacter.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pickup Update"), STAT_TPPPickupUpdate, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pickups Registered"), STAT_TPPPickupsRegistered, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pickup Respawns Pending"), STAT_TPPPickupRespawnsPending, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickup Proximity Tests"), STAT_TPPPickupProximityTests, STATGROUP_ThirdPersonProject);
+
+UTPPPickupSubsystem* UTPPPickupSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UTPPPickupSubsystem>() : nullptr;
+}
+
+void UTPPPickupSubsystem::RegisterPickup(ATPPPickupBase* Pickup)
+{
+	if (!Pickup)
+	{
+		return;
+	}
+
+	UnregisterPickup(Pickup);
+
+	const FIntVector CellKey = GetCellKey(Pickup->GetActorLocation());
+	PickupCells.FindOrAdd(CellKey).Add(Pickup);
+	PickupCellKeys.Add(Pickup, CellKey);
+	MaxPickupRadius = FMath::Max(MaxPickupRadius, Pickup->PickupRadius);
+
+	SET_DWORD_STAT(STAT_TPPPickupsRegistered, PickupCellKeys.Num());
+}
+
+void UTPPPickupSubsystem::UnregisterPickup(ATPPPickupBase* Pickup)
+{
+	FIntVector CellKey;
+	if (!PickupCellKeys.RemoveAndCopyValue(Pickup, CellKey))
+	{
+		return;
+	}
+
+	TArray<ATPPPickupBase*>* CellPickups = PickupCells.Find(CellKey);
+	if (CellPickups)
+	{
+		CellPickups->RemoveSingleSwap(Pickup, false);
+		if (CellPickups->Num() == 0)
+		{
+			PickupCells.Remove(CellKey);
+		}
+	}
+
+	// Pending respawns hold weak pointers and are skipped once the pickup is gone.
+	SET_DWORD_STAT(STAT_TPPPickupsRegistered, PickupCellKeys.Num());
+}
+
+void UTPPPickupSubsystem::RegisterCharacter(ATPPPlayerCharacter* Character)
+{
+	if (!Character || Collectors.ContainsByPredicate([Character](const FTPPPickupCollector& Collector) { return Collector.Character == Character; }))
+	{
+		return;
+	}
+
+	FTPPPickupCollector& NewCollector = Collectors.AddDefaulted_GetRef();
+	NewCollector.Character = Character;
+}
+
+void UTPPPickupSubsystem::UnregisterCharacter(ATPPPlayerCharacter* Character)
+{
+	Collectors.RemoveAllSwap([Character](const FTPPPickupCollector& Collector) { return Collector.Character == Character; });
+}
+
+void UTPPPickupSubsystem::ScheduleRespawn(ATPPPickupBase* Pickup, float Delay)
+{
+	const UWorld* World = GetWorld();
+	if (!Pickup || !World)
+	{
+		return;
+	}
+
+	const float CurrentTime = World->GetTimeSeconds();
+	if (LastProcessedSlot == INDEX_NONE || NumPendingRespawns == 0)
+	{
+		LastProcessedSlot = GetAbsoluteSlot(CurrentTime);
+	}
+
+	FTPPPickupRespawn NewRespawn;
+	NewRespawn.Pickup = Pickup;
+	NewRespawn.RespawnTime = CurrentTime + FMath::Max(Delay, 0.0f);
+	RespawnSlots[GetAbsoluteSlot(NewRespawn.RespawnTime) % NumRespawnSlots].Add(NewRespawn);
+	++NumPendingRespawns;
+
+	SET_DWORD_STAT(STAT_TPPPickupRespawnsPending, NumPendingRespawns);
+}
+
+void UTPPPickupSubsystem::OnPickupActivated(ATPPPickupBase* Pickup)
+{
+	if (!Pickup || Pickup->bRequiresPlayerInteractionKey)
+	{
+		return;
+	}
+
+	for (const FTPPPickupCollector& Collector : Collectors)
+	{
+		ATPPPlayerCharacter* Character = Collector.Character.Get();
+		if (Character && IsWithinReach(Character, Pickup))
+		{
+			Pickup->TryPickup(Character);
+			if (!Pickup->IsPickupActive())
+			{
+				return;
+			}
+		}
+	}
+}
+
+ETickableTickType UTPPPickupSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UTPPPickupSubsystem::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return World && World->IsGameWorld() && (NumPendingRespawns > 0 || (Collectors.Num() > 0 && PickupCellKeys.Num() > 0));
+}
+
+TStatId UTPPPickupSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTPPPickupSubsystem, STATGROUP_Tickables);
+}
+
+void UTPPPickupSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPPPickupUpdate);
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	if (NumPendingRespawns > 0)
+	{
+		// The current slot is processed again next tick, as only part of it may be due. Past slots are fully due.
+		const int64 CurrentSlot = GetAbsoluteSlot(CurrentTime);
+		const int64 FirstSlot = FMath::Max(LastProcessedSlot, CurrentSlot - NumRespawnSlots + 1);
+		for (int64 Slot = FirstSlot; Slot <= CurrentSlot && NumPendingRespawns > 0; ++Slot)
+		{
+			ProcessRespawnSlot(Slot, CurrentTime);
+		}
+		LastProcessedSlot = CurrentSlot;
+
+		SET_DWORD_STAT(STAT_TPPPickupRespawnsPending, NumPendingRespawns);
+	}
+
+	if (PickupCellKeys.Num() == 0)
+	{
+		return;
+	}
+
+	const float MinQueryMoveDistanceSquared = MinQueryMoveDistance * MinQueryMoveDistance;
+	for (int32 i = Collectors.Num() - 1; i >= 0; --i)
+	{
+		FTPPPickupCollector& Collector = Collectors[i];
+		ATPPPlayerCharacter* Character = Collector.Character.Get();
+		if (!Character)
+		{
+			Collectors.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		// Only moving characters can reach a new pickup. Pickups that activate under a character are handled by OnPickupActivated.
+		const FVector CharacterLocation = Character->GetActorLocation();
+		if (FVector::DistSquared(CharacterLocation, Collector.LastQueryLocation) < MinQueryMoveDistanceSquared)
+		{
+			continue;
+		}
+
+		Collector.LastQueryLocation = CharacterLocation;
+		QueryPickups(Character);
+	}
+}
+
+FIntVector UTPPPickupSubsystem::GetCellKey(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+}
+
+int64 UTPPPickupSubsystem::GetAbsoluteSlot(float WorldTime) const
+{
+	return (int64)FMath::FloorToDouble(WorldTime / FMath::Max(RespawnSlotDuration, KINDA_SMALL_NUMBER));
+}
+
+void UTPPPickupSubsystem::ProcessRespawnSlot(int64 AbsoluteSlot, float CurrentTime)
+{
+	TArray<FTPPPickupRespawn>& Slot = RespawnSlots[AbsoluteSlot % NumRespawnSlots];
+	for (int32 i = Slot.Num() - 1; i >= 0; --i)
+	{
+		// Respawns a full turn or more away share the slot and wait for a later pass.
+		if (Slot[i].RespawnTime > CurrentTime)
+		{
+			continue;
+		}
+
+		ATPPPickupBase* Pickup = Slot[i].Pickup.Get();
+		Slot.RemoveAtSwap(i, 1, false);
+		--NumPendingRespawns;
+
+		if (Pickup)
+		{
+			Pickup->Activate();
+		}
+	}
+}
+
+void UTPPPickupSubsystem::QueryPickups(ATPPPlayerCharacter* Character)
+{
+	const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+	const float QueryExtent = (Capsule ? Capsule->GetScaledCapsuleHalfHeight() : 0.0f) + MaxPickupRadius;
+	const FVector CharacterLocation = Character->GetActorLocation();
+	const FIntVector MinCell = GetCellKey(CharacterLocation - FVector(QueryExtent));
+	const FIntVector MaxCell = GetCellKey(CharacterLocation + FVector(QueryExtent));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				const TArray<ATPPPickupBase*>* CellPickups = PickupCells.Find(FIntVector(X, Y, Z));
+				if (!CellPickups)
+				{
+					continue;
+				}
+
+				// Copy, as obtaining a pickup can destroy it and unregister it from this cell.
+				const TArray<ATPPPickupBase*, TInlineAllocator<16>> PickupsToTest(*CellPickups);
+				for (ATPPPickupBase* Pickup : PickupsToTest)
+				{
+					INC_DWORD_STAT(STAT_TPPPickupProximityTests);
+					if (IsValid(Pickup) && Pickup->IsPickupActive() && !Pickup->bRequiresPlayerInteractionKey && IsWithinReach(Character, Pickup))
+					{
+						Pickup->TryPickup(Character);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool UTPPPickupSubsystem::IsWithinReach(const ATPPPlayerCharacter* Character, const ATPPPickupBase* Pickup) const
+{
+	// Treat the character as its capsule's line segment.
+	const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+	const float CapsuleRadius = Capsule ? Capsule->GetScaledCapsuleRadius() : 0.0f;
+	const float SegmentHalfLength = Capsule ? FMath::Max(Capsule->GetScaledCapsuleHalfHeight() - CapsuleRadius, 0.0f) : 0.0f;
+
+	const FVector CharacterLocation = Character->GetActorLocation();
+	const FVector PickupLocation = Pickup->GetActorLocation();
+	const FVector ClosestPoint = FMath::ClosestPointOnSegment(PickupLocation, CharacterLocation - FVector(0.0f, 0.0f, SegmentHalfLength), CharacterLocation + FVector(0.0f, 0.0f, SegmentHalfLength));
+
+	const float ReachDistance = CapsuleRadius + Pickup->PickupRadius;
+	return FVector::DistSquared(ClosestPoint, PickupLocation) <= ReachDistance * ReachDistance;
+}
@@ -2,14 +2,47 @@
 
 
 #include "Game/TPPPlayerState.h"
+#include "GameFramework/GameStateBase.h"
+#include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 
 void ATPPPlayerState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(ATPPPlayerState, PlayerHealth);
-	DOREPLIFETIME(ATPPPlayerState, bIsPlayerAlive);
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerState, PlayerHealth, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerState, bIsPlayerAlive, Params);
+}
+
+float ATPPPlayerState::GetServerWorldTimeSeconds() const
+{
+	const UWorld* World = GetWorld();
+	const AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+	if (GameState)
+	{
+		return GameState->GetServerWorldTimeSeconds();
+	}
+
+	return World ? World->GetTimeSeconds() : 0.0f;
+}
+
+float ATPPPlayerState::GetHealth() const
+{
+	if (PlayerHealth.RegenRate <= 0.0f)
+	{
+		return PlayerHealth.HealthAtStart;
+	}
+
+	const float RegenElapsedTime = FMath::Max(0.0f, GetServerWorldTimeSeconds() - PlayerHealth.RegenStartServerTime);
+	return FMath::Min(PlayerHealth.HealthAtStart + (PlayerHealth.RegenRate * RegenElapsedTime), PlayerHealth.MaxHealth);
+}
+
+bool ATPPPlayerState::IsRegeneratingHealth() const
+{
+	return PlayerHealth.RegenRate > 0.0f && GetHealth() < PlayerHealth.MaxHealth;
 }
 
 void ATPPPlayerState::OnRep_PlayerHealth()
@@ -19,7 +52,62 @@ void ATPPPlayerState::OnRep_PlayerHealth()
 
 void ATPPPlayerState::SetPlayerHealth_Implementation(float Health)
 {
-	PlayerHealth = Health;
+	PlayerHealth.HealthAtStart = Health;
+	PlayerHealth.RegenStartServerTime = GetServerWorldTimeSeconds();
 	bIsPlayerAlive = Health > 0.0f;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerState, PlayerHealth, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerState, bIsPlayerAlive, this);
 	OnRep_PlayerHealth();
+	UpdateRegenCompleteTimer();
+}
+
+void ATPPPlayerState::BeginHealthRegen(float RegenRate, float MaxHealth)
+{
+	if (!HasAuthority() || !bIsPlayerAlive)
+	{
+		return;
+	}
+
+	PlayerHealth.HealthAtStart = GetHealth();
+	PlayerHealth.RegenStartServerTime = GetServerWorldTimeSeconds();
+	PlayerHealth.RegenRate = RegenRate;
+	PlayerHealth.MaxHealth = MaxHealth;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerState, PlayerHealth, this);
+	OnRep_PlayerHealth();
+	UpdateRegenCompleteTimer();
+}
+
+void ATPPPlayerState::StopHealthRegen()
+{
+	if (!HasAuthority() || PlayerHealth.RegenRate <= 0.0f)
+	{
+		return;
+	}
+
+	GetWorldTimerManager().ClearTimer(RegenCompleteTimerHandle);
+
+	// Fold the health gained so far into the base value before clearing the rate.
+	PlayerHealth.HealthAtStart = GetHealth();
+	PlayerHealth.RegenStartServerTime = GetServerWorldTimeSeconds();
+	PlayerHealth.RegenRate = 0.0f;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerState, PlayerHealth, this);
+	OnRep_PlayerHealth();
+}
+
+void ATPPPlayerState::UpdateRegenCompleteTimer()
+{
+	if (!HasAuthority() || PlayerHealth.RegenRate <= 0.0f)
+	{
+		return;
+	}
+
+	// Clients extrapolate from the rate, so it has to be cleared once max health is reached.
+	const float HealthToRegen = PlayerHealth.MaxHealth - GetHealth();
+	if (HealthToRegen <= 0.0f)
+	{
+		StopHealthRegen();
+		return;
+	}
+
+	GetWorldTimerManager().SetTimer(RegenCompleteTimerHandle, this, &ATPPPlayerState::StopHealthRegen, HealthToRegen / PlayerHealth.RegenRate, false);
 }
@@ -0,0 +1,208 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Game/TPPRagdollSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ragdoll Update"), STAT_TPPRagdollUpdate, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ragdolls Simulating"), STAT_TPPRagdollsSimulating, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ragdolls Sleeping"), STAT_TPPRagdollsSleeping, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ragdolls Frozen"), STAT_TPPRagdollsFrozen, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ragdoll Simulated Bodies"), STAT_TPPRagdollSimulatedBodies, STATGROUP_ThirdPersonProject);
+
+UTPPRagdollSubsystem* UTPPRagdollSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UTPPRagdollSubsystem>() : nullptr;
+}
+
+void UTPPRagdollSubsystem::RegisterRagdoll(USkeletalMeshComponent* Mesh)
+{
+	if (!Mesh)
+	{
+		return;
+	}
+
+	UnregisterRagdoll(Mesh);
+
+	FTPPRagdollEntry NewEntry;
+	NewEntry.Mesh = Mesh;
+	NewEntry.StartTime = GetWorld()->GetTimeSeconds();
+	RagdollEntries.Add(NewEntry);
+}
+
+void UTPPRagdollSubsystem::UnregisterRagdoll(USkeletalMeshComponent* Mesh)
+{
+	// Keep entries ordered oldest first for recycling.
+	RagdollEntries.RemoveAll([Mesh](const FTPPRagdollEntry& Entry) { return Entry.Mesh == Mesh; });
+}
+
+ETickableTickType UTPPRagdollSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UTPPRagdollSubsystem::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return World && World->IsGameWorld() && RagdollEntries.Num() > 0;
+}
+
+TStatId UTPPRagdollSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTPPRagdollSubsystem, STATGROUP_Tickables);
+}
+
+void UTPPRagdollSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPPRagdollUpdate);
+
+	RagdollEntries.RemoveAll([](const FTPPRagdollEntry& Entry) { return !Entry.Mesh.IsValid(); });
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	const float SleepVelocityThresholdSquared = SleepVelocityThreshold * SleepVelocityThreshold;
+
+	for (FTPPRagdollEntry& Entry : RagdollEntries)
+	{
+		USkeletalMeshComponent* Mesh = Entry.Mesh.Get();
+		if (Entry.State == ETPPRagdollState::Frozen)
+		{
+			continue;
+		}
+
+		if (CurrentTime - Entry.StartTime >= FreezeTimeout)
+		{
+			FreezeRagdoll(Entry);
+			continue;
+		}
+
+		if (Entry.State == ETPPRagdollState::Sleeping)
+		{
+			// Something has hit the corpse, so let it settle again.
+			if (Mesh->RigidBodyIsAwake())
+			{
+				Entry.State = ETPPRagdollState::Simulating;
+				Entry.SettledTime = 0.0f;
+			}
+			continue;
+		}
+
+		if (Mesh->GetPhysicsLinearVelocity().SizeSquared() < SleepVelocityThresholdSquared)
+		{
+			Entry.SettledTime += DeltaTime;
+			if (Entry.SettledTime >= SleepDelay)
+			{
+				Mesh->PutAllRigidBodiesToSleep();
+				Entry.State = ETPPRagdollState::Sleeping;
+			}
+		}
+		else
+		{
+			Entry.SettledTime = 0.0f;
+		}
+	}
+
+	// Freeze the oldest ragdolls still simulating when over budget.
+	int32 NumSimulating = RagdollEntries.FilterByPredicate([](const FTPPRagdollEntry& Entry) { return Entry.State == ETPPRagdollState::Simulating; }).Num();
+	for (int32 i = 0; i < RagdollEntries.Num() && NumSimulating > MaxSimulatingRagdolls; ++i)
+	{
+		if (RagdollEntries[i].State == ETPPRagdollState::Simulating)
+		{
+			FreezeRagdoll(RagdollEntries[i]);
+			--NumSimulating;
+		}
+	}
+
+	// The server owns the corpse budget so every machine removes the same corpses. Clients drop the ones it has hidden or destroyed.
+	if (GetWorld()->GetNetMode() != NM_Client)
+	{
+		while (RagdollEntries.Num() > FMath::Max(MaxCorpses, 0))
+		{
+			// Recycling can destroy the pawn, which unregisters its ragdoll, so take the entry out of the list first.
+			FTPPRagdollEntry OldestEntry = RagdollEntries[0];
+			RagdollEntries.RemoveAt(0);
+			RecycleRagdoll(OldestEntry);
+		}
+	}
+	else
+	{
+		for (int32 i = RagdollEntries.Num() - 1; i >= 0; --i)
+		{
+			const AActor* Owner = RagdollEntries[i].Mesh->GetOwner();
+			if (Owner && Owner->IsHidden())
+			{
+				FreezeRagdoll(RagdollEntries[i]);
+				RagdollEntries.RemoveAt(i);
+			}
+		}
+	}
+
+#if STATS
+	uint32 StateCounts[3] = {};
+	uint32 NumSimulatedBodies = 0;
+	for (const FTPPRagdollEntry& Entry : RagdollEntries)
+	{
+		++StateCounts[(int32)Entry.State];
+		if (Entry.State != ETPPRagdollState::Frozen)
+		{
+			NumSimulatedBodies += Entry.Mesh->Bodies.Num();
+		}
+	}
+
+	SET_DWORD_STAT(STAT_TPPRagdollsSimulating, StateCounts[(int32)ETPPRagdollState::Simulating]);
+	SET_DWORD_STAT(STAT_TPPRagdollsSleeping, StateCounts[(int32)ETPPRagdollState::Sleeping]);
+	SET_DWORD_STAT(STAT_TPPRagdollsFrozen, StateCounts[(int32)ETPPRagdollState::Frozen]);
+	SET_DWORD_STAT(STAT_TPPRagdollSimulatedBodies, NumSimulatedBodies);
+#endif
+}
+
+void UTPPRagdollSubsystem::FreezeRagdoll(FTPPRagdollEntry& Entry)
+{
+	USkeletalMeshComponent* Mesh = Entry.Mesh.Get();
+	if (!Mesh)
+	{
+		return;
+	}
+
+	Mesh->SetAllBodiesSimulatePhysics(false);
+	Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// Hold the last simulated pose instead of returning to the animated pose.
+	Mesh->bNoSkeletonUpdate = true;
+	Mesh->SetComponentTickEnabled(false);
+
+	Entry.State = ETPPRagdollState::Frozen;
+}
+
+void UTPPRagdollSubsystem::RecycleRagdoll(FTPPRagdollEntry& Entry)
+{
+	USkeletalMeshComponent* Mesh = Entry.Mesh.Get();
+	if (!Mesh)
+	{
+		return;
+	}
+
+	AActor* Owner = Mesh->GetOwner();
+	APawn* OwningPawn = Cast<APawn>(Owner);
+	if (OwningPawn && !OwningPawn->GetController())
+	{
+		OwningPawn->Destroy();
+		return;
+	}
+
+	FreezeRagdoll(Entry);
+
+	// Hiding the actor rather than the mesh replicates, so clients remove the same corpse.
+	if (Owner)
+	{
+		Owner->SetActorHiddenInGame(true);
+		Owner->SetActorEnableCollision(false);
+	}
+	else
+	{
+		Mesh->SetVisibility(false, true);
+	}
+}
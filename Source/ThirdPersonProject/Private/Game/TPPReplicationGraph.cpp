@@ -0,0 +1,276 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Game/TPPReplicationGraph.h"
+#include "ReplicationGraphTypes.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "HAL/IConsoleManager.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "GameFramework/PlayerState.h"
+#include "ThirdPersonProject/TPPPlayerCharacter.h"
+#include "BaseEnemy.h"
+#include "Pickups/TPPPickupBase.h"
+#include "Weapon/TPPWeaponBase.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rep Graph Connections"), STAT_TPPRepGraphConnections, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Weapons Replicated With Owner"), STAT_TPPWeaponsReplicatedWithOwner, STATGROUP_ThirdPersonProject);
+DECLARE_CYCLE_STAT(TEXT("Rep Graph Replicate Actors"), STAT_TPPRepGraphReplicateActors, STATGROUP_ThirdPersonProject);
+
+static TAutoConsoleVariable<int32> CVarTPPRepGraphScalingLogFrames(
+	TEXT("TPP.RepGraphScalingLogFrames"),
+	0,
+	TEXT("If above 0, the replication graph logs its average replication time and connection count every this many net ticks. Used for connection scaling runs."),
+	ECVF_Default);
+
+void UTPPReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// Player states are gathered by the frequency limiter node rather than routed.
+	ClassRepNodePolicies.Set(APlayerState::StaticClass(), ETPPClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(ATPPPlayerCharacter::StaticClass(), ETPPClassRepNodeMapping::Spatialize_Dynamic);
+	ClassRepNodePolicies.Set(ABaseEnemy::StaticClass(), ETPPClassRepNodeMapping::Spatialize_Dynamic);
+	ClassRepNodePolicies.Set(ATPPWeaponBase::StaticClass(), ETPPClassRepNodeMapping::Weapon);
+
+	// Pickups start dormant and never move, so they only need to be placed in the grid once.
+	ClassRepNodePolicies.Set(ATPPPickupBase::StaticClass(), ETPPClassRepNodeMapping::Spatialize_Static);
+
+	InitClassReplicationInfo(ATPPPlayerCharacter::StaticClass());
+	InitClassReplicationInfo(ABaseEnemy::StaticClass());
+	InitClassReplicationInfo(ATPPWeaponBase::StaticClass());
+	InitClassReplicationInfo(ATPPPickupBase::StaticClass());
+}
+
+void UTPPReplicationGraph::InitGlobalGraphNodes()
+{
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = GridSpatialBias;
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+
+	PlayerStateNode = CreateNewNode<UReplicationGraphNode_PlayerStateFrequencyLimiter>();
+	PlayerStateNode->TargetActorsPerFrame = PlayerStatesPerFrame;
+	AddGlobalGraphNode(PlayerStateNode);
+
+	ATPPWeaponBase::OnWeaponOwnerChanged.AddUObject(this, &UTPPReplicationGraph::OnWeaponOwnerChanged);
+}
+
+void UTPPReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	// Adds the connection's player controller, pawn and view target.
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantForConnectionNode = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(AlwaysRelevantForConnectionNode, RepGraphConnection);
+
+	INC_DWORD_STAT(STAT_TPPRepGraphConnections);
+}
+
+void UTPPReplicationGraph::RemoveClientConnection(UNetConnection* NetConnection)
+{
+	DEC_DWORD_STAT(STAT_TPPRepGraphConnections);
+
+	Super::RemoveClientConnection(NetConnection);
+}
+
+void UTPPReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+		case ETPPClassRepNodeMapping::RelevantAllConnections:
+		{
+			AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+			break;
+		}
+		case ETPPClassRepNodeMapping::Spatialize_Static:
+		{
+			GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+			break;
+		}
+		case ETPPClassRepNodeMapping::Spatialize_Dynamic:
+		{
+			GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+			break;
+		}
+		case ETPPClassRepNodeMapping::Spatialize_Dormancy:
+		{
+			GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+			break;
+		}
+		case ETPPClassRepNodeMapping::Weapon:
+		{
+			// Dropped weapons keep their last owner but are dormant, so they are spatialized like any other pickup.
+			ATPPWeaponBase* Weapon = CastChecked<ATPPWeaponBase>(ActorInfo.Actor);
+			AddWeapon(Weapon, Weapon->NetDormancy == DORM_Awake ? Weapon->GetCharacterOwner() : nullptr);
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+}
+
+void UTPPReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+		case ETPPClassRepNodeMapping::RelevantAllConnections:
+		{
+			AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+			break;
+		}
+		case ETPPClassRepNodeMapping::Spatialize_Static:
+		{
+			GridNode->RemoveActor_Static(ActorInfo);
+			break;
+		}
+		case ETPPClassRepNodeMapping::Spatialize_Dynamic:
+		{
+			GridNode->RemoveActor_Dynamic(ActorInfo);
+			break;
+		}
+		case ETPPClassRepNodeMapping::Spatialize_Dormancy:
+		{
+			GridNode->RemoveActor_Dormancy(ActorInfo);
+			break;
+		}
+		case ETPPClassRepNodeMapping::Weapon:
+		{
+			RemoveWeapon(CastChecked<ATPPWeaponBase>(ActorInfo.Actor));
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+}
+
+int32 UTPPReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPPRepGraphReplicateActors);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 NumReplicatedActors = Super::ServerReplicateActors(DeltaSeconds);
+
+	const int32 LogFrames = CVarTPPRepGraphScalingLogFrames.GetValueOnGameThread();
+	if (LogFrames > 0)
+	{
+		ScalingLogSeconds += FPlatformTime::Seconds() - StartTime;
+		ScalingLogReplicatedActors += NumReplicatedActors;
+		if (++ScalingLogFrames >= LogFrames)
+		{
+			const int32 NumConnections = NetDriver ? NetDriver->ClientConnections.Num() : 0;
+			// Replication time includes property comparison, so runs with push model on and off show what push model saves.
+			UE_LOG(LogTemp, Log, TEXT("Rep graph scaling: %d connections, push model %s, %.3f ms per net tick, %.3f ms per connection, %.1f actors replicated per net tick"),
+				NumConnections, IS_PUSH_MODEL_ENABLED() ? TEXT("on") : TEXT("off"), ScalingLogSeconds * 1000.0 / ScalingLogFrames,
+				ScalingLogSeconds * 1000.0 / ScalingLogFrames / FMath::Max(NumConnections, 1), (float)ScalingLogReplicatedActors / ScalingLogFrames);
+
+			ScalingLogSeconds = 0.0;
+			ScalingLogFrames = 0;
+			ScalingLogReplicatedActors = 0;
+		}
+	}
+
+	return NumReplicatedActors;
+}
+
+void UTPPReplicationGraph::BeginDestroy()
+{
+	ATPPWeaponBase::OnWeaponOwnerChanged.RemoveAll(this);
+
+	Super::BeginDestroy();
+}
+
+ETPPClassRepNodeMapping UTPPReplicationGraph::GetMappingPolicy(UClass* Class)
+{
+	const ETPPClassRepNodeMapping* ExistingPolicy = ClassRepNodePolicies.Get(Class);
+	if (ExistingPolicy)
+	{
+		return *ExistingPolicy;
+	}
+
+	// Classes without an explicit policy are routed the same way the net driver would consider them relevant.
+	const AActor* ActorCDO = Class ? Class->GetDefaultObject<AActor>() : nullptr;
+	ETPPClassRepNodeMapping Policy = ETPPClassRepNodeMapping::Spatialize_Dynamic;
+	if (!ActorCDO || ActorCDO->bOnlyRelevantToOwner)
+	{
+		Policy = ETPPClassRepNodeMapping::NotRouted;
+	}
+	else if (ActorCDO->bAlwaysRelevant)
+	{
+		Policy = ETPPClassRepNodeMapping::RelevantAllConnections;
+	}
+	else if (ActorCDO->NetDormancy == DORM_Initial)
+	{
+		Policy = ETPPClassRepNodeMapping::Spatialize_Dormancy;
+	}
+
+	ClassRepNodePolicies.Set(Class, Policy);
+	return Policy;
+}
+
+void UTPPReplicationGraph::InitClassReplicationInfo(UClass* Class)
+{
+	const AActor* ActorCDO = Class->GetDefaultObject<AActor>();
+
+	FClassReplicationInfo ClassInfo;
+	ClassInfo.SetCullDistanceSquared(ActorCDO->NetCullDistanceSquared);
+	ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(ActorCDO->NetUpdateFrequency);
+	GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+}
+
+void UTPPReplicationGraph::OnWeaponOwnerChanged(ATPPWeaponBase* Weapon, ATPPPlayerCharacter* NewOwner)
+{
+	// Weapons are only moved once they have been routed, which happens as soon as they are spawned on the server.
+	if (Weapon && WeaponOwners.Contains(Weapon))
+	{
+		RemoveWeapon(Weapon);
+		AddWeapon(Weapon, NewOwner);
+	}
+}
+
+void UTPPReplicationGraph::AddWeapon(ATPPWeaponBase* Weapon, ATPPPlayerCharacter* Owner)
+{
+	WeaponOwners.Add(Weapon, Owner);
+
+	if (Owner)
+	{
+		// Equipped weapons replicate to exactly the connections their owner replicates to.
+		GlobalActorReplicationInfoMap.AddDependentActor(Owner, Weapon);
+		INC_DWORD_STAT(STAT_TPPWeaponsReplicatedWithOwner);
+	}
+	else
+	{
+		GridNode->AddActor_Dormancy(FNewReplicatedActorInfo(Weapon), GlobalActorReplicationInfoMap.Get(Weapon));
+	}
+}
+
+void UTPPReplicationGraph::RemoveWeapon(ATPPWeaponBase* Weapon)
+{
+	TWeakObjectPtr<ATPPPlayerCharacter> Owner;
+	if (!WeaponOwners.RemoveAndCopyValue(Weapon, Owner))
+	{
+		return;
+	}
+
+	if (Owner.IsExplicitlyNull())
+	{
+		GridNode->RemoveActor_Dormancy(FNewReplicatedActorInfo(Weapon));
+	}
+	else
+	{
+		// The owner's replication info goes away with it, so there is nothing to remove if it was destroyed first.
+		if (Owner.IsValid())
+		{
+			GlobalActorReplicationInfoMap.RemoveDependentActor(Owner.Get(), Weapon);
+		}
+		DEC_DWORD_STAT(STAT_TPPWeaponsReplicatedWithOwner);
+	}
+}
@@ -0,0 +1,199 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Game/TPPSignificanceSubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_TPPSignificanceUpdate, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance High"), STAT_TPPSignificanceHigh, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Medium"), STAT_TPPSignificanceMedium, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Low"), STAT_TPPSignificanceLow, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Significance Culled"), STAT_TPPSignificanceCulled, STATGROUP_ThirdPersonProject);
+
+UTPPSignificanceSubsystem::UTPPSignificanceSubsystem()
+{
+	TierSettings.SetNum((int32)ETPPSignificanceTier::MAX);
+
+	FTPPSignificanceTierSettings& HighSettings = TierSettings[(int32)ETPPSignificanceTier::High];
+	HighSettings.MaxDistance = 1500.0f;
+	HighSettings.MinScreenRadius = .08f;
+
+	FTPPSignificanceTierSettings& MediumSettings = TierSettings[(int32)ETPPSignificanceTier::Medium];
+	MediumSettings.MaxDistance = 4000.0f;
+	MediumSettings.MinScreenRadius = .02f;
+	MediumSettings.TickInterval = 1.0f / 30.0f;
+	MediumSettings.bUseUpdateRateOptimizations = true;
+
+	FTPPSignificanceTierSettings& LowSettings = TierSettings[(int32)ETPPSignificanceTier::Low];
+	LowSettings.MaxDistance = 8000.0f;
+	LowSettings.TickInterval = .1f;
+	LowSettings.bUseUpdateRateOptimizations = true;
+	LowSettings.AnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	LowSettings.bUpdateWeaponSpread = false;
+	LowSettings.bUseWeaponIK = false;
+	LowSettings.bSpawnCosmetics = false;
+
+	FTPPSignificanceTierSettings& CulledSettings = TierSettings[(int32)ETPPSignificanceTier::Culled];
+	CulledSettings.TickInterval = .25f;
+	CulledSettings.bUseUpdateRateOptimizations = true;
+	CulledSettings.AnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+	CulledSettings.bUpdateWeaponSpread = false;
+	CulledSettings.bUseWeaponIK = false;
+	CulledSettings.bSpawnCosmetics = false;
+}
+
+UTPPSignificanceSubsystem* UTPPSignificanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UTPPSignificanceSubsystem>() : nullptr;
+}
+
+void UTPPSignificanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Tiers are looked up and counted by ETPPSignificanceTier, so config has to leave exactly one entry per tier.
+	const int32 NumTiers = (int32)ETPPSignificanceTier::MAX;
+	if (TierSettings.Num() != NumTiers)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Expected %d significance tier settings but config has %d. Extra tiers are ignored and missing tiers use default settings."), NumTiers, TierSettings.Num());
+		TierSettings.SetNum(NumTiers);
+	}
+}
+
+void UTPPSignificanceSubsystem::RegisterActor(AActor* Actor)
+{
+	if (!Actor || !Actor->Implements<UTPPSignificanceInterface>())
+	{
+		return;
+	}
+
+	const bool bIsRegistered = SignificanceEntries.ContainsByPredicate([Actor](const FTPPSignificanceEntry& Entry) { return Entry.Actor == Actor; });
+	if (!bIsRegistered)
+	{
+		FTPPSignificanceEntry NewEntry;
+		NewEntry.Actor = Actor;
+		SignificanceEntries.Add(NewEntry);
+	}
+}
+
+void UTPPSignificanceSubsystem::UnregisterActor(AActor* Actor)
+{
+	SignificanceEntries.RemoveAllSwap([Actor](const FTPPSignificanceEntry& Entry) { return Entry.Actor == Actor; });
+}
+
+const FTPPSignificanceTierSettings& UTPPSignificanceSubsystem::GetTierSettings(ETPPSignificanceTier Tier) const
+{
+	const int32 TierIndex = FMath::Clamp((int32)Tier, 0, TierSettings.Num() - 1);
+	return TierSettings[TierIndex];
+}
+
+ETickableTickType UTPPSignificanceSubsystem::GetTickableTickType() const
+{
+	return HasAnyFlags(RF_ClassDefaultObject) ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UTPPSignificanceSubsystem::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return World && World->IsGameWorld();
+}
+
+TStatId UTPPSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTPPSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UTPPSignificanceSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceSignificanceUpdate += DeltaTime;
+	if (TimeSinceSignificanceUpdate < SignificanceUpdateInterval)
+	{
+		return;
+	}
+	TimeSinceSignificanceUpdate = 0.0f;
+
+	// Significance is only meaningful with a local view. Dedicated servers leave everything at full rate.
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (!PlayerController || !PlayerController->IsLocalController())
+	{
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	const float ViewFOV = PlayerController->PlayerCameraManager ? PlayerController->PlayerCameraManager->GetFOVAngle() : 90.0f;
+
+	UpdateSignificance(ViewLocation, ViewFOV);
+}
+
+void UTPPSignificanceSubsystem::UpdateSignificance(const FVector& ViewLocation, const float ViewFOV)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPPSignificanceUpdate);
+
+	const float TanHalfFOV = FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(ViewFOV, 1.0f, 170.0f) * .5f));
+
+	uint32 TierCounts[(int32)ETPPSignificanceTier::MAX] = {};
+	for (int32 i = SignificanceEntries.Num() - 1; i >= 0; --i)
+	{
+		FTPPSignificanceEntry& Entry = SignificanceEntries[i];
+		AActor* Actor = Entry.Actor.Get();
+		if (!Actor)
+		{
+			SignificanceEntries.RemoveAtSwap(i);
+			continue;
+		}
+
+		const ETPPSignificanceTier NewTier = CalculateTier(Actor, ViewLocation, TanHalfFOV);
+		if (NewTier != Entry.Tier)
+		{
+			Entry.Tier = NewTier;
+			Cast<ITPPSignificanceInterface>(Actor)->OnSignificanceTierChanged(NewTier, GetTierSettings(NewTier));
+		}
+
+		++TierCounts[(int32)Entry.Tier];
+	}
+
+	SET_DWORD_STAT(STAT_TPPSignificanceHigh, TierCounts[(int32)ETPPSignificanceTier::High]);
+	SET_DWORD_STAT(STAT_TPPSignificanceMedium, TierCounts[(int32)ETPPSignificanceTier::Medium]);
+	SET_DWORD_STAT(STAT_TPPSignificanceLow, TierCounts[(int32)ETPPSignificanceTier::Low]);
+	SET_DWORD_STAT(STAT_TPPSignificanceCulled, TierCounts[(int32)ETPPSignificanceTier::Culled]);
+}
+
+ETPPSignificanceTier UTPPSignificanceSubsystem::CalculateTier(AActor* Actor, const FVector& ViewLocation, const float TanHalfFOV) const
+{
+	const ITPPSignificanceInterface* SignificanceInterface = Cast<ITPPSignificanceInterface>(Actor);
+	if (SignificanceInterface->IsAlwaysSignificant())
+	{
+		return ETPPSignificanceTier::High;
+	}
+
+	FVector Origin;
+	FVector BoxExtent;
+	Actor->GetActorBounds(true, Origin, BoxExtent);
+
+	const float Distance = FMath::Max(FVector::Dist(ViewLocation, Origin), 1.0f);
+	const float ScreenRadius = BoxExtent.Size() / (Distance * TanHalfFOV);
+
+	int32 TierIndex = TierSettings.Num() - 1;
+	for (int32 i = 0; i < TierSettings.Num(); ++i)
+	{
+		if (Distance <= TierSettings[i].MaxDistance && ScreenRadius >= TierSettings[i].MinScreenRadius)
+		{
+			TierIndex = i;
+			break;
+		}
+	}
+
+	// Actors that haven't been rendered recently drop a tier.
+	if (!Actor->WasRecentlyRendered(SignificanceUpdateInterval))
+	{
+		TierIndex = FMath::Min(TierIndex + 1, TierSettings.Num() - 1);
+	}
+
+	return (ETPPSignificanceTier)TierIndex;
+}
@@ -0,0 +1,219 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Game/TPPSpecialMoveSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "ThirdPersonProject/TPPPlayerCharacter.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Special Move Tick"), STAT_TPPSpecialMoveTick, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Special Moves Active"), STAT_TPPSpecialMovesActive, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Special Moves Sleeping"), STAT_TPPSpecialMovesSleeping, STATGROUP_ThirdPersonProject);
+
+void FTPPSpecialMoveTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Subsystem->TickSpecialMoves(SpecialMoveTickGroup, DeltaTime);
+	}
+}
+
+FString FTPPSpecialMoveTickFunction::DiagnosticMessage()
+{
+	return SpecialMoveTickGroup == ETPPSpecialMoveTickGroup::BeforeMovement ? TEXT("TPPSpecialMoveSubsystem[BeforeMovement]") : TEXT("TPPSpecialMoveSubsystem[AfterMovement]");
+}
+
+UTPPSpecialMoveSubsystem* UTPPSpecialMoveSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UTPPSpecialMoveSubsystem>() : nullptr;
+}
+
+void UTPPSpecialMoveSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	BeforeMovementTickFunction.Subsystem = this;
+	BeforeMovementTickFunction.SpecialMoveTickGroup = ETPPSpecialMoveTickGroup::BeforeMovement;
+	BeforeMovementTickFunction.TickGroup = TG_PrePhysics;
+
+	AfterMovementTickFunction.Subsystem = this;
+	AfterMovementTickFunction.SpecialMoveTickGroup = ETPPSpecialMoveTickGroup::AfterMovement;
+	AfterMovementTickFunction.TickGroup = TG_PostPhysics;
+
+	for (FTPPSpecialMoveTickFunction* TickFunction : { &BeforeMovementTickFunction, &AfterMovementTickFunction })
+	{
+		TickFunction->bCanEverTick = true;
+		TickFunction->bStartWithTickEnabled = false;
+		TickFunction->bAllowTickOnDedicatedServer = true;
+	}
+}
+
+void UTPPSpecialMoveSubsystem::Deinitialize()
+{
+	BeforeMovementTickFunction.UnRegisterTickFunction();
+	AfterMovementTickFunction.UnRegisterTickFunction();
+
+	BeforeMovementSpecialMoves.Reset();
+	AfterMovementSpecialMoves.Reset();
+	SleepingSpecialMoves.Reset();
+
+	Super::Deinitialize();
+}
+
+void UTPPSpecialMoveSubsystem::RegisterSpecialMove(UTPPSpecialMove* SpecialMove)
+{
+	if (!SpecialMove)
+	{
+		return;
+	}
+
+	UnregisterSpecialMove(SpecialMove);
+
+	if (SpecialMove->WantsTick())
+	{
+		GetTickList(SpecialMove->TickGroup).Add(SpecialMove);
+		UpdateTickPrerequisite(SpecialMove, SpecialMove->TickGroup, true);
+		UpdateTickFunction(SpecialMove->TickGroup);
+	}
+	else
+	{
+		SleepingSpecialMoves.Add(SpecialMove);
+	}
+
+	UpdateStats();
+}
+
+void UTPPSpecialMoveSubsystem::UnregisterSpecialMove(UTPPSpecialMove* SpecialMove)
+{
+	SleepingSpecialMoves.RemoveSingleSwap(SpecialMove, false);
+
+	for (const ETPPSpecialMoveTickGroup TickGroup : { ETPPSpecialMoveTickGroup::BeforeMovement, ETPPSpecialMoveTickGroup::AfterMovement })
+	{
+		TArray<UTPPSpecialMove*>& TickList = GetTickList(TickGroup);
+		const int32 MoveIndex = TickList.Find(SpecialMove);
+		if (MoveIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		UpdateTickPrerequisite(SpecialMove, TickGroup, false);
+
+		// Don't shuffle the list while it's being iterated.
+		if (bIsTickingSpecialMoves)
+		{
+			TickList[MoveIndex] = nullptr;
+		}
+		else
+		{
+			TickList.RemoveAtSwap(MoveIndex, 1, false);
+			UpdateTickFunction(TickGroup);
+		}
+	}
+
+	UpdateStats();
+}
+
+void UTPPSpecialMoveSubsystem::TickSpecialMoves(ETPPSpecialMoveTickGroup TickGroup, float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPPSpecialMoveTick);
+
+	TArray<UTPPSpecialMove*>& TickList = GetTickList(TickGroup);
+
+	// Moves registered during the loop start ticking next frame.
+	bIsTickingSpecialMoves = true;
+	const int32 NumSpecialMoves = TickList.Num();
+	for (int32 i = 0; i < NumSpecialMoves; ++i)
+	{
+		UTPPSpecialMove* SpecialMove = TickList[i];
+		if (SpecialMove && SpecialMove->OwningCharacter)
+		{
+			SpecialMove->Tick(DeltaTime);
+		}
+	}
+	bIsTickingSpecialMoves = false;
+
+	TickList.Remove(nullptr);
+	UpdateTickFunction(TickGroup);
+	UpdateStats();
+}
+
+TArray<UTPPSpecialMove*>& UTPPSpecialMoveSubsystem::GetTickList(ETPPSpecialMoveTickGroup TickGroup)
+{
+	return TickGroup == ETPPSpecialMoveTickGroup::AfterMovement ? AfterMovementSpecialMoves : BeforeMovementSpecialMoves;
+}
+
+FTPPSpecialMoveTickFunction& UTPPSpecialMoveSubsystem::GetTickFunction(ETPPSpecialMoveTickGroup TickGroup)
+{
+	return TickGroup == ETPPSpecialMoveTickGroup::AfterMovement ? AfterMovementTickFunction : BeforeMovementTickFunction;
+}
+
+void UTPPSpecialMoveSubsystem::UpdateTickFunction(ETPPSpecialMoveTickGroup TickGroup)
+{
+	UWorld* World = GetWorld();
+	FTPPSpecialMoveTickFunction& TickFunction = GetTickFunction(TickGroup);
+	if (!TickFunction.IsTickFunctionRegistered())
+	{
+		if (!World || !World->IsGameWorld() || !World->PersistentLevel)
+		{
+			return;
+		}
+
+		TickFunction.RegisterTickFunction(World->PersistentLevel);
+	}
+
+	TickFunction.SetTickFunctionEnable(GetTickList(TickGroup).Num() > 0);
+}
+
+void UTPPSpecialMoveSubsystem::UpdateTickPrerequisite(UTPPSpecialMove* SpecialMove, ETPPSpecialMoveTickGroup TickGroup, bool bAdd)
+{
+	const ATPPPlayerCharacter* Character = SpecialMove ? SpecialMove->OwningCharacter : nullptr;
+	UCharacterMovementComponent* MovementComponent = Character ? Character->GetCharacterMovement() : nullptr;
+	if (!MovementComponent)
+	{
+		return;
+	}
+
+	// The before movement group is a prerequisite of the movement component, and the after movement group waits on it.
+	FTPPSpecialMoveTickFunction& TickFunction = GetTickFunction(TickGroup);
+	const bool bTicksBeforeMovement = TickGroup == ETPPSpecialMoveTickGroup::BeforeMovement;
+	if (bAdd)
+	{
+		if (bTicksBeforeMovement)
+		{
+			MovementComponent->PrimaryComponentTick.AddPrerequisite(this, TickFunction);
+		}
+		else
+		{
+			TickFunction.AddPrerequisite(MovementComponent, MovementComponent->PrimaryComponentTick);
+		}
+		return;
+	}
+
+	// Keep the prerequisite while another of the character's moves is still in the group, such as a move started by an interrupt.
+	const bool bCharacterHasOtherMove = GetTickList(TickGroup).ContainsByPredicate([SpecialMove, Character](const UTPPSpecialMove* OtherMove)
+	{
+		return OtherMove && OtherMove != SpecialMove && OtherMove->OwningCharacter == Character;
+	});
+	if (bCharacterHasOtherMove)
+	{
+		return;
+	}
+
+	if (bTicksBeforeMovement)
+	{
+		MovementComponent->PrimaryComponentTick.RemovePrerequisite(this, TickFunction);
+	}
+	else
+	{
+		TickFunction.RemovePrerequisite(MovementComponent, MovementComponent->PrimaryComponentTick);
+	}
+}
+
+void UTPPSpecialMoveSubsystem::UpdateStats()
+{
+	SET_DWORD_STAT(STAT_TPPSpecialMovesActive, BeforeMovementSpecialMoves.Num() + AfterMovementSpecialMoves.Num());
+	SET_DWORD_STAT(STAT_TPPSpecialMovesSleeping, SleepingSpecialMoves.Num());
+}
@@ -3,36 +3,87 @@
 
 #include "Pickups/TPPPickupBase.h"
 #include "ThirdPersonProject/TPPPlayerCharacter.h"
+#include "Game/TPPPickupSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+#include "Debug/TPPStartupProfiler.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dormant Pickups"), STAT_TPPDormantPickups, STATGROUP_ThirdPersonProject);
 
 // Sets default values
 ATPPPickupBase::ATPPPickupBase()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// Collection and respawning are handled by the pickup subsystem.
+	PrimaryActorTick.bCanEverTick = false;
+
+	// Pickups only replicate when their active state changes, and only to nearby players.
+	bReplicates = true;
+	NetDormancy = DORM_Initial;
+	NetCullDistanceSquared = 25000000.0f;
 }
 
 // Called when the game starts or when spawned
 void ATPPPickupBase::BeginPlay()
 {
+	FTPPScopedStartupTimer StartupTimer(this);
 	Super::BeginPlay();
+
+	TInlineComponentArray<UPrimitiveComponent*> PrimitiveComponents(this);
+	for (UPrimitiveComponent* PrimitiveComponent : PrimitiveComponents)
+	{
+		PrimitiveComponent->SetGenerateOverlapEvents(false);
+	}
+
+	if (!HasAuthority())
+	{
+		ApplyActiveState();
+		return;
+	}
+
+	// Spawned pickups replicate once before going dormant. Placed pickups start dormant.
+	if (!IsNetStartupActor())
+	{
+		SetNetDormancy(DORM_DormantAll);
+	}
+	INC_DWORD_STAT(STAT_TPPDormantPickups);
+
+	UTPPPickupSubsystem* PickupSubsystem = UTPPPickupSubsystem::Get(this);
+	if (PickupSubsystem)
+	{
+		PickupSubsystem->RegisterPickup(this);
+	}
+
 	Activate();
 }
 
-// Called every frame
-void ATPPPickupBase::Tick(float DeltaTime)
+void ATPPPickupBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (HasAuthority())
+	{
+		DEC_DWORD_STAT(STAT_TPPDormantPickups);
+
+		UTPPPickupSubsystem* PickupSubsystem = UTPPPickupSubsystem::Get(this);
+		if (PickupSubsystem)
+		{
+			PickupSubsystem->UnregisterPickup(this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ATPPPickupBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
-	Super::Tick(DeltaTime);
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(ATPPPickupBase, bIsActive);
 }
 
-void ATPPPickupBase::NotifyActorBeginOverlap(AActor* OtherActor)
+void ATPPPickupBase::TryPickup(ATPPPlayerCharacter* CharacterInstigator)
 {
-	if (!bRequiresPlayerInteractionKey)
+	if (HasAuthority() && bIsActive && !bRequiresPlayerInteractionKey && CharacterInstigator && CanPickup(CharacterInstigator))
 	{
-		ATPPPlayerCharacter* CharacterOverlapped = Cast<ATPPPlayerCharacter>(OtherActor);
-		if (CharacterOverlapped && CanPickup(CharacterOverlapped))
-		{
-			ObtainPickup(CharacterOverlapped);
-		}
+		ObtainPickup(CharacterInstigator);
 	}
 }
 
@@ -48,34 +99,53 @@ void ATPPPickupBase::ObtainPickup_Implementation(ATPPPlayerCharacter* Instigator
 		}
 		else
 		{
-			FTimerManager& WorldTimerManager = GetWorldTimerManager();
-			WorldTimerManager.ClearTimer(RespawnTimerHandle);
-			WorldTimerManager.SetTimer(RespawnTimerHandle, this, &ATPPPickupBase::OnRespawnTimerExpired, RespawnTime, false);
+			UTPPPickupSubsystem* PickupSubsystem = UTPPPickupSubsystem::Get(this);
+			if (PickupSubsystem)
+			{
+				PickupSubsystem->ScheduleRespawn(this, RespawnTime);
+			}
 		}
 	}
 }
 
-void ATPPPickupBase::OnRespawnTimerExpired()
+void ATPPPickupBase::Activate()
 {
-	if (this)
+	SetPickupActive(true);
+
+	UTPPPickupSubsystem* PickupSubsystem = UTPPPickupSubsystem::Get(this);
+	if (PickupSubsystem)
 	{
-		Activate();
+		PickupSubsystem->OnPickupActivated(this);
 	}
 }
 
-void ATPPPickupBase::Activate()
+void ATPPPickupBase::Deactivate()
 {
-	bIsActive = true;
-	SetActorHiddenInGame(false);
-	SetActorEnableCollision(true);
-	OnActiveStateChanged(true);
+	SetPickupActive(false);
 }
 
-void ATPPPickupBase::Deactivate()
+void ATPPPickupBase::SetPickupActive(bool bNewIsActive)
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	// Dormant actors must be flushed before a replicated property changes, or the change is never sent.
+	FlushNetDormancy();
+	bIsActive = bNewIsActive;
+	ApplyActiveState();
+}
+
+void ATPPPickupBase::OnRep_IsActive()
+{
+	ApplyActiveState();
+}
+
+void ATPPPickupBase::ApplyActiveState()
 {
-	bIsActive = false;
-	SetActorHiddenInGame(true);
-	SetActorEnableCollision(false);
-	OnActiveStateChanged(false);
+	SetActorHiddenInGame(!bIsActive);
+	SetActorEnableCollision(bIsActive);
+	OnActiveStateChanged(bIsActive);
 }
 
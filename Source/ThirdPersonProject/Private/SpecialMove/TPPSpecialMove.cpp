@@ -17,6 +17,33 @@ UTPPSpecialMove::~UTPPSpecialMove()
 
 }
 
+ETPPCharacterCapability UTPPSpecialMove::GetBlockedCapabilities() const
+{
+	ETPPCharacterCapability BlockedCapabilities = (ETPPCharacterCapability)AdditionalBlockedCapabilities;
+	if (bDisablesSprint)
+	{
+		BlockedCapabilities |= ETPPCharacterCapability::Sprint;
+	}
+	if (bDisablesCrouch)
+	{
+		BlockedCapabilities |= ETPPCharacterCapability::Crouch | ETPPCharacterCapability::Slide;
+	}
+	if (bDisablesJump)
+	{
+		BlockedCapabilities |= ETPPCharacterCapability::Jump;
+	}
+	if (bDisablesAiming)
+	{
+		BlockedCapabilities |= ETPPCharacterCapability::Aim;
+	}
+	if (bIsWeaponUseDisabled)
+	{
+		BlockedCapabilities |= ETPPCharacterCapability::Fire | ETPPCharacterCapability::Reload;
+	}
+
+	return BlockedCapabilities;
+}
+
 void UTPPSpecialMove::Tick(float DeltaSeconds)
 {
 	if (bDurationBased)
@@ -30,9 +57,20 @@ void UTPPSpecialMove::Tick(float DeltaSeconds)
 	}
 }
 
+void UTPPSpecialMove::InitFromReplicatedSpecialMove(const FTPPReplicatedSpecialMove& ReplicatedMove)
+{
+	bIsSimulatedMove = true;
+	StartServerTime = ReplicatedMove.StartServerTime;
+}
+
+float UTPPSpecialMove::GetSimulatedElapsedTime() const
+{
+	return bIsSimulatedMove && OwningCharacter ? FMath::Max(OwningCharacter->GetServerWorldTimeSeconds() - StartServerTime, 0.0f) : 0.0f;
+}
+
 void UTPPSpecialMove::BeginSpecialMove_Implementation()
 {
-	TimeRemaining = Duration;
+	TimeRemaining = Duration - GetSimulatedElapsedTime();
 
 	USkeletalMeshComponent* SkeletalMesh = OwningCharacter->GetMesh();
 	UAnimInstance* AnimInstance = SkeletalMesh ? SkeletalMesh->GetAnimInstance() : nullptr;
@@ -42,16 +80,16 @@ void UTPPSpecialMove::BeginSpecialMove_Implementation()
 		AnimInstance->OnMontageBlendingOut.AddDynamic(this, &UTPPSpecialMove::OnMontageBlendOut);
 	}
 
-	if (bDisablesMovementInput)
+	if (bDisablesMovementInput && !bIsSimulatedMove)
 	{
-		ATPPPlayerController* PlayerController = Cast<ATPPPlayerController>(OwningCharacter->Controller);
+		ATPPPlayerController* PlayerController = OwningCharacter->GetTPPPlayerController();
 		if (PlayerController)
 		{
 			PlayerController->SetMovementInputEnabled(false);
 		}
 	}
 
-	if (bInterruptsReload)
+	if (bInterruptsReload && !bIsSimulatedMove)
 	{
 		ATPPWeaponBase* Firearm = OwningCharacter->GetCurrentEquippedWeapon();
 		if (Firearm)
@@ -70,6 +108,12 @@ void UTPPSpecialMove::OnDurationExceeded_Implementation()
 
 void UTPPSpecialMove::EndSpecialMove_Implementation()
 {
+	if (bHasEnded)
+	{
+		return;
+	}
+
+	bHasEnded = true;
 	TimeRemaining = 0.f;
 
 	USkeletalMeshComponent* SkeletalMesh = OwningCharacter->GetMesh();
@@ -80,9 +124,9 @@ void UTPPSpecialMove::EndSpecialMove_Implementation()
 		AnimInstance->OnMontageBlendingOut.RemoveDynamic(this, &UTPPSpecialMove::OnMontageBlendOut);
 	}
 
-	if (bDisablesMovementInput)
+	if (bDisablesMovementInput && !bIsSimulatedMove)
 	{
-		ATPPPlayerController* PlayerController = Cast<ATPPPlayerController>(OwningCharacter->Controller);
+		ATPPPlayerController* PlayerController = OwningCharacter->GetTPPPlayerController();
 		if (PlayerController)
 		{
 			PlayerController->SetMovementInputEnabled(true);
@@ -93,8 +137,25 @@ void UTPPSpecialMove::EndSpecialMove_Implementation()
 	OwningCharacter = nullptr;
 }
 
+void UTPPSpecialMove::ResetSpecialMove()
+{
+	bIsWeaponUseDisabled = false;
+	OwningCharacter = nullptr;
+	PredictionKey = 0;
+	TimeRemaining = 0.f;
+	bWasInterrupted = false;
+	bHasEnded = false;
+	bIsSimulatedMove = false;
+	StartServerTime = 0.0f;
+}
+
 void UTPPSpecialMove::InterruptSpecialMove()
 {
+	if (bHasEnded)
+	{
+		return;
+	}
+
 	bWasInterrupted = true;
 	EndSpecialMove();
 }
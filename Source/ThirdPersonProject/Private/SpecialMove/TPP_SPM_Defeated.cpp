@@ -3,6 +3,7 @@
 
 #include "SpecialMove/TPP_SPM_Defeated.h"
 #include "ThirdPersonProject/TPPPlayerCharacter.h"
+#include "Game/TPPAssetStreamingSubsystem.h"
 
 UTPP_SPM_Defeated::UTPP_SPM_Defeated(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -20,21 +21,33 @@ void UTPP_SPM_Defeated::BeginSpecialMove_Implementation()
 {
 	Super::BeginSpecialMove_Implementation();
 
-	if (DeathAnim)
+	UAnimMontage* DeathMontage = UTPPAssetStreamingSubsystem::GetLoadedAsset(DeathAnim);
+	if (DeathMontage)
 	{
 		OwningCharacter->SetAnimationBlendSlot(EAnimationBlendSlot::FullBody);
-		OwningCharacter->PlayAnimMontage(DeathAnim, true);
+		OwningCharacter->PlayAnimMontage(DeathMontage, true);
 	}
 }
 
+void UTPP_SPM_Defeated::GetStreamedAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	OutAssets.Add(DeathAnim.ToSoftObjectPath());
+}
+
 void UTPP_SPM_Defeated::EndSpecialMove_Implementation()
 {
+	if (bHasEnded)
+	{
+		return;
+	}
+
+	bHasEnded = true;
 	OwningCharacter->OnDeath();
 }
 
 void UTPP_SPM_Defeated::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted = false)
 {
-	if (Montage == DeathAnim)
+	if (Montage == DeathAnim.Get())
 	{
 		EndSpecialMove();
 	}
@@ -42,7 +55,7 @@ void UTPP_SPM_Defeated::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted
 
 void UTPP_SPM_Defeated::OnMontageBlendOut(UAnimMontage* Montage, bool bInterrupted)
 {
-	if (Montage == DeathAnim && !bInterrupted)
+	if (Montage == DeathAnim.Get() && !bInterrupted)
 	{
 		OwningCharacter->OnDeath();
 	}
@@ -6,6 +6,7 @@
 #include "TPPPlayerController.h"
 #include "DrawDebugHelpers.h"
 #include "ThirdPersonProject/TPPPlayerCharacter.h"
+#include "Game/TPPAssetStreamingSubsystem.h"
 
 UTPP_SPM_DodgeRoll::UTPP_SPM_DodgeRoll(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -19,12 +20,23 @@ UTPP_SPM_DodgeRoll::UTPP_SPM_DodgeRoll(const FObjectInitializer& ObjectInitializ
 
 	RollSpeed = 300.f;
 	RollRampDownSpeed = 150.f;
+	RollDuration = 1.0f;
 }
 
 void UTPP_SPM_DodgeRoll::BeginSpecialMove_Implementation()
 {
 	Super::BeginSpecialMove_Implementation();
 
+	UAnimMontage* RollMontage = UTPPAssetStreamingSubsystem::GetLoadedAsset(AnimMontage);
+
+	// Simulated rolls only face the roll direction and play the montage. Movement arrives through regular movement replication.
+	if (bIsSimulatedMove)
+	{
+		OwningCharacter->SetActorRotation(CachedRollDirection.Rotation());
+		OwningCharacter->PlayLocalSpecialMoveMontage(RollMontage, false, GetSimulatedElapsedTime());
+		return;
+	}
+
 	CharacterMovementComponent = OwningCharacter->GetTPPMovementComponent();
 	CharacterMovementComponent->SetMovementMode(EMovementMode::MOVE_Walking);
 	CharacterMovementComponent->ServerSetOrientRotationToMovement(false);
@@ -32,7 +44,7 @@ void UTPP_SPM_DodgeRoll::BeginSpecialMove_Implementation()
 
 	OwningCharacter->UnCrouch(false);
 
-	ATPPPlayerController* PlayerController = Cast<ATPPPlayerController>(OwningCharacter->GetController());
+	ATPPPlayerController* PlayerController = OwningCharacter->GetTPPPlayerController();
 	if (PlayerController)
 	{
 		const FRotator RollRotation = PlayerController->GetControllerRelativeMovementRotation();
@@ -40,29 +52,50 @@ void UTPP_SPM_DodgeRoll::BeginSpecialMove_Implementation()
 		OwningCharacter->ServerSetCharacterRotation(RollRotation);
 	}
 
-	if (AnimMontage)
+	// Roll movement is a single root motion source, started by the movement component on this move on both the client and the server.
+	CharacterMovementComponent->StartRootMotionMove(GetClass(), CachedRollDirection, PredictionKey);
+
+	if (RollMontage)
 	{
 		OwningCharacter->ServerSetAnimRootMotionMode(ERootMotionMode::IgnoreRootMotion);
 		OwningCharacter->SetAnimationBlendSlot(EAnimationBlendSlot::FullBody);
-		OwningCharacter->ServerPlaySpecialMoveMontage(AnimMontage);
-	}
-}
 
-void UTPP_SPM_DodgeRoll::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-	const FVector CurrentVelocity = OwningCharacter->GetTPPMovementComponent()->Velocity;
-	FVector NewVelocity = CachedRollDirection * RollSpeed;
-	NewVelocity.Z = CurrentVelocity.Z;
-	CharacterMovementComponent->ServerOverrideCharacterVelocity(NewVelocity);
+		// Replicated rolls are played by each machine from the replicated move. Otherwise, fall back to multicasting the montage.
+		if (OwningCharacter->IsReplicatedSpecialMoveClass(GetClass()))
+		{
+			OwningCharacter->PlayLocalSpecialMoveMontage(RollMontage);
+		}
+		else
+		{
+			OwningCharacter->ServerPlaySpecialMoveMontage(RollMontage);
+		}
+	}
 }
 
 void UTPP_SPM_DodgeRoll::EndSpecialMove_Implementation()
 {
+	if (bHasEnded)
+	{
+		return;
+	}
+
+	if (bIsSimulatedMove)
+	{
+		Super::EndSpecialMove_Implementation();
+		return;
+	}
+
 	if (OwningCharacter)
 	{
 		OwningCharacter->SetAnimationBlendSlot(EAnimationBlendSlot::None);
 		OwningCharacter->ServerSetAnimRootMotionMode(ERootMotionMode::RootMotionFromMontagesOnly);
+
+		// Interrupted rolls, such as rolled back predictions, never reach the montage end, so stop the roll here.
+		if (bWasInterrupted)
+		{
+			CharacterMovementComponent->StopRootMotionMove();
+			OwningCharacter->StopAnimMontage(AnimMontage.Get());
+		}
 	}
 
 	CharacterMovementComponent->ServerSetOrientRotationToMovement(true);
@@ -71,30 +104,57 @@ void UTPP_SPM_DodgeRoll::EndSpecialMove_Implementation()
 	Super::EndSpecialMove_Implementation();
 }
 
+void UTPP_SPM_DodgeRoll::ResetSpecialMove()
+{
+	Super::ResetSpecialMove();
+
+	CachedRollDirection = FVector::ZeroVector;
+	CharacterMovementComponent = nullptr;
+}
+
+void UTPP_SPM_DodgeRoll::InitFromReplicatedSpecialMove(const FTPPReplicatedSpecialMove& ReplicatedMove)
+{
+	Super::InitFromReplicatedSpecialMove(ReplicatedMove);
+
+	CachedRollDirection = ReplicatedMove.Direction;
+}
+
+void UTPP_SPM_DodgeRoll::GetReplicatedSpecialMoveParams(FTPPReplicatedSpecialMove& OutReplicatedMove) const
+{
+	OutReplicatedMove.Direction = CachedRollDirection;
+}
+
+bool UTPP_SPM_DodgeRoll::GetRootMotionSource(const FVector& Direction, FRootMotionSource_ConstantForce& OutSource) const
+{
+	OutSource.InstanceName = RootMotionSourceName;
+	OutSource.AccumulateMode = ERootMotionAccumulateMode::Override;
+	OutSource.Priority = RootMotionSourcePriority;
+	OutSource.Force = Direction.GetSafeNormal2D() * RollSpeed;
+	OutSource.Duration = RollDuration;
+	OutSource.FinishVelocityParams.Mode = ERootMotionFinishVelocityMode::SetVelocity;
+	OutSource.FinishVelocityParams.SetVelocity = Direction.GetSafeNormal2D() * RollRampDownSpeed;
+	return true;
+}
+
+#if WITH_EDITOR
+void UTPP_SPM_DodgeRoll::PreSave(const ITargetPlatform* TargetPlatform)
+{
+	Super::PreSave(TargetPlatform);
+
+	// The source has to last as long as the montage plays.
+	const UAnimMontage* RollMontage = AnimMontage.LoadSynchronous();
+	if (RollMontage)
+	{
+		RollDuration = RollMontage->GetPlayLength() / FMath::Max(RollMontage->RateScale, KINDA_SMALL_NUMBER);
+	}
+}
+#endif
+
 void UTPP_SPM_DodgeRoll::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 {
-	if (AnimMontage == Montage)
+	// The root motion source lasts as long as the montage and sets the exit velocity itself when it runs out.
+	if (AnimMontage.Get() == Montage)
 	{
-		CharacterMovementComponent->ServerEndRootMotionSource(RootMotionSourceName);
-		ATPPPlayerController* PlayerController = OwningCharacter->GetTPPPlayerController();
-		if (PlayerController && CharacterMovementComponent->IsMovingOnGround())
-		{
-			const FVector CurrentDesiredMovementDirection = PlayerController->GetDesiredMovementDirection();
-
-			FVector EndVelocity = FVector::ZeroVector;
-			// If no input detected, decelerate the roll in its current direction.
-			if (CurrentDesiredMovementDirection.IsNearlyZero())
-			{
-				EndVelocity = CachedRollDirection * RollRampDownSpeed;
-			}
-			// If the player desires to move in a direction coming out of the roll, accelerate in that direction.
-			else
-			{
-				const FVector RelativeControllerDesiredDirection = PlayerController->GetControllerRelativeMovementRotation().Vector();
-				EndVelocity = RelativeControllerDesiredDirection * RollSpeed * (RelativeControllerDesiredDirection | CachedRollDirection);
-			}
-			CharacterMovementComponent->ServerOverrideCharacterVelocity(EndVelocity);
-		}
 		EndSpecialMove();
 	}
 
@@ -5,6 +5,7 @@
 #include "TPPMovementComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "ThirdPersonProject/TPPPlayerCharacter.h"
+#include "Game/TPPAssetStreamingSubsystem.h"
 
 UTPP_SPM_LedgeClimb::UTPP_SPM_LedgeClimb(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -21,22 +22,69 @@ void UTPP_SPM_LedgeClimb::BeginSpecialMove_Implementation()
 {
 	Super::BeginSpecialMove_Implementation();
 
-	if (ClimbMontage)
+	UAnimMontage* LoadedClimbMontage = UTPPAssetStreamingSubsystem::GetLoadedAsset(ClimbMontage);
+
+	// Climb location is updated by the character on every machine, so simulated climbs only need the montage.
+	if (bIsSimulatedMove)
+	{
+		OwningCharacter->PlayLocalSpecialMoveMontage(LoadedClimbMontage, true, GetSimulatedElapsedTime());
+	}
+	else if (LoadedClimbMontage)
 	{
 		OwningCharacter->ServerSetAnimRootMotionMode(ERootMotionMode::IgnoreRootMotion);
-		OwningCharacter->ServerPlaySpecialMoveMontage(ClimbMontage, true);
+		OwningCharacter->PlayLocalSpecialMoveMontage(LoadedClimbMontage, true);
 	}
 }
 
+float UTPP_SPM_LedgeClimb::GetClimbMontageLength() const
+{
+	const UAnimMontage* LoadedClimbMontage = UTPPAssetStreamingSubsystem::GetLoadedAsset(ClimbMontage);
+	return LoadedClimbMontage ? LoadedClimbMontage->GetPlayLength() / FMath::Max(LoadedClimbMontage->RateScale, KINDA_SMALL_NUMBER) : 0.0f;
+}
+
+void UTPP_SPM_LedgeClimb::GetStreamedAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	OutAssets.Add(ClimbMontage.ToSoftObjectPath());
+}
+
 void UTPP_SPM_LedgeClimb::EndSpecialMove_Implementation()
 {
-	OwningCharacter->ServerSetAnimRootMotionMode(ERootMotionMode::RootMotionFromMontagesOnly);
-	OwningCharacter->SetAnimationBlendSlot(EAnimationBlendSlot::None);
+	if (bHasEnded)
+	{
+		return;
+	}
+
+	if (!bIsSimulatedMove)
+	{
+		OwningCharacter->ServerSetAnimRootMotionMode(ERootMotionMode::RootMotionFromMontagesOnly);
+		OwningCharacter->SetAnimationBlendSlot(EAnimationBlendSlot::None);
+	}
 
 	Super::EndSpecialMove_Implementation();
 }
 
+void UTPP_SPM_LedgeClimb::ResetSpecialMove()
+{
+	Super::ResetSpecialMove();
+
+	TargetWallImpactResult = FHitResult();
+	TargetAttachPoint = FVector::ZeroVector;
+	StartingClimbPosition = FVector::ZeroVector;
+	ClimbExitPoint = FVector::ZeroVector;
+	ElapsedTime = 0.0f;
+	LateralLerpElapsedTime = 0.0f;
+	AnimLength = 0.0f;
+	LateralAnimLength = 0.0f;
+}
+
 void UTPP_SPM_LedgeClimb::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted)
 {
-	OwningCharacter->SetWallMovementState(EWallMovementState::None);
+	if (!bIsSimulatedMove)
+	{
+		OwningCharacter->SetWallMovementState(EWallMovementState::None);
+	}
+	else if (Montage == ClimbMontage.Get())
+	{
+		EndSpecialMove();
+	}
 }
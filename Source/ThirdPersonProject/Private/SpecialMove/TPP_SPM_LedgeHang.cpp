@@ -21,7 +21,10 @@ void UTPP_SPM_LedgeHang::BeginSpecialMove_Implementation()
 {
 	Super::BeginSpecialMove_Implementation();
 
-	OwningCharacter->SetAnimationBlendSlot(EAnimationBlendSlot::FullBody);
+	if (!bIsSimulatedMove)
+	{
+		OwningCharacter->SetAnimationBlendSlot(EAnimationBlendSlot::FullBody);
+	}
 	DelayTimer = LedgeHangActionDelay;
 }
 
@@ -33,7 +36,8 @@ void UTPP_SPM_LedgeHang::Tick(float DeltaTime)
 		DelayTimer -= DeltaTime;
 	}
 
-	if (DelayTimer <= 0.0f)
+	// Only ask the server to act on the ledge once the input calls for it.
+	if (DelayTimer <= 0.0f && !bIsSimulatedMove && OwningCharacter->WantsToLeaveLedgeHang())
 	{
 		OwningCharacter->DoLedgeHang();
 	}
@@ -41,9 +45,21 @@ void UTPP_SPM_LedgeHang::Tick(float DeltaTime)
 
 void UTPP_SPM_LedgeHang::EndSpecialMove_Implementation()
 {
-	if (!bWasInterrupted)
+	if (bHasEnded)
+	{
+		return;
+	}
+
+	if (!bWasInterrupted && !bIsSimulatedMove)
 	{
 		OwningCharacter->SetAnimationBlendSlot(EAnimationBlendSlot::None);
 	}
 	Super::EndSpecialMove_Implementation();
 }
+
+void UTPP_SPM_LedgeHang::ResetSpecialMove()
+{
+	Super::ResetSpecialMove();
+
+	DelayTimer = 0.0f;
+}
@@ -35,7 +35,7 @@ void UTPP_SPM_WallRun::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (OwningCharacter)
+	if (OwningCharacter && !bIsSimulatedMove)
 	{
 		ATPPPlayerController* PC = OwningCharacter ? OwningCharacter->GetTPPPlayerController() : nullptr;
 		const FVector CurrentDesiredMovementDirection = PC ? PC->GetDesiredMovementDirection() : FVector::ZeroVector;
@@ -59,15 +59,34 @@ void UTPP_SPM_WallRun::Tick(float DeltaTime)
 
 void UTPP_SPM_WallRun::OnDurationExceeded_Implementation()
 {
+	if (bIsSimulatedMove)
+	{
+		EndSpecialMove();
+		return;
+	}
+
 	OwningCharacter->SetWallMovementState(EWallMovementState::None);
 }
 
 void UTPP_SPM_WallRun::EndSpecialMove_Implementation()
-{	
-	if (!bWasInterrupted && OwningCharacter)
+{
+	if (bHasEnded)
+	{
+		return;
+	}
+
+	if (!bWasInterrupted && !bIsSimulatedMove && OwningCharacter)
 	{
 		OwningCharacter->SetAnimationBlendSlot(EAnimationBlendSlot::None);
 	}
 
 	Super::EndSpecialMove_Implementation();
 }
+
+void UTPP_SPM_WallRun::ResetSpecialMove()
+{
+	Super::ResetSpecialMove();
+
+	CachedDirectionInput = FVector::ZeroVector;
+	TimeSinceInputChanged = 0.0f;
+}
@@ -4,6 +4,11 @@
 #include "TPPAbilityBase.h"
 #include "ThirdPersonProject/TPPPlayerCharacter.h"
 #include "Net/UnrealNetwork.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Ability Confirm Latency (ms)"), STAT_TPPAbilityConfirmLatency, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ability Activations Predicted"), STAT_TPPAbilityActivationsPredicted, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Ability Activations Rejected"), STAT_TPPAbilityActivationsRejected, STATGROUP_ThirdPersonProject);
 
 UTPPAbilityBase::UTPPAbilityBase()
 {
@@ -17,15 +22,90 @@ UTPPAbilityBase::~UTPPAbilityBase()
 bool UTPPAbilityBase::ActivateAbility()
 {
 	OnAbilityActivated();
-	LastAbilityUseTime = GetWorld()->GetTimeSeconds();
+	LastAbilityUseTime = OwningCharacter->GetServerWorldTimeSeconds();
 	return true;
 }
 
+bool UTPPAbilityBase::PredictActivation()
+{
+	if (!OwningCharacter)
+	{
+		return false;
+	}
+
+	// Nothing to predict on the server.
+	if (OwningCharacter->HasAuthority())
+	{
+		return ActivateAbility();
+	}
+
+	// Wrap around without ever handing out 0, which means no prediction.
+	LastPredictionKey = LastPredictionKey == MAX_uint16 ? 1 : LastPredictionKey + 1;
+
+	FTPPPendingAbilityActivation& PendingActivation = PendingActivations.AddDefaulted_GetRef();
+	PendingActivation.PredictionKey = LastPredictionKey;
+	PendingActivation.ActivationTime = FPlatformTime::Seconds();
+	PendingActivation.PreviousAbilityUseTime = LastAbilityUseTime;
+	INC_DWORD_STAT(STAT_TPPAbilityActivationsPredicted);
+
+	// Send the request before activating so it reaches the server ahead of any RPCs sent by the activation.
+	OwningCharacter->ServerActivateAbility(LastPredictionKey);
+
+	OwningCharacter->SetScopedPredictionKey(LastPredictionKey);
+	const bool bActivated = ActivateAbility();
+	OwningCharacter->SetScopedPredictionKey(0);
+
+	return bActivated;
+}
+
+bool UTPPAbilityBase::ConfirmActivation(uint16 PredictionKey)
+{
+	// The server only sees simulated copies of the owner's special moves, which can lag behind the owner, so only check state it owns.
+	if (!OwningCharacter || !OwningCharacter->IsCharacterAlive() || !IsCooldownComplete(ConfirmCooldownTolerance))
+	{
+		return false;
+	}
+
+	LastAbilityUseTime = OwningCharacter->GetServerWorldTimeSeconds();
+	return true;
+}
+
+void UTPPAbilityBase::OnActivationResult(uint16 PredictionKey, bool bAccepted)
+{
+	const int32 PendingIndex = PendingActivations.IndexOfByPredicate([PredictionKey](const FTPPPendingAbilityActivation& Activation) { return Activation.PredictionKey == PredictionKey; });
+	if (PendingIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FTPPPendingAbilityActivation PendingActivation = PendingActivations[PendingIndex];
+	PendingActivations.RemoveAt(PendingIndex);
+	SET_FLOAT_STAT(STAT_TPPAbilityConfirmLatency, (FPlatformTime::Seconds() - PendingActivation.ActivationTime) * 1000.0);
+
+	if (!bAccepted)
+	{
+		INC_DWORD_STAT(STAT_TPPAbilityActivationsRejected);
+		UE_LOG(LogTemp, Log, TEXT("%s activation %d rejected by server"), *GetName(), PredictionKey);
+
+		LastAbilityUseTime = PendingActivation.PreviousAbilityUseTime;
+		if (OwningCharacter)
+		{
+			OwningCharacter->RollbackPredictedSpecialMove(PredictionKey);
+		}
+
+		OnAbilityActivationRejected();
+	}
+}
+
+bool UTPPAbilityBase::IsCooldownComplete(const float Tolerance) const
+{
+	return OwningCharacter && OwningCharacter->GetServerWorldTimeSeconds() + Tolerance >= LastAbilityUseTime + AbilityCooldownTime;
+}
+
 bool UTPPAbilityBase::CanActivate_Implementation() const
 {
-	const float CurrentTime = GetWorld()->GetTimeSeconds();
 	return OwningCharacter && OwningCharacter->GetCurrentSpecialMove() == nullptr
-		&& OwningCharacter->IsCharacterAlive() && CurrentTime >= LastAbilityUseTime + AbilityCooldownTime;
+		&& OwningCharacter->IsCharacterAlive() && IsCooldownComplete();
 }
 
 void UTPPAbilityBase::SetOwningCharacter(ATPPPlayerCharacter* Character)
@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TPPAnimInstance.h"
+#include "TPPMovementComponent.h"
+#include "Weapon/TPPWeaponFirearm.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Anim Pre Update (Game Thread)"), STAT_TPPAnimPreUpdate, STATGROUP_ThirdPersonProject);
+DECLARE_CYCLE_STAT(TEXT("Anim Update (Worker Thread)"), STAT_TPPAnimUpdate, STATGROUP_ThirdPersonProject);
+
+void FTPPAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPPAnimPreUpdate);
+
+	Super::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	const UTPPAnimInstance* AnimInstance = CastChecked<UTPPAnimInstance>(InAnimInstance);
+	Snapshot.MaxAimAngle = AnimInstance->MaxAimAngle;
+	Snapshot.LeftHandIKInterpSpeed = AnimInstance->LeftHandIKInterpSpeed;
+	Snapshot.BlendSlotInterpSpeed = AnimInstance->BlendSlotInterpSpeed;
+
+	const ATPPPlayerCharacter* Character = AnimInstance->OwningCharacter;
+	if (!Character)
+	{
+		return;
+	}
+
+	const UTPPMovementComponent* MovementComponent = Character->GetTPPMovementComponent();
+	Snapshot.Velocity = Character->GetVelocity();
+	Snapshot.ControllerRelativeMovementSpeed = Character->GetControllerRelativeMovementSpeed();
+	Snapshot.AimRotationDelta = Character->GetAimRotationDelta();
+	Snapshot.BlendSlot = Character->GetCurrentAnimationBlendSlot();
+	Snapshot.WallMovementState = Character->GetWallMovementState();
+	Snapshot.bIsMovingOnGround = MovementComponent ? MovementComponent->IsMovingOnGround() : true;
+	Snapshot.bIsCrouching = MovementComponent ? MovementComponent->IsCrouching() : false;
+	Snapshot.bIsSliding = MovementComponent ? MovementComponent->IsSliding() : false;
+	Snapshot.bIsSprinting = Character->IsSprinting();
+	Snapshot.bIsAiming = Character->IsPlayerAiming();
+	Snapshot.bIsAlive = Character->IsCharacterAlive();
+
+	const ATPPWeaponFirearm* Firearm = Character->GetCurrentEquippedFirearm();
+	Snapshot.bWeaponWantsIK = Firearm && Firearm->bShouldUseLeftHandIK && Firearm->IsWeaponReady() && Character->GetSignificanceTierSettings().bUseWeaponIK;
+	Snapshot.WeaponReloadMontage = Firearm ? Firearm->WeaponReloadCharacterMontage.Get() : nullptr;
+}
+
+void FTPPAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPPAnimUpdate);
+
+	Super::Update(DeltaSeconds);
+
+	Speed = Snapshot.Velocity.Size2D();
+
+	const FVector& RelativeSpeed = Snapshot.ControllerRelativeMovementSpeed;
+	MovementDirection = RelativeSpeed.IsNearlyZero() ? 0.0f : FMath::RadiansToDegrees(FMath::Atan2(RelativeSpeed.Y, RelativeSpeed.X));
+
+	const FRotator AimDelta = Snapshot.AimRotationDelta.GetNormalized();
+	AimPitch = FMath::Clamp(AimDelta.Pitch, -Snapshot.MaxAimAngle, Snapshot.MaxAimAngle);
+	AimYaw = FMath::Clamp(AimDelta.Yaw, -Snapshot.MaxAimAngle, Snapshot.MaxAimAngle);
+
+	const bool bUseLeftHandIK = Snapshot.bWeaponWantsIK && Snapshot.BlendSlot != EAnimationBlendSlot::FullBody && !IsMontageActive(Snapshot.WeaponReloadMontage);
+	LeftHandIKAlpha = FMath::FInterpTo(LeftHandIKAlpha, bUseLeftHandIK ? 1.0f : 0.0f, DeltaSeconds, Snapshot.LeftHandIKInterpSpeed);
+
+	const float TargetUpperBodyWeight = Snapshot.BlendSlot > EAnimationBlendSlot::FullBody ? 1.0f : 0.0f;
+	const float TargetFullBodyWeight = Snapshot.BlendSlot == EAnimationBlendSlot::FullBody ? 1.0f : 0.0f;
+	UpperBodyBlendWeight = FMath::FInterpTo(UpperBodyBlendWeight, TargetUpperBodyWeight, DeltaSeconds, Snapshot.BlendSlotInterpSpeed);
+	FullBodyBlendWeight = FMath::FInterpTo(FullBodyBlendWeight, TargetFullBodyWeight, DeltaSeconds, Snapshot.BlendSlotInterpSpeed);
+}
+
+void FTPPAnimInstanceProxy::PostUpdate(UAnimInstance* InAnimInstance) const
+{
+	Super::PostUpdate(InAnimInstance);
+
+	UTPPAnimInstance* AnimInstance = CastChecked<UTPPAnimInstance>(InAnimInstance);
+	AnimInstance->Speed = Speed;
+	AnimInstance->MovementDirection = MovementDirection;
+	AnimInstance->AimPitch = AimPitch;
+	AnimInstance->AimYaw = AimYaw;
+	AnimInstance->LeftHandIKAlpha = LeftHandIKAlpha;
+	AnimInstance->UpperBodyBlendWeight = UpperBodyBlendWeight;
+	AnimInstance->FullBodyBlendWeight = FullBodyBlendWeight;
+	AnimInstance->WallMovementState = Snapshot.WallMovementState;
+	AnimInstance->bIsMovingOnGround = Snapshot.bIsMovingOnGround;
+	AnimInstance->bIsCrouching = Snapshot.bIsCrouching;
+	AnimInstance->bIsSliding = Snapshot.bIsSliding;
+	AnimInstance->bIsSprinting = Snapshot.bIsSprinting;
+	AnimInstance->bIsAiming = Snapshot.bIsAiming;
+	AnimInstance->bIsAlive = Snapshot.bIsAlive;
+}
+
+bool FTPPAnimInstanceProxy::IsMontageActive(const UAnimMontage* Montage) const
+{
+	if (!Montage)
+	{
+		return false;
+	}
+
+	for (const FMontageEvaluationState& EvaluationState : GetMontageEvaluationData())
+	{
+		if (EvaluationState.Montage == Montage && EvaluationState.bIsActive)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UTPPAnimInstance::NativeInitializeAnimation()
+{
+	Super::NativeInitializeAnimation();
+
+	OwningCharacter = Cast<ATPPPlayerCharacter>(TryGetPawnOwner());
+}
@@ -5,11 +5,27 @@
 #include "ThirdPersonProject/TPPPlayerCharacter.h"
 #include "Weapon/TPPWeaponBase.h"
 #include "Kismet/GameplayStatics.h"
+#include "Debug/TPPStartupProfiler.h"
 
 void ATPPHUD::BeginPlay()
 {
+	FTPPScopedStartupTimer StartupTimer(this);
 	Super::BeginPlay();
 
+	if (FTPPStartupProfiler::ShouldDeferStartupInit())
+	{
+		GetWorldTimerManager().SetTimerForNextTick(this, &ATPPHUD::CreateWidgets);
+	}
+	else
+	{
+		CreateWidgets();
+	}
+}
+
+void ATPPHUD::CreateWidgets()
+{
+	FTPPScopedStartupTimer StartupTimer(TEXT("HUD Create Widgets"));
+
 	if (CrosshairWidgetClass)
 	{
 		CrosshairWidget = CreateWidget<UTPPCrosshairWidget>(GetWorld(), CrosshairWidgetClass);
@@ -27,10 +43,17 @@ void ATPPHUD::BeginPlay()
 			WeaponInfoWidget->AddToViewport();
 		}
 	}
+
+	// The character may have equipped a weapon before the widgets existed.
+	if (ObservedCharacter && ObservedCharacter->GetCurrentEquippedWeapon())
+	{
+		OnPlayerEquippedWeapon(ObservedCharacter->GetCurrentEquippedWeapon());
+	}
 }
 
 void ATPPHUD::InitializeHUD(ATPPPlayerCharacter* PlayerCharacter)
 {
+	ObservedCharacter = PlayerCharacter;
 	if (PlayerCharacter)
 	{
 		PlayerCharacter->OnWeaponEquipped.AddDynamic(this, &ATPPHUD::OnPlayerEquippedWeapon);
@@ -4,6 +4,10 @@
 #include "TPPMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "ThirdPersonProject/TPPPlayerCharacter.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+#include "SpecialMove/TPPSpecialMove.h"
+
+DECLARE_CYCLE_STAT(TEXT("Movement Tick"), STAT_TPPMovementTick, STATGROUP_ThirdPersonProject);
 
 UTPPMovementComponent::UTPPMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -11,6 +15,10 @@ UTPPMovementComponent::UTPPMovementComponent(const FObjectInitializer& ObjectIni
 	MinimumSlidingSpeed = MaxWalkSpeed + 150.0f;
 	EndSlideSpeed = 200.f;
 	SlidingFriction = .8f;
+	SlidingFrictionDeceleration = 150.0f;
+	MaxSlideSpeed = 1400.0f;
+	SlideFixedTimeStep = 1.0f / 120.0f;
+	SlideSteeringScale = 0.5f;
 	bUseSeparateBrakingFriction = true;
 
 	DefaultWalkSpeed = 400.f;
@@ -20,6 +28,9 @@ UTPPMovementComponent::UTPPMovementComponent(const FObjectInitializer& ObjectIni
 	CrouchingADSSpeed = 200.f;
 
 	AirFriction = .5f;
+
+	SetNetworkMoveDataContainer(TPPNetworkMoveDataContainer);
+	SetMoveResponseDataContainer(TPPMoveResponseDataContainer);
 }
 
 void UTPPMovementComponent::BeginPlay()
@@ -38,8 +49,27 @@ void UTPPMovementComponent::BeginPlay()
 	bHasCharacterStartedSlide = false;
 }
 
+void UTPPMovementComponent::SetUpdatedComponent(USceneComponent* NewUpdatedComponent)
+{
+	Super::SetUpdatedComponent(NewUpdatedComponent);
+	TPPCharacterOwner = Cast<ATPPPlayerCharacter>(CharacterOwner);
+}
+
+FNetworkPredictionData_Client* UTPPMovementComponent::GetPredictionData_Client() const
+{
+	if (ClientPredictionData == nullptr)
+	{
+		UTPPMovementComponent* MutableThis = const_cast<UTPPMovementComponent*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_TPPCharacter(*this);
+	}
+
+	return ClientPredictionData;
+}
+
 void UTPPMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	SCOPE_CYCLE_COUNTER(STAT_TPPMovementTick);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 	if (MovementMode == EMovementMode::MOVE_Falling)
 	{
@@ -62,6 +92,8 @@ void UTPPMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovement
 	case EMovementMode::MOVE_Custom:
 		if (CustomMovementMode == (uint8)ECustomMovementMode::Sliding)
 		{
+			SlideTimeRemainder = 0.0f;
+			SlideExtrapolation = FVector::ZeroVector;
 			return;
 		}
 	case EMovementMode::MOVE_Falling:
@@ -103,9 +135,121 @@ void UTPPMovementComponent::PhysSlide(float DeltaTime, int32 Iterations)
 		return;
 	}
 
-	const float MaxSpeed = GetMaxSpeed();
+	if (!CurrentFloor.IsWalkableFloor())
+	{
+		FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, false);
+		if (!CurrentFloor.IsWalkableFloor())
+		{
+			SetMovementMode(EMovementMode::MOVE_Falling);
+			StartNewPhysics(DeltaTime, Iterations);
+			return;
+		}
+	}
+
+	// Return to where the last fixed step left the capsule so the steps below start from the same place at any frame rate.
+	if (!SlideExtrapolation.IsZero())
+	{
+		MoveUpdatedComponent(-SlideExtrapolation, UpdatedComponent->GetComponentQuat(), false);
+		SlideExtrapolation = FVector::ZeroVector;
+	}
 
-	PhysWalking(DeltaTime, Iterations);
+	const int32 NumSteps = ConsumeSlideSteps(SlideTimeRemainder, DeltaTime, SlideFixedTimeStep);
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		if (!PhysSlideStep(SlideFixedTimeStep))
+		{
+			// Hand the time the slide didn't use to the new movement mode.
+			const float RemainingTime = SlideTimeRemainder + ((NumSteps - Step - 1) * SlideFixedTimeStep);
+			SlideTimeRemainder = 0.0f;
+			StartNewPhysics(FMath::Max(RemainingTime, 0.0f), Iterations + 1);
+			return;
+		}
+	}
+
+	// Move the capsule on by the time left over without changing velocity, so frames shorter than a step still move smoothly.
+	if (SlideTimeRemainder > 0.0f)
+	{
+		const FVector StartLocation = UpdatedComponent->GetComponentLocation();
+		FHitResult Hit(1.0f);
+		SafeMoveUpdatedComponent(Velocity * SlideTimeRemainder, UpdatedComponent->GetComponentQuat(), true, Hit);
+		SlideExtrapolation = UpdatedComponent->GetComponentLocation() - StartLocation;
+	}
+}
+
+int32 UTPPMovementComponent::ConsumeSlideSteps(float& InOutTimeRemainder, const float DeltaTime, const float FixedTimeStep)
+{
+	InOutTimeRemainder += DeltaTime;
+
+	// A frame that lands on a step boundary can leave the sum a rounding error short of it, so allow a tiny tolerance.
+	// The remainder is carried as is, so a step taken early is paid back on the next one.
+	const float Tolerance = FixedTimeStep * 1.e-4f;
+	const int32 NumSteps = FMath::Max(FMath::FloorToInt((InOutTimeRemainder + Tolerance) / FixedTimeStep), 0);
+	InOutTimeRemainder -= NumSteps * FixedTimeStep;
+	return NumSteps;
+}
+
+bool UTPPMovementComponent::PhysSlideStep(float TimeStep)
+{
+	Velocity = ComputeSlideVelocity(Velocity, CurrentFloor.HitResult.ImpactNormal, GetGravityZ(), SlidingFriction, SlidingFrictionDeceleration, MaxSlideSpeed,
+		Acceleration * SlideSteeringScale, TimeStep);
+
+	if (Velocity.SizeSquared2D() < CachedEndSlideSpeed)
+	{
+		bWantsToSlide = false;
+		SetMovementMode(EMovementMode::MOVE_Walking);
+		return false;
+	}
+
+	const FVector MoveDelta = Velocity * TimeStep;
+	FHitResult Hit(1.0f);
+	SafeMoveUpdatedComponent(MoveDelta, UpdatedComponent->GetComponentQuat(), true, Hit);
+	if (Hit.Time < 1.0f)
+	{
+		HandleImpact(Hit, TimeStep, MoveDelta);
+		SlideAlongSurface(MoveDelta, 1.0f - Hit.Time, Hit.Normal, Hit, true);
+	}
+
+	FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, false);
+	if (!CurrentFloor.IsWalkableFloor())
+	{
+		SetMovementMode(EMovementMode::MOVE_Falling);
+		return false;
+	}
+
+	AdjustFloorHeight();
+	return true;
+}
+
+FVector UTPPMovementComponent::ComputeSlideVelocity(const FVector& InVelocity, const FVector& FloorNormal, const float GravityZ, const float FrictionCoefficient,
+	const float FrictionDeceleration, const float MaxSpeed, const FVector& SteeringAcceleration, const float TimeStep)
+{
+	const FVector Normal = FloorNormal.IsNearlyZero() ? FVector::UpVector : FloorNormal.GetSafeNormal();
+
+	// Keep velocity along the floor and accelerate by the component of gravity parallel to it.
+	FVector NewVelocity = FVector::VectorPlaneProject(InVelocity, Normal);
+
+	// Steering only uses the part of the input across the slide direction, and keeps the speed the slide already had.
+	const float SteeringSpeed = NewVelocity.Size();
+	if (SteeringSpeed > KINDA_SMALL_NUMBER && !SteeringAcceleration.IsNearlyZero())
+	{
+		const FVector SlideDirection = NewVelocity / SteeringSpeed;
+		FVector Steering = FVector::VectorPlaneProject(SteeringAcceleration, Normal);
+		Steering -= SlideDirection * (Steering | SlideDirection);
+		NewVelocity = (NewVelocity + (Steering * TimeStep)).GetSafeNormal() * SteeringSpeed;
+	}
+
+	const FVector Gravity = FVector(0.0f, 0.0f, GravityZ);
+	NewVelocity += FVector::VectorPlaneProject(Gravity, Normal) * TimeStep;
+
+	const float Speed = NewVelocity.Size();
+	if (Speed > KINDA_SMALL_NUMBER)
+	{
+		const float FrictionSpeedLoss = ((FrictionCoefficient * Speed) + FrictionDeceleration) * TimeStep;
+		const float NewSpeed = FMath::Min(FMath::Max(Speed - FrictionSpeedLoss, 0.0f), MaxSpeed);
+		NewVelocity *= NewSpeed / Speed;
+	}
+
+	return NewVelocity;
 }
 
 void UTPPMovementComponent::OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity)
@@ -138,30 +282,19 @@ void UTPPMovementComponent::SlideStarted()
 		// Set wants to crouch to true since we want to move to crouching when finished.
 		bWantsToCrouch = true;
 
-		BrakingFrictionFactor = 1.0f;
-		BrakingFriction = SlidingFriction;
-		GroundFriction = 1.f;
-		BrakingDecelerationWalking = 0.0;
-
 		MovementState.bCanJump = false;
 
-		ATPPPlayerCharacter* TPPCharacter = Cast<ATPPPlayerCharacter>(CharacterOwner);
-		if (TPPCharacter)
+		bHasCharacterStartedSlide = true;
+
+		if (TPPCharacterOwner)
 		{
-			TPPCharacter->OnStartSlide();
+			TPPCharacterOwner->OnStartSlide();
 		}
-
-		bHasCharacterStartedSlide = true;
 	}
 }
 
 void UTPPMovementComponent::SlideEnded()
 {
-	BrakingDecelerationWalking = CachedBrakingDeceleration;
-	BrakingFriction = 1.f;
-	BrakingFrictionFactor = 2.0f;
-	GroundFriction = CachedGroundFriction;
-
 	MovementState.bCanJump = true;
 
 	if (!bWantsToCrouch)
@@ -169,13 +302,12 @@ void UTPPMovementComponent::SlideEnded()
 		UnCrouch(false);
 	}
 
-	ATPPPlayerCharacter* TPPCharacter = Cast<ATPPPlayerCharacter>(CharacterOwner);
-	if (TPPCharacter)
+	bHasCharacterStartedSlide = false;
+
+	if (TPPCharacterOwner)
 	{
-		TPPCharacter->OnEndSlide();
+		TPPCharacterOwner->OnEndSlide();
 	}
-
-	bHasCharacterStartedSlide = false;
 }
 
 bool UTPPMovementComponent::IsSliding() const
@@ -203,7 +335,7 @@ bool UTPPMovementComponent::IsMovingOnGround() const
 
 float UTPPMovementComponent::GetMaxSpeed() const
 {
-	ATPPPlayerCharacter* TPPCharacter = Cast<ATPPPlayerCharacter>(CharacterOwner);
+	const ATPPPlayerCharacter* TPPCharacter = TPPCharacterOwner;
 	if (!TPPCharacter)
 	{
 		return 0.0f;
@@ -249,32 +381,237 @@ void UTPPMovementComponent::SetUseControllerDesiredRotation_Implementation(const
 	bUseControllerDesiredRotation = bShouldUseDesiredRotation;
 }
 
-float UTPPMovementComponent::GetMaxBrakingDeceleration() const
+void UTPPMovementComponent::StartRootMotionMove(TSubclassOf<UTPPSpecialMove> MoveClass, const FVector& Direction, uint16 PredictionKey)
 {
-	switch (MovementMode)
+	RootMotionMoveClass = MoveClass;
+	RootMotionMoveDirection = Direction.GetSafeNormal2D();
+	RootMotionMoveId = RootMotionMoveId == MAX_uint8 ? 1 : RootMotionMoveId + 1;
+	RootMotionMovePredictionKey = PredictionKey;
+}
+
+void UTPPMovementComponent::StopRootMotionMove()
+{
+	RootMotionMoveClass = nullptr;
+}
+
+void UTPPMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+
+	UpdateRootMotionMove();
+}
+
+void UTPPMovementComponent::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel)
+{
+	const FTPPCharacterNetworkMoveData* MoveData = static_cast<const FTPPCharacterNetworkMoveData*>(GetCurrentNetworkMoveData());
+	if (MoveData)
 	{
-	case EMovementMode::MOVE_Custom:
-		if (CustomMovementMode == (uint8)ECustomMovementMode::Sliding)
+		// Only the class and direction come from the client. Everything that affects physics is read from the class defaults.
+		// A move already running keeps going. A new one has to use up the key of an activation the server confirmed, and be the ability's special move.
+		// Anything else is treated as stopped, which also removes a source that was already applied.
+		const bool bIsRunningMove = RootMotionMoveClass && MoveData->RootMotionMoveClass == RootMotionMoveClass && MoveData->RootMotionMoveId == RootMotionMoveId
+			&& MoveData->RootMotionMovePredictionKey == RootMotionMovePredictionKey;
+		const bool bIsValidMoveClass = MoveData->RootMotionMoveClass && (bIsRunningMove
+			|| (TPPCharacterOwner && TPPCharacterOwner->ConsumeAcceptedPredictionKey(MoveData->RootMotionMoveClass, MoveData->RootMotionMovePredictionKey)));
+		RootMotionMoveClass = bIsValidMoveClass ? MoveData->RootMotionMoveClass : nullptr;
+		if (bIsValidMoveClass)
+		{
+			RootMotionMoveDirection = MoveData->RootMotionMoveDirection;
+			RootMotionMoveId = MoveData->RootMotionMoveId;
+			RootMotionMovePredictionKey = MoveData->RootMotionMovePredictionKey;
+		}
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+}
+
+void UTPPMovementComponent::ClientHandleMoveResponse(const FCharacterMoveResponseDataContainer& MoveResponse)
+{
+	Super::ClientHandleMoveResponse(MoveResponse);
+
+	// Only take the slide state if the correction was accepted, so the moves replayed from it resume the server's sub-step.
+	const FNetworkPredictionData_Client_Character* ClientData = GetPredictionData_Client_Character();
+	if (MoveResponse.IsCorrection() && ClientData && ClientData->bUpdatePosition)
+	{
+		const FTPPCharacterMoveResponseDataContainer& TPPMoveResponse = static_cast<const FTPPCharacterMoveResponseDataContainer&>(MoveResponse);
+		SlideTimeRemainder = TPPMoveResponse.SlideTimeRemainder;
+		SlideExtrapolation = TPPMoveResponse.SlideExtrapolation;
+	}
+}
+
+void UTPPMovementComponent::UpdateRootMotionMove()
+{
+	const uint16 InvalidSourceID = (uint16)ERootMotionSourceID::Invalid;
+	if (AppliedRootMotionSourceID != InvalidSourceID)
+	{
+		if (!GetRootMotionSourceByID(AppliedRootMotionSourceID).IsValid())
+		{
+			// The source ran its full duration. The owner stops sending the move unless a new one has already started.
+			AppliedRootMotionSourceID = InvalidSourceID;
+			if (CharacterOwner && CharacterOwner->IsLocallyControlled() && RootMotionMoveId == AppliedRootMotionMoveId)
+			{
+				RootMotionMoveClass = nullptr;
+			}
+		}
+		else if (!RootMotionMoveClass || RootMotionMoveId != AppliedRootMotionMoveId)
+		{
+			RemoveRootMotionSourceByID(AppliedRootMotionSourceID);
+			AppliedRootMotionSourceID = InvalidSourceID;
+		}
+	}
+
+	if (RootMotionMoveClass && RootMotionMoveId != AppliedRootMotionMoveId)
+	{
+		AppliedRootMotionMoveId = RootMotionMoveId;
+
+		FRootMotionSource_ConstantForce RootMotionSource;
+		if (RootMotionMoveClass->GetDefaultObject<UTPPSpecialMove>()->GetRootMotionSource(RootMotionMoveDirection, RootMotionSource))
+		{
+			AppliedRootMotionSourceID = ApplyRootMotionSource(MakeShared<FRootMotionSource_ConstantForce>(RootMotionSource));
+		}
+	}
+}
+
+void FSavedMove_TPPCharacter::Clear()
+{
+	Super::Clear();
+
+	bSavedWantsToSlide = false;
+	SavedRootMotionMoveClass = nullptr;
+	SavedRootMotionMoveDirection = FVector::ZeroVector;
+	SavedRootMotionMoveId = 0;
+	SavedRootMotionMovePredictionKey = 0;
+	SavedAppliedRootMotionMoveId = 0;
+	SavedAppliedRootMotionSourceID = (uint16)ERootMotionSourceID::Invalid;
+}
+
+void FSavedMove_TPPCharacter::SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
+{
+	Super::SetMoveFor(Character, InDeltaTime, NewAccel, ClientData);
+
+	const UTPPMovementComponent* MovementComponent = Cast<UTPPMovementComponent>(Character->GetCharacterMovement());
+	if (MovementComponent)
+	{
+		bSavedWantsToSlide = MovementComponent->bWantsToSlide;
+		SavedRootMotionMoveClass = MovementComponent->RootMotionMoveClass;
+		SavedRootMotionMoveDirection = MovementComponent->RootMotionMoveDirection;
+		SavedRootMotionMoveId = MovementComponent->RootMotionMoveId;
+		SavedRootMotionMovePredictionKey = MovementComponent->RootMotionMovePredictionKey;
+		SavedAppliedRootMotionMoveId = MovementComponent->AppliedRootMotionMoveId;
+		SavedAppliedRootMotionSourceID = MovementComponent->AppliedRootMotionSourceID;
+	}
+}
+
+void FSavedMove_TPPCharacter::PrepMoveFor(ACharacter* Character)
+{
+	Super::PrepMoveFor(Character);
+
+	UTPPMovementComponent* MovementComponent = Cast<UTPPMovementComponent>(Character->GetCharacterMovement());
+	if (MovementComponent)
+	{
+		MovementComponent->bWantsToSlide = bSavedWantsToSlide;
+		MovementComponent->RootMotionMoveClass = SavedRootMotionMoveClass;
+		MovementComponent->RootMotionMoveDirection = SavedRootMotionMoveDirection;
+		MovementComponent->RootMotionMoveId = SavedRootMotionMoveId;
+		MovementComponent->RootMotionMovePredictionKey = SavedRootMotionMovePredictionKey;
+		MovementComponent->AppliedRootMotionMoveId = SavedAppliedRootMotionMoveId;
+		MovementComponent->AppliedRootMotionSourceID = SavedAppliedRootMotionSourceID;
+	}
+}
+
+bool FSavedMove_TPPCharacter::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+	const FSavedMove_TPPCharacter* NewTPPMove = (FSavedMove_TPPCharacter*)NewMove.Get();
+	if (bSavedWantsToSlide != NewTPPMove->bSavedWantsToSlide)
+	{
+		return false;
+	}
+
+	// Root motion moves have to start and stop on the move they were sent with.
+	if (SavedRootMotionMoveClass != NewTPPMove->SavedRootMotionMoveClass || SavedRootMotionMoveId != NewTPPMove->SavedRootMotionMoveId)
+	{
+		return false;
+	}
+
+	return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_TPPCharacter::AllocateNewMove()
+{
+	return FSavedMovePtr(new FSavedMove_TPPCharacter());
+}
+
+void FTPPCharacterNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType)
+{
+	Super::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const FSavedMove_TPPCharacter& TPPMove = static_cast<const FSavedMove_TPPCharacter&>(ClientMove);
+	RootMotionMoveClass = TPPMove.SavedRootMotionMoveClass;
+	RootMotionMoveDirection = TPPMove.SavedRootMotionMoveDirection;
+	RootMotionMoveId = TPPMove.SavedRootMotionMoveId;
+	RootMotionMovePredictionKey = TPPMove.SavedRootMotionMovePredictionKey;
+}
+
+bool FTPPCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType)
+{
+	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+
+	// Most moves have no root motion move, so they only cost a bit.
+	uint8 bHasRootMotionMove = RootMotionMoveClass != nullptr;
+	Ar.SerializeBits(&bHasRootMotionMove, 1);
+	if (bHasRootMotionMove)
+	{
+		UObject* MoveClass = RootMotionMoveClass.Get();
+		if (PackageMap)
 		{
-			return .8f;
+			PackageMap->SerializeObject(Ar, UClass::StaticClass(), MoveClass);
 		}
+		RootMotionMoveClass = Cast<UClass>(MoveClass);
+
+		bool bDirectionSuccess = true;
+		RootMotionMoveDirection.NetSerialize(Ar, PackageMap, bDirectionSuccess);
+		Ar << RootMotionMoveId;
+		Ar << RootMotionMovePredictionKey;
+	}
+	else if (Ar.IsLoading())
+	{
+		RootMotionMoveClass = nullptr;
 	}
 
-	return Super::GetMaxBrakingDeceleration();
+	return !Ar.IsError();
 }
 
-void UTPPMovementComponent::ServerAddRootMotionSource_Implementation(const FRootMotionSource_ConstantForce& RootMotionSource)
+void FTPPCharacterMoveResponseDataContainer::ServerFillResponseData(const UCharacterMovementComponent& CharacterMovement, const FClientAdjustment& PendingAdjustment)
 {
-	TSharedPtr<FRootMotionSource_ConstantForce> RootMotionSourcePtr = MakeShared<FRootMotionSource_ConstantForce>(RootMotionSource);
-	ApplyRootMotionSource(RootMotionSourcePtr);
+	Super::ServerFillResponseData(CharacterMovement, PendingAdjustment);
+
+	const UTPPMovementComponent& TPPMovementComponent = static_cast<const UTPPMovementComponent&>(CharacterMovement);
+	SlideTimeRemainder = TPPMovementComponent.SlideTimeRemainder;
+	SlideExtrapolation = TPPMovementComponent.SlideExtrapolation;
 }
 
-void UTPPMovementComponent::ServerEndRootMotionSource_Implementation(const FName& SourceName)
+bool FTPPCharacterMoveResponseDataContainer::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap)
 {
-	RemoveRootMotionSource(SourceName);
+	if (!Super::Serialize(CharacterMovement, Ar, PackageMap))
+	{
+		return false;
+	}
+
+	// Acks don't move the client, so only corrections need the slide state.
+	if (IsCorrection())
+	{
+		Ar << SlideTimeRemainder;
+
+		bool bExtrapolationSuccess = true;
+		SlideExtrapolation.NetSerialize(Ar, PackageMap, bExtrapolationSuccess);
+	}
+
+	return !Ar.IsError();
 }
 
-void UTPPMovementComponent::ServerOverrideCharacterVelocity_Implementation(const FVector& NewVelocity)
+FTPPCharacterNetworkMoveDataContainer::FTPPCharacterNetworkMoveDataContainer()
 {
-	Velocity = NewVelocity;
+	NewMoveData = &TPPDefaultMoveData[0];
+	PendingMoveData = &TPPDefaultMoveData[1];
+	OldMoveData = &TPPDefaultMoveData[2];
 }
\ No newline at end of file
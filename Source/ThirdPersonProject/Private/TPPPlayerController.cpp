@@ -4,9 +4,23 @@
 #include "Weapon/TPPWeaponBase.h"
 #include "Weapon/TPPWeaponFirearm.h"
 #include "TPPAimProperties.h"
+#include "TPPInputProperties.h"
 #include "Game/TPPGameInstance.h"
+#include "Game/TPPLockOnSubsystem.h"
+#include "BaseEnemy.h"
+#include "Debug/TPPLatencySubsystem.h"
+#include "Debug/TPPTimedCapture.h"
+#include "Pickups/TPPPickupBase.h"
 #include "ThirdPersonProject/TPPPlayerCharacter.h"
 #include "Net/UnrealNetwork.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetworkObjectList.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "GameFramework/GameModeBase.h"
+#include "Kismet/GameplayStatics.h"
+#include "Debug/TPPStartupProfiler.h"
 
 ATPPPlayerController::ATPPPlayerController(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
@@ -20,9 +34,18 @@ void ATPPPlayerController::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 
 void ATPPPlayerController::BeginPlay()
 {
-	CachedOwnerCharacter = GetOwnerCharacter();
+	FTPPScopedStartupTimer StartupTimer(this);
+	CachedOwnerCharacter = Cast<ATPPPlayerCharacter>(GetPawn());
 	bIsMovementInputEnabled = true;
 	DesiredControlRotation = GetControlRotation();
+	InitInputActionStates();
+
+	UTPPGameInstance* GameInstance = GetGameInstance<UTPPGameInstance>();
+	if (IsLocalController() && GameInstance && GameInstance->GetPendingInputReplay().Len() > 0)
+	{
+		// Wait a frame so the game mode has spawned and possessed the default pawn.
+		GetWorldTimerManager().SetTimerForNextTick(this, &ATPPPlayerController::StartPendingInputReplay);
+	}
 }
 
 void ATPPPlayerController::SetupInputComponent()
@@ -41,6 +64,7 @@ void ATPPPlayerController::SetupInputComponent()
 	InputComponent->BindAxis("LookUpRate", this, &ATPPPlayerController::LookUpRate);
 
 	InputComponent->BindAction("MovementAbility", IE_Pressed, this, &ATPPPlayerController::OnMovementAbilityPressed);
+	InputComponent->BindAction("MovementAbility", IE_Released, this, &ATPPPlayerController::OnMovementAbilityReleased);
 	InputComponent->BindAction("Sprint", IE_Pressed, this, &ATPPPlayerController::OnSprintPressed);
 	InputComponent->BindAction("Sprint", IE_Released, this, &ATPPPlayerController::OnSprintReleased);
 	InputComponent->BindAction("Crouch", IE_Pressed, this, &ATPPPlayerController::OnCrouchPressed);
@@ -50,18 +74,209 @@ void ATPPPlayerController::SetupInputComponent()
 	InputComponent->BindAction("ADS", IE_Pressed, this, &ATPPPlayerController::OnAimWeaponPressed);
 	InputComponent->BindAction("ADS", IE_Released, this, &ATPPPlayerController::OnAimWeaponReleased);
 	InputComponent->BindAction("Reload", IE_Pressed, this, &ATPPPlayerController::OnReloadPressed);
+	InputComponent->BindAction("Reload", IE_Released, this, &ATPPPlayerController::OnReloadReleased);
 
 	InputComponent->BindAction("Pause", IE_Pressed, this, &ATPPPlayerController::OnPausePressed);
 }
 
+void ATPPPlayerController::SetPawn(APawn* InPawn)
+{
+	Super::SetPawn(InPawn);
+	CachedOwnerCharacter = Cast<ATPPPlayerCharacter>(InPawn);
+	InputBuffer.Reset();
+}
+
+void ATPPPlayerController::InitPlayerState()
+{
+	Super::InitPlayerState();
+	CachedTPPPlayerState = Cast<ATPPPlayerState>(PlayerState);
+}
+
+void ATPPPlayerController::OnRep_PlayerState()
+{
+	Super::OnRep_PlayerState();
+	CachedTPPPlayerState = Cast<ATPPPlayerState>(PlayerState);
+}
+
+void ATPPPlayerController::CleanupPlayerState()
+{
+	Super::CleanupPlayerState();
+	CachedTPPPlayerState = nullptr;
+}
+
 void ATPPPlayerController::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
-	UpdateDesiredMovementDirection(DesiredMovementDirection);
+
+	// Only send input direction when it changes instead of every frame.
+	if (!DesiredMovementDirection.Equals(LastSentDesiredMovementDirection))
+	{
+		LastSentDesiredMovementDirection = DesiredMovementDirection;
+		UpdateDesiredMovementDirection(DesiredMovementDirection);
+	}
+
+	TickKeyHoldTimers(DeltaTime);
+
+	if (bWantsToConsumeBufferedInput)
+	{
+		bWantsToConsumeBufferedInput = false;
+		ConsumeBufferedInput();
+	}
 }
 
 void ATPPPlayerController::TickKeyHoldTimers(float DeltaTime)
 {
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	for (int32 i = 0; i < InputActionStates.Num(); ++i)
+	{
+		FTPPInputActionState& ActionState = InputActionStates[i];
+		if (ActionState.bIsPressed && !ActionState.bHoldTriggered && ActionState.HoldTime > 0.0f && CurrentTime - ActionState.PressTime >= ActionState.HoldTime)
+		{
+			ActionState.bHoldTriggered = true;
+			TriggerInputAction((EPlayerInputAction)i);
+		}
+	}
+}
+
+void ATPPPlayerController::InitInputActionStates()
+{
+	for (int32 i = 0; i < InputActionStates.Num(); ++i)
+	{
+		InputActionStates[i] = FTPPInputActionState();
+	}
+
+	// Actions that special moves commonly block buffer by default, so buffering works without an input properties asset.
+	for (const EPlayerInputAction BufferedAction : { EPlayerInputAction::Jump, EPlayerInputAction::Reload, EPlayerInputAction::MovementAbility })
+	{
+		InputActionStates[(int32)BufferedAction].BufferWindow = InputBufferWindow;
+	}
+
+	const UTPPGameInstance* GameInstance = UTPPGameInstance::Get();
+	const UTPPInputProperties* InputProperties = GameInstance ? GameInstance->GetInputProperties() : nullptr;
+	if (!InputProperties)
+	{
+		return;
+	}
+
+	for (const FTPPInputAction& InputAction : InputProperties->DefaultInputActions)
+	{
+		if (InputAction.InputAction >= EPlayerInputAction::MAX)
+		{
+			continue;
+		}
+
+		FTPPInputActionState& ActionState = InputActionStates[(int32)InputAction.InputAction];
+		ActionState.HoldTime = InputAction.bIsKeyHold ? (InputAction.KeyHoldTime > 0.0f ? InputAction.KeyHoldTime : HoldKeyThreshold) : 0.0f;
+		if (InputAction.BufferWindow >= 0.0f)
+		{
+			ActionState.BufferWindow = InputAction.BufferWindow;
+		}
+	}
+}
+
+void ATPPPlayerController::HandleInputActionPressed(EPlayerInputAction InputAction)
+{
+	FTPPInputActionState& ActionState = InputActionStates[(int32)InputAction];
+	ActionState.bIsPressed = true;
+	ActionState.bHoldTriggered = false;
+	ActionState.PressTime = GetWorld()->GetTimeSeconds();
+
+	if (ActionState.HoldTime <= 0.0f)
+	{
+		TriggerInputAction(InputAction);
+	}
+}
+
+void ATPPPlayerController::HandleInputActionReleased(EPlayerInputAction InputAction)
+{
+	InputActionStates[(int32)InputAction].bIsPressed = false;
+}
+
+void ATPPPlayerController::TriggerInputAction(EPlayerInputAction InputAction)
+{
+	if (!CachedOwnerCharacter || ExecuteInputAction(InputAction))
+	{
+		return;
+	}
+
+	// Only presses dropped because of a special move are worth retrying.
+	if (InputActionStates[(int32)InputAction].BufferWindow > 0.0f && CachedOwnerCharacter->GetCurrentSpecialMove())
+	{
+		InputBuffer.Add(InputAction, GetWorld()->GetTimeSeconds());
+	}
+}
+
+bool ATPPPlayerController::ExecuteInputAction(EPlayerInputAction InputAction)
+{
+	// Started before executing because a jump or ability can reach its first stage before returning.
+	const bool bIsMovementAction = InputAction == EPlayerInputAction::Jump || InputAction == EPlayerInputAction::MovementAbility;
+	const uint16 LatencySequenceId = bIsMovementAction ? BeginMovementLatencySequence() : 0;
+
+	bool bExecuted = true;
+	switch (InputAction)
+	{
+	case EPlayerInputAction::Jump:
+		bExecuted = CachedOwnerCharacter->AttemptToJump();
+		break;
+	case EPlayerInputAction::MovementAbility:
+		bExecuted = CachedOwnerCharacter->TryActivateAbility();
+		break;
+	case EPlayerInputAction::Reload:
+		bExecuted = CachedOwnerCharacter->TryToReloadWeapon();
+		break;
+	default:
+		break;
+	}
+
+	// Blocked presses never cause movement, so they would otherwise be timed against the next one that does.
+	if (!bExecuted && LatencySequenceId != 0)
+	{
+		UTPPLatencySubsystem::Get(this)->EndSequence(CachedOwnerCharacter, ETPPLatencyTrace::Movement, LatencySequenceId);
+	}
+
+	return bExecuted;
+}
+
+void ATPPPlayerController::ConsumeBufferedInput()
+{
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	while (InputBuffer.Num() > 0 && CachedOwnerCharacter)
+	{
+		// Leave the rest for when the new move ends.
+		if (CachedOwnerCharacter->GetCurrentSpecialMove())
+		{
+			return;
+		}
+
+		const FTPPBufferedInput BufferedInput = InputBuffer.GetOldest();
+		InputBuffer.PopOldest();
+
+		if (CurrentTime - BufferedInput.Timestamp <= InputActionStates[(int32)BufferedInput.InputAction].BufferWindow)
+		{
+			ExecuteInputAction(BufferedInput.InputAction);
+		}
+	}
+}
+
+void ATPPPlayerController::ProcessPlayerInput(const float DeltaTime, const bool bGamePaused)
+{
+	if (InputRecordingMode == ETPPInputRecordingMode::Replaying)
+	{
+		ReplayInputFrame();
+		return;
+	}
+
+	if (InputRecordingMode == ETPPInputRecordingMode::Recording)
+	{
+		// Pawn movement for the pending frame has been applied by now, so its trace can be captured.
+		CommitPendingInputFrame();
+
+		PendingInputFrame = FTPPRecordedInputFrame();
+		PendingInputFrame.DeltaTime = DeltaTime;
+		bHasPendingInputFrame = true;
+	}
+
+	Super::ProcessPlayerInput(DeltaTime, bGamePaused);
 }
 
 void ATPPPlayerController::UpdateRotation(float DeltaTime)
@@ -71,6 +286,22 @@ void ATPPPlayerController::UpdateRotation(float DeltaTime)
 		return;
 	}
 
+	// Replayed rotation already includes recoil, so apply it directly.
+	if (InputRecordingMode == ETPPInputRecordingMode::Replaying)
+	{
+		if (InputRecording.Frames.IsValidIndex(ReplayFrameIndex - 1))
+		{
+			const FRotator ReplayedRotation = InputRecording.Frames[ReplayFrameIndex - 1].ControlRotation;
+			SetControlRotation(ReplayedRotation);
+			if (APawn* const P = GetPawnOrSpectator())
+			{
+				P->FaceRotation(ReplayedRotation, DeltaTime);
+			}
+			UpdateReplicatedControlRotation(ReplayedRotation);
+		}
+		return;
+	}
+
 	// Calculate Delta to be applied on ViewRotation
 	FRotator DeltaRot(RotationInput);
 
@@ -125,6 +356,11 @@ void ATPPPlayerController::UpdateRotation(float DeltaTime)
 	{
 		UpdateReplicatedControlRotation(ViewRotation);
 	}
+
+	if (InputRecordingMode == ETPPInputRecordingMode::Recording)
+	{
+		PendingInputFrame.ControlRotation = ViewRotation;
+	}
 }
 
 void ATPPPlayerController::UpdateReplicatedControlRotation_Implementation(const FRotator& NewRotation)
@@ -157,6 +393,7 @@ void ATPPPlayerController::MoveForward(float Value)
 	const FVector Direction = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::X);
 
 	DesiredMovementDirection.X = Value;
+	PendingInputFrame.MoveForwardValue = Value;
 	APawn* TargetPawn = GetPawn();
 	if (bIsMovementInputEnabled && TargetPawn)
 	{
@@ -173,6 +410,7 @@ void ATPPPlayerController::MoveRight(float Value)
 	// get right vector 
 	const FVector Direction = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::Y);
 	DesiredMovementDirection.Y = Value;
+	PendingInputFrame.MoveRightValue = Value;
 
 	// add movement in that direction
 	APawn* TargetPawn = GetPawn();
@@ -194,37 +432,62 @@ void ATPPPlayerController::TurnRate(float value)
 
 void ATPPPlayerController::OnJumpPressed()
 {
-	CachedOwnerCharacter->AttemptToJump();
+	RecordInputAction(EPlayerInputAction::Jump, true);
+	HandleInputActionPressed(EPlayerInputAction::Jump);
 }
 
 void ATPPPlayerController::OnJumpReleased()
 {
+	RecordInputAction(EPlayerInputAction::Jump, false);
+	HandleInputActionReleased(EPlayerInputAction::Jump);
 	CachedOwnerCharacter->StopJumping();
 }
 
 void ATPPPlayerController::OnSprintPressed()
 {
+	RecordInputAction(EPlayerInputAction::Sprint, true);
 	CachedOwnerCharacter->SetWantsToSprint(true);
 }
 
 void ATPPPlayerController::OnSprintReleased()
 {
+	RecordInputAction(EPlayerInputAction::Sprint, false);
 	CachedOwnerCharacter->SetWantsToSprint(false);
 }
 
 void ATPPPlayerController::OnCrouchPressed()
 {
+	RecordInputAction(EPlayerInputAction::Crouch, true);
 	CachedOwnerCharacter->Crouch(false);
 }
 
 void ATPPPlayerController::OnCrouchReleased()
 {
+	RecordInputAction(EPlayerInputAction::Crouch, false);
 	CachedOwnerCharacter->UnCrouch(false);
 }
 
 void ATPPPlayerController::OnMovementAbilityPressed()
 {
-	CachedOwnerCharacter->TryActivateAbility();
+	RecordInputAction(EPlayerInputAction::MovementAbility, true);
+	HandleInputActionPressed(EPlayerInputAction::MovementAbility);
+}
+
+void ATPPPlayerController::OnMovementAbilityReleased()
+{
+	RecordInputAction(EPlayerInputAction::MovementAbility, false);
+	HandleInputActionReleased(EPlayerInputAction::MovementAbility);
+}
+
+uint16 ATPPPlayerController::BeginMovementLatencySequence()
+{
+	UTPPLatencySubsystem* LatencySubsystem = UTPPLatencySubsystem::Get(this);
+	if (LatencySubsystem && CachedOwnerCharacter)
+	{
+		return LatencySubsystem->BeginSequence(CachedOwnerCharacter, ETPPLatencyTrace::Movement, FPlatformTime::Seconds());
+	}
+
+	return 0;
 }
 
 void ATPPPlayerController::SetMovementInputEnabled(bool bIsEnabled)
@@ -234,36 +497,77 @@ void ATPPPlayerController::SetMovementInputEnabled(bool bIsEnabled)
 
 void ATPPPlayerController::HandleWeaponFireAxis(float Value)
 {
+	FireWeaponAxisValue = Value;
+	PendingInputFrame.FireWeaponAxisValue = Value;
 	if (Value >= FireWeaponThreshold && CachedOwnerCharacter)
 	{
+		LastFireInputTime = FPlatformTime::Seconds();
 		CachedOwnerCharacter->TryToFireWeapon();
 	}
 }
 
 void ATPPPlayerController::OnAimWeaponPressed()
 {
+	RecordInputAction(EPlayerInputAction::ADS, true);
 	if (CachedOwnerCharacter)
 	{
 		CachedOwnerCharacter->SetPlayerWantsToAim(true);
+
+		if (CachedOwnerCharacter->CanPlayerBeginAiming())
+		{
+			SnapAimToLockOnTarget();
+		}
 	}
 }
 
 void ATPPPlayerController::OnAimWeaponReleased()
 {
+	RecordInputAction(EPlayerInputAction::ADS, false);
 	if (CachedOwnerCharacter)
 	{
 		CachedOwnerCharacter->SetPlayerWantsToAim(false);
 	}
 }
 
-void ATPPPlayerController::OnReloadPressed()
+void ATPPPlayerController::SnapAimToLockOnTarget()
 {
-	if (CachedOwnerCharacter)
+	const UTPPGameInstance* GameInstance = UTPPGameInstance::Get();
+	const UTPPAimProperties* AimProperties = GameInstance ? GameInstance->GetAimProperties() : nullptr;
+	const UTPPLockOnSubsystem* LockOnSubsystem = UTPPLockOnSubsystem::Get(this);
+	if (!AimProperties || AimProperties->LockOnConeHalfAngle <= 0.0f || !LockOnSubsystem || !IsLocalController())
 	{
-		CachedOwnerCharacter->TryToReloadWeapon();
+		return;
+	}
+
+	FRotator ViewRotation;
+	FTPPLockOnQuery Query;
+	GetPlayerViewPoint(Query.ViewLocation, ViewRotation);
+	Query.ViewDirection = ViewRotation.Vector();
+	Query.ConeHalfAngle = AimProperties->LockOnConeHalfAngle;
+	Query.MaxDistance = AimProperties->HitScanLength;
+	Query.IgnoredActor = CachedOwnerCharacter;
+
+	ABaseEnemy* Target = LockOnSubsystem->FindBestTarget(Query);
+	if (Target)
+	{
+		FRotator TargetRotation = (Target->GetLockOnLocation() - Query.ViewLocation).Rotation();
+		TargetRotation.Roll = GetControlRotation().Roll;
+		SetControlRotation(TargetRotation);
 	}
 }
 
+void ATPPPlayerController::OnReloadPressed()
+{
+	RecordInputAction(EPlayerInputAction::Reload, true);
+	HandleInputActionPressed(EPlayerInputAction::Reload);
+}
+
+void ATPPPlayerController::OnReloadReleased()
+{
+	RecordInputAction(EPlayerInputAction::Reload, false);
+	HandleInputActionReleased(EPlayerInputAction::Reload);
+}
+
 void ATPPPlayerController::OnPausePressed()
 {
 #if !WITH_EDITOR
@@ -287,11 +591,6 @@ FVector ATPPPlayerController::GetControllerRelativeDesiredMovementDirection() co
 	return ControllerDesiredMovementDirection.IsNearlyZero() ? ControllerDesiredMovementDirection : GetControllerRelativeMovementRotation().Vector();
 }
 
-ATPPPlayerCharacter* ATPPPlayerController::GetOwnerCharacter()
-{
-	return Cast<ATPPPlayerCharacter>(GetPawn());
-}
-
 FVector ATPPPlayerController::GetControllerRelativeForwardVector(bool bIncludeVertical) const
 {
 	const FRotator CurrentRotation = GetControlRotation();
@@ -344,4 +643,379 @@ void ATPPPlayerController::AddCameraRecoil(const float RecoilToAdd)
 void ATPPPlayerController::ResetCameraRecoil()
 {
 	TargetCameraRecoil = FRotator::ZeroRotator;
-}
\ No newline at end of file
+}
+
+void ATPPPlayerController::TPPRecordInput(const FString& Filename)
+{
+	APawn* const P = GetPawn();
+	if (!P || InputRecordingMode != ETPPInputRecordingMode::None)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Unable to record input. A pawn is required and no recording or replay can be in progress."));
+		return;
+	}
+
+	InputRecording.Reset();
+	InputRecording.MapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	InputRecording.StartLocation = P->GetActorLocation();
+	InputRecording.StartRotation = GetControlRotation();
+	InputRecordingFilename = Filename;
+	bHasPendingInputFrame = false;
+	InputRecordingMode = ETPPInputRecordingMode::Recording;
+}
+
+void ATPPPlayerController::TPPStopRecordingInput()
+{
+	if (InputRecordingMode != ETPPInputRecordingMode::Recording)
+	{
+		return;
+	}
+
+	CommitPendingInputFrame();
+	InputRecordingMode = ETPPInputRecordingMode::None;
+
+	if (InputRecording.SaveToFile(InputRecordingFilename))
+	{
+		UE_LOG(LogTemp, Log, TEXT("Saved %d input frames to %s"), InputRecording.Frames.Num(), *FTPPInputRecording::GetRecordingPath(InputRecordingFilename));
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to save input recording to %s"), *FTPPInputRecording::GetRecordingPath(InputRecordingFilename));
+	}
+}
+
+void ATPPPlayerController::TPPReplayInput(const FString& Filename)
+{
+	if (InputRecordingMode != ETPPInputRecordingMode::None)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Unable to replay input while a recording or replay is in progress."));
+		return;
+	}
+
+	if (!HasAuthority())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Unable to replay input. Replays spawn their own character so need authority."));
+		FinishInputReplay();
+		return;
+	}
+
+	if (!InputRecording.LoadFromFile(Filename) || InputRecording.Frames.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load input recording %s"), *FTPPInputRecording::GetRecordingPath(Filename));
+		FinishInputReplay();
+		return;
+	}
+
+	const FString CurrentMapName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	if (InputRecording.MapName != CurrentMapName)
+	{
+		UTPPGameInstance* GameInstance = GetGameInstance<UTPPGameInstance>();
+		if (GameInstance)
+		{
+			// The controller doesn't survive travel, so the game instance holds the request until the new map's controller begins play.
+			UE_LOG(LogTemp, Log, TEXT("Input recording was made on %s. Travelling there from %s before replaying."), *InputRecording.MapName, *CurrentMapName);
+			GameInstance->SetPendingInputReplay(Filename);
+			UGameplayStatics::OpenLevel(this, FName(*InputRecording.MapName));
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("Unable to travel to %s to replay input"), *InputRecording.MapName);
+			FinishInputReplay();
+		}
+		return;
+	}
+
+	if (!SpawnReplayCharacter())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Unable to spawn a character to replay input on"));
+		FinishInputReplay();
+		return;
+	}
+
+	SetControlRotation(InputRecording.StartRotation);
+	DesiredControlRotation = InputRecording.StartRotation;
+
+	ReplayFrameIndex = 0;
+	ReplayFirstDivergentFrame = INDEX_NONE;
+	ReplayMaxLocationError = 0.0f;
+	ReplayMaxVelocityError = 0.0f;
+	ReplayStartRealTime = FPlatformTime::Seconds();
+	InputRecordingMode = ETPPInputRecordingMode::Replaying;
+
+	// Replayed frames must be processed with their recorded delta time. The engine picks up the fixed delta time on the following frame.
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(InputRecording.Frames[0].DeltaTime);
+}
+
+void ATPPPlayerController::TPPDumpLatency()
+{
+	UTPPLatencySubsystem* LatencySubsystem = UTPPLatencySubsystem::Get(this);
+	if (LatencySubsystem)
+	{
+		LatencySubsystem->DumpHistograms();
+	}
+}
+
+void ATPPPlayerController::TPPResetLatency()
+{
+	UTPPLatencySubsystem* LatencySubsystem = UTPPLatencySubsystem::Get(this);
+	if (LatencySubsystem)
+	{
+		LatencySubsystem->ResetHistograms();
+	}
+}
+
+void ATPPPlayerController::TPPDumpNetObjects()
+{
+	UWorld* World = GetWorld();
+	UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	if (!NetDriver || !NetDriver->IsServer())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TPPDumpNetObjects needs to run on a server"));
+		return;
+	}
+
+	int32 NumActive = 0;
+	int32 NumActivePickups = 0;
+	int32 NumActiveWeapons = 0;
+	for (const TSharedPtr<FNetworkObjectInfo>& ObjectInfo : NetDriver->GetNetworkObjectList().GetActiveObjects())
+	{
+		const AActor* Actor = ObjectInfo.IsValid() ? ObjectInfo->Actor : nullptr;
+		++NumActive;
+		NumActivePickups += Actor && Actor->IsA<ATPPPickupBase>();
+		NumActiveWeapons += Actor && Actor->IsA<ATPPWeaponBase>();
+	}
+
+	const int32 NumAll = NetDriver->GetNetworkObjectList().GetAllObjects().Num();
+	UE_LOG(LogTemp, Log, TEXT("Network objects: %d, considered per net tick: %d (pickups %d, weapons %d), fully dormant: %d, connections: %d"),
+		NumAll, NumActive, NumActivePickups, NumActiveWeapons, NumAll - NumActive, NetDriver->ClientConnections.Num());
+
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (Connection)
+		{
+			UE_LOG(LogTemp, Log, TEXT("  %s: %d dormant"), *Connection->LowLevelGetRemoteAddress(), NetDriver->GetNetworkObjectList().GetNumDormantActorsForConnection(Connection));
+		}
+	}
+}
+
+void ATPPPlayerController::TPPCaptureFramePerf(int32 NumFrames)
+{
+	FTPPFramePerfCapture::Get().Start(NumFrames);
+}
+
+void ATPPPlayerController::TPPCaptureSlateTiming(int32 NumFrames)
+{
+#if !UE_SERVER
+	FTPPSlateTimingCapture::Get().Start(NumFrames);
+#endif
+}
+
+void ATPPPlayerController::CommitPendingInputFrame()
+{
+	if (!bHasPendingInputFrame)
+	{
+		return;
+	}
+
+	if (APawn* const P = GetPawn())
+	{
+		PendingInputFrame.PawnLocation = P->GetActorLocation();
+		PendingInputFrame.PawnVelocity = P->GetVelocity();
+	}
+
+	InputRecording.Frames.Add(PendingInputFrame);
+	bHasPendingInputFrame = false;
+}
+
+void ATPPPlayerController::ReplayInputFrame()
+{
+	APawn* const P = GetPawn();
+	if (!P)
+	{
+		FinishInputReplay();
+		return;
+	}
+
+	// Movement for the previous replayed frame has been applied, so compare against its trace.
+	if (InputRecording.Frames.IsValidIndex(ReplayFrameIndex - 1))
+	{
+		const FTPPRecordedInputFrame& ReplayedFrame = InputRecording.Frames[ReplayFrameIndex - 1];
+		const float LocationError = FVector::Dist(P->GetActorLocation(), ReplayedFrame.PawnLocation);
+		const float VelocityError = FVector::Dist(P->GetVelocity(), ReplayedFrame.PawnVelocity);
+		ReplayMaxLocationError = FMath::Max(ReplayMaxLocationError, LocationError);
+		ReplayMaxVelocityError = FMath::Max(ReplayMaxVelocityError, VelocityError);
+
+		if (ReplayFirstDivergentFrame == INDEX_NONE && (LocationError > ReplayLocationTolerance || VelocityError > ReplayVelocityTolerance))
+		{
+			ReplayFirstDivergentFrame = ReplayFrameIndex - 1;
+			UE_LOG(LogTemp, Warning, TEXT("Input replay diverged on frame %d. Location error %.3f, velocity error %.3f"), ReplayFirstDivergentFrame, LocationError, VelocityError);
+		}
+	}
+
+	if (!InputRecording.Frames.IsValidIndex(ReplayFrameIndex))
+	{
+		FinishInputReplay();
+		return;
+	}
+
+	const FTPPRecordedInputFrame& Frame = InputRecording.Frames[ReplayFrameIndex++];
+
+	// Actions are applied before axes, in enum order. Presses and releases of the same action in a single frame are applied as a press then release.
+	const UEnum* InputActionEnum = StaticEnum<EPlayerInputAction>();
+	for (int32 i = 0; i < InputActionEnum->NumEnums() - 1; ++i)
+	{
+		const EPlayerInputAction Action = (EPlayerInputAction)InputActionEnum->GetValueByIndex(i);
+		const uint8 ActionBit = 1 << (uint8)Action;
+		if (Frame.PressedActions & ActionBit)
+		{
+			switch (Action)
+			{
+			case EPlayerInputAction::Jump:
+				OnJumpPressed();
+				break;
+			case EPlayerInputAction::MovementAbility:
+				OnMovementAbilityPressed();
+				break;
+			case EPlayerInputAction::Sprint:
+				OnSprintPressed();
+				break;
+			case EPlayerInputAction::Crouch:
+				OnCrouchPressed();
+				break;
+			case EPlayerInputAction::ADS:
+				OnAimWeaponPressed();
+				break;
+			case EPlayerInputAction::Reload:
+				OnReloadPressed();
+				break;
+			default:
+				break;
+			}
+		}
+
+		if (Frame.ReleasedActions & ActionBit)
+		{
+			switch (Action)
+			{
+			case EPlayerInputAction::Jump:
+				OnJumpReleased();
+				break;
+			case EPlayerInputAction::MovementAbility:
+				OnMovementAbilityReleased();
+				break;
+			case EPlayerInputAction::Sprint:
+				OnSprintReleased();
+				break;
+			case EPlayerInputAction::Crouch:
+				OnCrouchReleased();
+				break;
+			case EPlayerInputAction::ADS:
+				OnAimWeaponReleased();
+				break;
+			case EPlayerInputAction::Reload:
+				OnReloadReleased();
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	MoveForward(Frame.MoveForwardValue);
+	MoveRight(Frame.MoveRightValue);
+	HandleWeaponFireAxis(Frame.FireWeaponAxisValue);
+
+	if (InputRecording.Frames.IsValidIndex(ReplayFrameIndex))
+	{
+		FApp::SetFixedDeltaTime(InputRecording.Frames[ReplayFrameIndex].DeltaTime);
+	}
+}
+
+void ATPPPlayerController::FinishInputReplay()
+{
+	const bool bWasReplaying = InputRecordingMode == ETPPInputRecordingMode::Replaying;
+	bool bPassed = false;
+	if (bWasReplaying)
+	{
+		InputRecordingMode = ETPPInputRecordingMode::None;
+		FApp::SetUseFixedTimeStep(false);
+
+		const double ReplayDuration = FPlatformTime::Seconds() - ReplayStartRealTime;
+		UE_LOG(LogTemp, Log, TEXT("Input replay finished. %d of %d frames in %.3fs. Max location error %.3f, max velocity error %.3f, first divergent frame %d"),
+			ReplayFrameIndex, InputRecording.Frames.Num(), ReplayDuration, ReplayMaxLocationError, ReplayMaxVelocityError, ReplayFirstDivergentFrame);
+
+		// Every frame has to be compared for the replay to count, which only happens once the index has run past the last one.
+		bPassed = ReplayFirstDivergentFrame == INDEX_NONE && ReplayFrameIndex == InputRecording.Frames.Num();
+	}
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("TPPReplayExit")))
+	{
+		UE_LOG(LogTemp, Display, TEXT("Input replay regression check %s"), bPassed ? TEXT("passed") : TEXT("failed"));
+		FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+	}
+}
+
+void ATPPPlayerController::StartPendingInputReplay()
+{
+	UTPPGameInstance* GameInstance = GetGameInstance<UTPPGameInstance>();
+	if (GameInstance)
+	{
+		TPPReplayInput(GameInstance->ConsumePendingInputReplay());
+	}
+}
+
+bool ATPPPlayerController::SpawnReplayCharacter()
+{
+	AGameModeBase* GameMode = GetWorld()->GetAuthGameMode();
+	UClass* PawnClass = GameMode ? GameMode->GetDefaultPawnClassForController(this) : nullptr;
+	if (!PawnClass || !PawnClass->IsChildOf(ATPPPlayerCharacter::StaticClass()))
+	{
+		PawnClass = ATPPPlayerCharacter::StaticClass();
+	}
+
+	// Destroy the old pawn first so its capsule can't block the new one at the recorded start.
+	APawn* const OldPawn = GetPawn();
+	if (OldPawn)
+	{
+		UnPossess();
+		OldPawn->Destroy();
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	const FRotator StartPawnRotation(0.0f, InputRecording.StartRotation.Yaw, 0.0f);
+	ATPPPlayerCharacter* ReplayCharacter = GetWorld()->SpawnActor<ATPPPlayerCharacter>(PawnClass, InputRecording.StartLocation, StartPawnRotation, SpawnParams);
+	if (!ReplayCharacter)
+	{
+		return false;
+	}
+
+	Possess(ReplayCharacter);
+
+	// Clear any input state left from before the replay. The input buffer is reset when the new pawn is set.
+	DesiredMovementDirection = FVector::ZeroVector;
+	FireWeaponAxisValue = 0.0f;
+	CurrentCameraRecoil = FRotator::ZeroRotator;
+	ResetCameraRecoil();
+	bIsMovementInputEnabled = true;
+	InitInputActionStates();
+	return true;
+}
+
+void ATPPPlayerController::RecordInputAction(EPlayerInputAction Action, bool bPressed)
+{
+	if (InputRecordingMode != ETPPInputRecordingMode::Recording)
+	{
+		return;
+	}
+
+	const uint8 ActionBit = 1 << (uint8)Action;
+	if (bPressed)
+	{
+		PendingInputFrame.PressedActions |= ActionBit;
+	}
+	else
+	{
+		PendingInputFrame.ReleasedActions |= ActionBit;
+	}
+}
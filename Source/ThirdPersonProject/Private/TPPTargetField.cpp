@@ -0,0 +1,235 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TPPTargetField.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+#include "Debug/TPPStartupProfiler.h"
+
+DECLARE_CYCLE_STAT(TEXT("Target Field Update"), STAT_TPPTargetFieldUpdate, STATGROUP_ThirdPersonProject);
+DECLARE_CYCLE_STAT(TEXT("Target Field Collider Assignment"), STAT_TPPTargetFieldColliderAssignment, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Target Field Targets"), STAT_TPPTargetFieldTargets, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Target Field Active Colliders"), STAT_TPPTargetFieldActiveColliders, STATGROUP_ThirdPersonProject);
+
+ATPPTargetField::ATPPTargetField()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	TargetInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("TargetInstances"));
+	TargetInstances->SetMobility(EComponentMobility::Movable);
+	TargetInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	TargetInstances->SetGenerateOverlapEvents(false);
+	TargetInstances->SetCanEverAffectNavigation(false);
+	SetRootComponent(TargetInstances);
+}
+
+void ATPPTargetField::BeginPlay()
+{
+	FTPPScopedStartupTimer StartupTimer(this);
+	Super::BeginPlay();
+
+	InitializeTargets();
+
+	for (int32 i = 0; i < MaxColliders; ++i)
+	{
+		USphereComponent* Collider = NewObject<USphereComponent>(this);
+		Collider->SetUsingAbsoluteLocation(true);
+		Collider->SetSphereRadius(ColliderRadius);
+		Collider->SetCollisionProfileName(UCollisionProfile::BlockAllDynamic_ProfileName);
+		Collider->SetCollisionResponseToChannel(ECollisionChannel::ECC_GameTraceChannel1, ECollisionResponse::ECR_Block);
+		Collider->SetGenerateOverlapEvents(false);
+		Collider->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Collider->SetupAttachment(TargetInstances);
+		Collider->RegisterComponent();
+
+		ColliderPool.Add(Collider);
+		ColliderTargetIndices.Add(INDEX_NONE);
+	}
+
+	INC_DWORD_STAT_BY(STAT_TPPTargetFieldTargets, NumTargets);
+}
+
+void ATPPTargetField::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	DEC_DWORD_STAT_BY(STAT_TPPTargetFieldTargets, NumTargets);
+	for (int32 TargetIndex : ColliderTargetIndices)
+	{
+		if (TargetIndex != INDEX_NONE)
+		{
+			DEC_DWORD_STAT(STAT_TPPTargetFieldActiveColliders);
+		}
+	}
+}
+
+void ATPPTargetField::InitializeTargets()
+{
+	// Pad to whole vector registers so the update loop needs no remainder handling.
+	const int32 NumPaddedTargets = Align(NumTargets, 4);
+	for (TArray<float>* TargetArray : { &BaseLocationsX, &BaseLocationsY, &BaseLocationsZ, &Amplitudes, &PeriodScales, &Phases, &Offsets })
+	{
+		TargetArray->Reset(NumPaddedTargets);
+		TargetArray->AddZeroed(NumPaddedTargets);
+	}
+
+	FRandomStream RandomStream(RandomSeed);
+	const int32 RowLength = FMath::Max(TargetsPerRow, 1);
+	for (int32 i = 0; i < NumTargets; ++i)
+	{
+		BaseLocationsX[i] = (i / RowLength) * TargetSpacing;
+		BaseLocationsY[i] = (i % RowLength) * TargetSpacing;
+		BaseLocationsZ[i] = 0.0f;
+		Amplitudes[i] = RandomStream.FRandRange(MinAmplitude, MaxAmplitude);
+		PeriodScales[i] = RandomStream.FRandRange(MinPeriodScale, MaxPeriodScale);
+		Phases[i] = RandomStream.FRandRange(0.0f, 2.0f * PI);
+	}
+
+	UpdateOffsets(GetServerWorldTimeSeconds());
+
+	InstanceTransforms.SetNum(NumTargets);
+	for (int32 i = 0; i < NumTargets; ++i)
+	{
+		InstanceTransforms[i] = FTransform(FVector(BaseLocationsX[i], BaseLocationsY[i] + Offsets[i], BaseLocationsZ[i]));
+	}
+
+	TargetInstances->ClearInstances();
+	TargetInstances->AddInstances(InstanceTransforms, false);
+}
+
+void ATPPTargetField::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_TPPTargetFieldUpdate);
+
+	if (NumTargets <= 0)
+	{
+		return;
+	}
+
+	UpdateOffsets(GetServerWorldTimeSeconds());
+
+	for (int32 i = 0; i < NumTargets; ++i)
+	{
+		InstanceTransforms[i].SetTranslation(FVector(BaseLocationsX[i], BaseLocationsY[i] + Offsets[i], BaseLocationsZ[i]));
+	}
+	TargetInstances->BatchUpdateInstancesTransforms(0, InstanceTransforms, false, true, true);
+
+	TimeUntilColliderAssignment -= DeltaTime;
+	if (TimeUntilColliderAssignment <= 0.0f)
+	{
+		TimeUntilColliderAssignment = ColliderAssignmentInterval;
+		AssignColliders();
+	}
+
+	UpdateColliders();
+}
+
+void ATPPTargetField::UpdateOffsets(float WorldTime)
+{
+	// Same motion as ABaseEnemy, with a per target phase: Offset = Amplitude * Sin(Time * PeriodScale + Phase)
+	const VectorRegister TimeRegister = VectorSetFloat1(WorldTime);
+	const int32 NumPaddedTargets = Offsets.Num();
+	for (int32 i = 0; i < NumPaddedTargets; i += 4)
+	{
+		const VectorRegister Angle = VectorMultiplyAdd(TimeRegister, VectorLoad(&PeriodScales[i]), VectorLoad(&Phases[i]));
+		VectorStore(VectorMultiply(VectorLoad(&Amplitudes[i]), VectorSin(Angle)), &Offsets[i]);
+	}
+}
+
+void ATPPTargetField::AssignColliders()
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPPTargetFieldColliderAssignment);
+
+	TArray<FVector, TInlineAllocator<8>> PlayerLocations;
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APawn* PlayerPawn = Iterator->IsValid() ? (*Iterator)->GetPawn() : nullptr;
+		if (PlayerPawn)
+		{
+			PlayerLocations.Add(GetActorTransform().InverseTransformPosition(PlayerPawn->GetActorLocation()));
+		}
+	}
+
+	// Candidates are gathered in field space, so target locations don't need transforming.
+	const float ActivationDistanceSquared = ColliderActivationDistance * ColliderActivationDistance;
+	TArray<TPair<float, int32>, TInlineAllocator<256>> Candidates;
+	for (int32 i = 0; i < NumTargets && PlayerLocations.Num() > 0; ++i)
+	{
+		const FVector TargetLocation(BaseLocationsX[i], BaseLocationsY[i] + Offsets[i], BaseLocationsZ[i]);
+		float ClosestDistanceSquared = BIG_NUMBER;
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, FVector::DistSquared(TargetLocation, PlayerLocation));
+		}
+
+		if (ClosestDistanceSquared <= ActivationDistanceSquared)
+		{
+			Candidates.Emplace(ClosestDistanceSquared, i);
+		}
+	}
+
+	if (Candidates.Num() > ColliderPool.Num())
+	{
+		Candidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+	}
+
+	for (int32 i = 0; i < ColliderPool.Num(); ++i)
+	{
+		const bool bHasTarget = Candidates.IsValidIndex(i);
+		const bool bHadTarget = ColliderTargetIndices[i] != INDEX_NONE;
+		ColliderTargetIndices[i] = bHasTarget ? Candidates[i].Value : INDEX_NONE;
+		if (bHasTarget != bHadTarget)
+		{
+			ColliderPool[i]->SetCollisionEnabled(bHasTarget ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision);
+			if (bHasTarget)
+			{
+				INC_DWORD_STAT(STAT_TPPTargetFieldActiveColliders);
+			}
+			else
+			{
+				DEC_DWORD_STAT(STAT_TPPTargetFieldActiveColliders);
+			}
+		}
+	}
+}
+
+void ATPPTargetField::UpdateColliders()
+{
+	for (int32 i = 0; i < ColliderPool.Num(); ++i)
+	{
+		const int32 TargetIndex = ColliderTargetIndices[i];
+		if (TargetIndex != INDEX_NONE)
+		{
+			ColliderPool[i]->SetWorldLocation(GetFieldTargetLocation(TargetIndex), false, nullptr, ETeleportType::TeleportPhysics);
+		}
+	}
+}
+
+FVector ATPPTargetField::GetFieldTargetLocation(int32 TargetIndex) const
+{
+	if (!Offsets.IsValidIndex(TargetIndex) || TargetIndex >= NumTargets)
+	{
+		return GetActorLocation();
+	}
+
+	return GetActorTransform().TransformPosition(FVector(BaseLocationsX[TargetIndex], BaseLocationsY[TargetIndex] + Offsets[TargetIndex], BaseLocationsZ[TargetIndex]));
+}
+
+float ATPPTargetField::GetServerWorldTimeSeconds() const
+{
+	const UWorld* World = GetWorld();
+	const AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+	if (GameState)
+	{
+		return GameState->GetServerWorldTimeSeconds();
+	}
+
+	return World ? World->GetTimeSeconds() : 0.0f;
+}
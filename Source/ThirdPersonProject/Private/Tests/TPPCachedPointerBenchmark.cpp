@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Tests/TPPTestWorld.h"
+#include "ThirdPersonProject/TPPPlayerCharacter.h"
+#include "TPPMovementComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTPPCachedPointerBenchmark, "ThirdPersonProject.Perf.CachedPointers", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FTPPCachedPointerBenchmark::RunTest(const FString& Parameters)
+{
+	FTPPTestWorld TestWorld;
+	ATPPPlayerCharacter* Character = TestWorld.SpawnActor<ATPPPlayerCharacter>();
+	if (!TestNotNull(TEXT("Character"), Character))
+	{
+		return false;
+	}
+
+	static const int32 NumCalls = 1000000;
+	int32 NumFound = 0;
+
+	const double CastStartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumCalls; ++i)
+	{
+		NumFound += Cast<UTPPMovementComponent>(Character->GetCharacterMovement()) != nullptr;
+	}
+	const double CastSeconds = FPlatformTime::Seconds() - CastStartTime;
+
+	const double CachedStartTime = FPlatformTime::Seconds();
+	for (int32 i = 0; i < NumCalls; ++i)
+	{
+		NumFound += Character->GetTPPMovementComponent() != nullptr;
+	}
+	const double CachedSeconds = FPlatformTime::Seconds() - CachedStartTime;
+
+	TestEqual(TEXT("Both lookups find the movement component"), NumFound, NumCalls * 2);
+	AddInfo(FString::Printf(TEXT("Cast: %.2f ns per call, cached: %.2f ns per call"), CastSeconds * 1e9 / NumCalls, CachedSeconds * 1e9 / NumCalls));
+
+	return true;
+}
+
+#endif
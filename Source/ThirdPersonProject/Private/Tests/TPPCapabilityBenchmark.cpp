@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Tests/TPPTestWorld.h"
+#include "ThirdPersonProject/TPPPlayerCharacter.h"
+#include "TPPMovementComponent.h"
+#include "SpecialMove/TPPSpecialMove.h"
+#include "Weapon/TPPWeaponFirearm.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TPPCapabilityBenchmark
+{
+	static const ETPPCharacterCapability QueriedCapabilities[] =
+	{
+		ETPPCharacterCapability::Sprint,
+		ETPPCharacterCapability::Crouch,
+		ETPPCharacterCapability::Slide,
+		ETPPCharacterCapability::Jump,
+		ETPPCharacterCapability::Aim,
+		ETPPCharacterCapability::Fire,
+		ETPPCharacterCapability::Reload,
+	};
+
+	/**
+	* The checks CanSprint, CanCrouch, CanSlide, CanJumpInternal, CanPlayerBeginAiming, TryToFireWeapon and TryToReloadWeapon made on every query
+	* before the capability mask. Only the parts the mask replaced are kept, so the result should match HasCapabilities while no wall movement is active.
+	*/
+	bool HasCapabilityUncached(const ATPPPlayerCharacter* Character, const ETPPCharacterCapability Capability)
+	{
+		const UTPPSpecialMove* SpecialMove = Character->GetCurrentSpecialMove();
+		const UTPPMovementComponent* MovementComponent = Character->GetTPPMovementComponent();
+		const ATPPWeaponBase* Weapon = Character->GetCurrentEquippedWeapon();
+		const bool bIsWeaponUseBlocked = SpecialMove && SpecialMove->IsMoveBlockingWeaponUse();
+
+		switch (Capability)
+		{
+		case ETPPCharacterCapability::Sprint:
+			return !(SpecialMove && SpecialMove->bDisablesSprint) && !Character->IsPlayerAiming() && MovementComponent->IsMovingOnGround() && !Character->bIsCrouched;
+		case ETPPCharacterCapability::Crouch:
+		case ETPPCharacterCapability::Slide:
+			return !(SpecialMove && SpecialMove->bDisablesCrouch);
+		case ETPPCharacterCapability::Jump:
+			return MovementComponent && !MovementComponent->IsSliding() && !(SpecialMove && SpecialMove->bDisablesJump);
+		case ETPPCharacterCapability::Aim:
+			return Weapon && MovementComponent && !MovementComponent->IsSliding() && (!SpecialMove || !SpecialMove->bDisablesAiming);
+		case ETPPCharacterCapability::Fire:
+			return Weapon && !bIsWeaponUseBlocked;
+		case ETPPCharacterCapability::Reload:
+			return Cast<ATPPWeaponFirearm>(Weapon) && !bIsWeaponUseBlocked && !MovementComponent->HasCharacterStartedSlide();
+		}
+
+		return false;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTPPCapabilityBenchmark, "ThirdPersonProject.Perf.Capabilities", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FTPPCapabilityBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace TPPCapabilityBenchmark;
+
+	FTPPTestWorld TestWorld;
+	ATPPPlayerCharacter* Character = TestWorld.SpawnActor<ATPPPlayerCharacter>();
+	UTPPMovementComponent* MovementComponent = Character ? Character->GetTPPMovementComponent() : nullptr;
+	if (!TestNotNull(TEXT("Character"), MovementComponent))
+	{
+		return false;
+	}
+
+	// The mask has to agree with the old checks in each state. Movement mode changes update the mask through the character.
+	const EMovementMode TestedModes[] = { EMovementMode::MOVE_Falling, EMovementMode::MOVE_Walking };
+	for (const EMovementMode Mode : TestedModes)
+	{
+		MovementComponent->SetMovementMode(Mode);
+		for (const ETPPCharacterCapability Capability : QueriedCapabilities)
+		{
+			TestEqual(FString::Printf(TEXT("Capability %d in movement mode %d matches the old check"), (int32)Capability, (int32)Mode),
+				Character->HasCapabilities(Capability), HasCapabilityUncached(Character, Capability));
+		}
+	}
+
+	TestTrue(TEXT("Walking without a weapon can sprint and jump"), Character->HasCapabilities(ETPPCharacterCapability::Sprint | ETPPCharacterCapability::Jump));
+	TestFalse(TEXT("No weapon blocks aiming"), Character->HasCapabilities(ETPPCharacterCapability::Aim));
+	TestFalse(TEXT("No weapon blocks firing"), Character->HasCapabilities(ETPPCharacterCapability::Fire));
+	TestFalse(TEXT("No weapon blocks reloading"), Character->HasCapabilities(ETPPCharacterCapability::Reload));
+
+	static const int32 NumFrames = 100000;
+	int32 NumAllowedUncached = 0;
+	int32 NumAllowedCached = 0;
+
+	const double UncachedStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (const ETPPCharacterCapability Capability : QueriedCapabilities)
+		{
+			NumAllowedUncached += HasCapabilityUncached(Character, Capability);
+		}
+	}
+	const double UncachedSeconds = FPlatformTime::Seconds() - UncachedStartTime;
+
+	const double CachedStartTime = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		for (const ETPPCharacterCapability Capability : QueriedCapabilities)
+		{
+			NumAllowedCached += Character->HasCapabilities(Capability);
+		}
+	}
+	const double CachedSeconds = FPlatformTime::Seconds() - CachedStartTime;
+
+	const int32 NumQueries = NumFrames * UE_ARRAY_COUNT(QueriedCapabilities);
+	TestEqual(TEXT("Old checks and cached mask allow the same queries"), NumAllowedCached, NumAllowedUncached);
+	AddInfo(FString::Printf(TEXT("Old per-query checks: %.2f ns, cached mask: %.2f ns"), UncachedSeconds * 1e9 / NumQueries, CachedSeconds * 1e9 / NumQueries));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "TPPPlayerController.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTPPInputBufferWraparoundTest, "ThirdPersonProject.Input.InputBufferWraparound", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FTPPInputBufferWraparoundTest::RunTest(const FString& Parameters)
+{
+	FTPPInputBuffer InputBuffer;
+
+	// Move the start of the buffer off index 0 so later adds wrap around the end of the storage.
+	InputBuffer.Add(EPlayerInputAction::Jump, 0.0f);
+	InputBuffer.Add(EPlayerInputAction::Reload, 1.0f);
+	InputBuffer.PopOldest();
+	InputBuffer.PopOldest();
+	TestEqual(TEXT("Empty after popping every input"), InputBuffer.Num(), 0);
+
+	// Two more inputs than fit, so the two oldest are overwritten.
+	const int32 NumAdded = FTPPInputBuffer::Capacity + 2;
+	for (int32 i = 0; i < NumAdded; ++i)
+	{
+		InputBuffer.Add(i % 2 == 0 ? EPlayerInputAction::Jump : EPlayerInputAction::MovementAbility, (float)i);
+	}
+	TestEqual(TEXT("Full buffer keeps its capacity"), InputBuffer.Num(), FTPPInputBuffer::Capacity);
+
+	for (int32 i = NumAdded - FTPPInputBuffer::Capacity; i < NumAdded; ++i)
+	{
+		const FTPPBufferedInput& BufferedInput = InputBuffer.GetOldest();
+		TestEqual(FString::Printf(TEXT("Input %d comes out in order"), i), BufferedInput.Timestamp, (float)i);
+		TestEqual(FString::Printf(TEXT("Input %d keeps its action"), i), BufferedInput.InputAction, i % 2 == 0 ? EPlayerInputAction::Jump : EPlayerInputAction::MovementAbility);
+		InputBuffer.PopOldest();
+	}
+	TestEqual(TEXT("Empty after draining"), InputBuffer.Num(), 0);
+
+	InputBuffer.Add(EPlayerInputAction::Reload, 20.0f);
+	InputBuffer.Reset();
+	TestEqual(TEXT("Empty after reset"), InputBuffer.Num(), 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Debug/TPPInputRecording.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTPPInputRecordingRoundTripTest, "ThirdPersonProject.Debug.InputRecordingRoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FTPPInputRecordingRoundTripTest::RunTest(const FString& Parameters)
+{
+	FTPPInputRecording Recording;
+	Recording.MapName = TEXT("ThirdPersonExampleMap");
+	Recording.StartLocation = FVector(100.0f, -250.0f, 92.15f);
+	Recording.StartRotation = FRotator(-10.0f, 45.0f, 0.0f);
+
+	// Repeated frames exercise the changed field flags, the last frame changes every field at once.
+	for (int32 i = 0; i < 8; ++i)
+	{
+		FTPPRecordedInputFrame& Frame = Recording.Frames.AddDefaulted_GetRef();
+		Frame.DeltaTime = 1.0f / 60.0f;
+		Frame.MoveForwardValue = i < 4 ? 1.0f : 0.5f;
+		Frame.MoveRightValue = i == 7 ? -1.0f : 0.0f;
+		Frame.FireWeaponAxisValue = i == 7 ? 1.0f : 0.0f;
+		Frame.ControlRotation = FRotator(0.0f, 45.0f + (i == 7 ? 3.3f : 0.0f), 0.0f);
+		Frame.PressedActions = i == 2 ? 0x5 : 0;
+		Frame.ReleasedActions = i == 3 ? 0x4 : 0;
+		Frame.PawnLocation = Recording.StartLocation + FVector(i * 6.66f, 0.0f, 0.0f);
+		Frame.PawnVelocity = FVector(400.0f, 0.0f, 0.0f);
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	Writer << Recording;
+
+	FTPPInputRecording Loaded;
+	FMemoryReader Reader(Bytes);
+	Reader << Loaded;
+
+	TestFalse(TEXT("Recording loads"), Reader.IsError());
+	TestEqual(TEXT("Map name"), Loaded.MapName, Recording.MapName);
+	TestEqual(TEXT("Start location"), Loaded.StartLocation, Recording.StartLocation);
+	TestEqual(TEXT("Frame count"), Loaded.Frames.Num(), Recording.Frames.Num());
+
+	for (int32 i = 0; i < FMath::Min(Loaded.Frames.Num(), Recording.Frames.Num()); ++i)
+	{
+		const FTPPRecordedInputFrame& Expected = Recording.Frames[i];
+		const FTPPRecordedInputFrame& Actual = Loaded.Frames[i];
+		const bool bFrameMatches = Actual.DeltaTime == Expected.DeltaTime
+			&& Actual.MoveForwardValue == Expected.MoveForwardValue
+			&& Actual.MoveRightValue == Expected.MoveRightValue
+			&& Actual.FireWeaponAxisValue == Expected.FireWeaponAxisValue
+			&& Actual.ControlRotation.Equals(Expected.ControlRotation, 0.0f)
+			&& Actual.PressedActions == Expected.PressedActions
+			&& Actual.ReleasedActions == Expected.ReleasedActions
+			&& Actual.PawnLocation.Equals(Expected.PawnLocation, 0.0f)
+			&& Actual.PawnVelocity.Equals(Expected.PawnVelocity, 0.0f);
+		TestTrue(FString::Printf(TEXT("Frame %d is restored exactly"), i), bFrameMatches);
+	}
+
+	return true;
+}
+
+#endif
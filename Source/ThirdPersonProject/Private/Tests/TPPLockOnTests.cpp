@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Components/SceneComponent.h"
+#include "Tests/TPPTestWorld.h"
+#include "Game/TPPLockOnSubsystem.h"
+#include "BaseEnemy.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TPPLockOnTests
+{
+	static const int32 NumTargets = 200;
+
+	static const int32 NumQueries = 64;
+
+	static const float FieldSize = 4000.0f;
+
+	/** Spawns an enemy that can be locked onto. Native enemies have no root component, so one is added to give them a location. */
+	ABaseEnemy* SpawnTarget(const FTPPTestWorld& TestWorld, const FVector& Location)
+	{
+		ABaseEnemy* Enemy = TestWorld.SpawnActor<ABaseEnemy>();
+		if (!Enemy)
+		{
+			return nullptr;
+		}
+
+		USceneComponent* Root = NewObject<USceneComponent>(Enemy);
+		Enemy->SetRootComponent(Root);
+		Root->RegisterComponent();
+		Enemy->SetActorLocation(Location);
+
+		// Only set in blueprints, so there is no native setter.
+		FBoolProperty* LockOnProperty = FindFProperty<FBoolProperty>(ABaseEnemy::StaticClass(), TEXT("bCanBeLockedOnto"));
+		if (LockOnProperty)
+		{
+			LockOnProperty->SetPropertyValue_InContainer(Enemy, true);
+		}
+
+		return Enemy;
+	}
+
+	FVector RandomLocation(FRandomStream& RandomStream)
+	{
+		return FVector(RandomStream.FRandRange(-FieldSize, FieldSize), RandomStream.FRandRange(-FieldSize, FieldSize), RandomStream.FRandRange(0.0f, 500.0f));
+	}
+
+	/** Runs random queries and checks each against a scan of every registered target. Nothing in the world collides, so every target is visible. */
+	void CompareQueries(FAutomationTestBase& Test, const UTPPLockOnSubsystem& LockOnSubsystem, const TArray<ABaseEnemy*>& Registered, FRandomStream& RandomStream, const TCHAR* Stage)
+	{
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			FTPPLockOnQuery Query;
+			Query.ViewLocation = RandomLocation(RandomStream);
+			Query.ViewDirection = RandomStream.GetUnitVector();
+			Query.ConeHalfAngle = RandomStream.FRandRange(5.0f, 45.0f);
+			Query.MaxDistance = RandomStream.FRandRange(1000.0f, 2.0f * FieldSize);
+
+			float BestScore = MAX_flt;
+			for (ABaseEnemy* Enemy : Registered)
+			{
+				BestScore = FMath::Min(BestScore, LockOnSubsystem.GetTargetScore(Query, Enemy->GetLockOnLocation()));
+			}
+
+			// Scores are compared rather than targets, so ties between equally good targets don't fail the test.
+			ABaseEnemy* Found = LockOnSubsystem.FindBestTarget(Query);
+			const float FoundScore = Found ? LockOnSubsystem.GetTargetScore(Query, Found->GetLockOnLocation()) : MAX_flt;
+			Test.TestEqual(FString::Printf(TEXT("%s: query %d finds a target exactly when the scan does"), Stage, i), Found != nullptr, BestScore != MAX_flt);
+			if (Found && BestScore != MAX_flt)
+			{
+				Test.TestEqual(FString::Printf(TEXT("%s: query %d finds the best scoring target"), Stage, i), FoundScore, BestScore, KINDA_SMALL_NUMBER);
+			}
+		}
+	}
+
+	void TestTreeHeight(FAutomationTestBase& Test, const UTPPLockOnSubsystem& LockOnSubsystem, int32 NumRegistered, const TCHAR* Stage)
+	{
+		Test.TestTrue(FString::Printf(TEXT("%s: tree height %d is within %d"), Stage, LockOnSubsystem.GetTreeHeight(), UTPPLockOnSubsystem::GetMaxTreeHeight(NumRegistered)),
+			LockOnSubsystem.GetTreeHeight() <= UTPPLockOnSubsystem::GetMaxTreeHeight(NumRegistered));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTPPLockOnQueryTest, "ThirdPersonProject.Game.LockOnMatchesBruteForce", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FTPPLockOnQueryTest::RunTest(const FString& Parameters)
+{
+	FTPPTestWorld TestWorld;
+	if (!TestNotNull(TEXT("World"), TestWorld.Get()))
+	{
+		return false;
+	}
+
+	// Created directly so the test doesn't depend on the world's subsystems or on enemies beginning play.
+	UTPPLockOnSubsystem* LockOnSubsystem = NewObject<UTPPLockOnSubsystem>(TestWorld.Get());
+	FRandomStream RandomStream(1234);
+
+	TArray<ABaseEnemy*> Registered;
+	for (int32 i = 0; i < TPPLockOnTests::NumTargets; ++i)
+	{
+		ABaseEnemy* Enemy = TPPLockOnTests::SpawnTarget(TestWorld, TPPLockOnTests::RandomLocation(RandomStream));
+		if (!Enemy)
+		{
+			AddError(TEXT("Unable to spawn a target"));
+			return false;
+		}
+
+		LockOnSubsystem->RegisterTarget(Enemy);
+		Registered.Add(Enemy);
+	}
+
+	LockOnSubsystem->Tick(0.0f);
+	TPPLockOnTests::TestTreeHeight(*this, *LockOnSubsystem, Registered.Num(), TEXT("Registered"));
+	TPPLockOnTests::CompareQueries(*this, *LockOnSubsystem, Registered, RandomStream, TEXT("Registered"));
+
+	// Every third target moves well past its leaf margin, so the tick has to reinsert it.
+	for (int32 i = 0; i < Registered.Num(); i += 3)
+	{
+		Registered[i]->AddActorWorldOffset(RandomStream.GetUnitVector() * 1000.0f);
+	}
+
+	LockOnSubsystem->Tick(0.0f);
+	TPPLockOnTests::TestTreeHeight(*this, *LockOnSubsystem, Registered.Num(), TEXT("Moved"));
+	TPPLockOnTests::CompareQueries(*this, *LockOnSubsystem, Registered, RandomStream, TEXT("Moved"));
+
+	// Unregistered targets stay in the world and must no longer be found.
+	for (int32 i = Registered.Num() - 1; i >= 0; i -= 4)
+	{
+		LockOnSubsystem->UnregisterTarget(Registered[i]);
+		Registered.RemoveAt(i);
+	}
+
+	LockOnSubsystem->Tick(0.0f);
+	TPPLockOnTests::TestTreeHeight(*this, *LockOnSubsystem, Registered.Num(), TEXT("Unregistered"));
+	TPPLockOnTests::CompareQueries(*this, *LockOnSubsystem, Registered, RandomStream, TEXT("Unregistered"));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Tests/TPPTestWorld.h"
+#include "ThirdPersonProject/TPPPlayerCharacter.h"
+#include "TPPMovementComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TPPSlideSolverTests
+{
+	static const float SlopeAngle = 10.0f;
+
+	/** Spawns a wide floor tilted by SlopeAngle so that sliding towards -X goes downhill. Its top surface passes through (0, 0, 50). */
+	bool SpawnSlope(const FTPPTestWorld& TestWorld)
+	{
+		UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+		const FTransform FloorTransform(FRotator(SlopeAngle, 0.0f, 0.0f), FVector::ZeroVector, FVector(100.0f, 100.0f, 1.0f));
+		AStaticMeshActor* Floor = CubeMesh ? TestWorld.Get()->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), FloorTransform) : nullptr;
+		if (!Floor)
+		{
+			return false;
+		}
+
+		Floor->SetMobility(EComponentMobility::Movable);
+		return Floor->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+	}
+
+	/** Slides a character down the slope for one second at the given frame rate by ticking its movement component, and returns the distance covered */
+	float SimulateSlideDistance(const FTPPTestWorld& TestWorld, const float FrameRate, const float LaneY)
+	{
+		// Rest the capsule just above the slope, so the first slide update finds the floor.
+		const float Radius = GetDefault<ATPPPlayerCharacter>()->GetCapsuleComponent()->GetScaledCapsuleRadius();
+		const float HalfHeight = GetDefault<ATPPPlayerCharacter>()->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		const float CosSlope = FMath::Cos(FMath::DegreesToRadians(SlopeAngle));
+		const FVector SpawnLocation(0.0f, LaneY, (50.0f / CosSlope) + (Radius / CosSlope) + (HalfHeight - Radius) + 1.0f);
+
+		ATPPPlayerCharacter* Character = TestWorld.SpawnActor<ATPPPlayerCharacter>(SpawnLocation);
+		UTPPMovementComponent* MovementComponent = Character ? Character->GetTPPMovementComponent() : nullptr;
+		if (!MovementComponent)
+		{
+			return -1.0f;
+		}
+
+		const FVector FloorNormal = FRotator(SlopeAngle, 0.0f, 0.0f).RotateVector(FVector::UpVector);
+		MovementComponent->bRunPhysicsWithNoController = true;
+		MovementComponent->Velocity = FVector::VectorPlaneProject(FVector(-1000.0f, 0.0f, 0.0f), FloorNormal);
+		MovementComponent->bWantsToSlide = true;
+		MovementComponent->SetMovementMode(EMovementMode::MOVE_Custom, (uint8)ECustomMovementMode::Sliding);
+
+		const FVector StartLocation = Character->GetActorLocation();
+		const int32 NumFrames = FMath::RoundToInt(FrameRate);
+		const float DeltaTime = 1.0f / FrameRate;
+		for (int32 Frame = 0; Frame < NumFrames && MovementComponent->IsSliding(); ++Frame)
+		{
+			MovementComponent->TickComponent(DeltaTime, LEVELTICK_All, &MovementComponent->PrimaryComponentTick);
+		}
+
+		return MovementComponent->IsSliding() ? (Character->GetActorLocation() - StartLocation).Size() : -1.0f;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTPPSlideFrameRateTest, "ThirdPersonProject.Movement.SlideFrameRateIndependence", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FTPPSlideFrameRateTest::RunTest(const FString& Parameters)
+{
+	FTPPTestWorld TestWorld;
+	if (!TestNotNull(TEXT("World"), TestWorld.Get()))
+	{
+		return false;
+	}
+
+	if (TestTrue(TEXT("Slope spawned"), TPPSlideSolverTests::SpawnSlope(TestWorld)))
+	{
+		// Each frame rate slides its own character in a separate lane so they can't collide.
+		const float Distance30 = TPPSlideSolverTests::SimulateSlideDistance(TestWorld, 30.0f, -1000.0f);
+		const float Distance60 = TPPSlideSolverTests::SimulateSlideDistance(TestWorld, 60.0f, 0.0f);
+		const float Distance240 = TPPSlideSolverTests::SimulateSlideDistance(TestWorld, 240.0f, 1000.0f);
+
+		TestTrue(TEXT("Slide moves and is still sliding after one second"), Distance30 > 0.0f && Distance60 > 0.0f && Distance240 > 0.0f);
+		TestEqual(TEXT("30 Hz slide distance matches 60 Hz"), Distance30, Distance60, 0.5f);
+		TestEqual(TEXT("240 Hz slide distance matches 60 Hz"), Distance240, Distance60, 0.5f);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTPPSlideSteeringTest, "ThirdPersonProject.Movement.SlideSteeringKeepsSpeed", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::EngineFilter)
+
+bool FTPPSlideSteeringTest::RunTest(const FString& Parameters)
+{
+	const FVector Velocity(800.0f, 0.0f, 0.0f);
+	const FVector Steered = UTPPMovementComponent::ComputeSlideVelocity(Velocity, FVector::UpVector, -980.0f, 0.0f, 0.0f, 1400.0f, FVector(0.0f, 1000.0f, 0.0f), 1.0f / 120.0f);
+
+	TestTrue(TEXT("Steering turns the slide"), Steered.Y > 0.0f);
+	TestEqual(TEXT("Steering keeps the slide speed"), Steered.Size(), Velocity.Size(), 0.01f);
+	return true;
+}
+
+#endif
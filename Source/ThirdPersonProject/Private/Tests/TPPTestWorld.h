@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Game world for automation tests that spawn actors. Actors in it never begin play, and the world is destroyed with the fixture. */
+struct FTPPTestWorld
+{
+	FTPPTestWorld() : World(UWorld::CreateWorld(EWorldType::Game, false)) {}
+
+	~FTPPTestWorld()
+	{
+		if (World)
+		{
+			World->DestroyWorld(false);
+		}
+	}
+
+	FTPPTestWorld(const FTPPTestWorld&) = delete;
+	FTPPTestWorld& operator=(const FTPPTestWorld&) = delete;
+
+	UWorld* Get() const { return World; }
+
+	template<class T>
+	T* SpawnActor(const FVector& Location = FVector::ZeroVector) const
+	{
+		return World ? World->SpawnActor<T>(Location, FRotator::ZeroRotator) : nullptr;
+	}
+
+private:
+
+	UWorld* World;
+};
+
+#endif
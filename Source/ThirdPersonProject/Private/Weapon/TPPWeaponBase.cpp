@@ -9,7 +9,16 @@
 #include "Kismet/GameplayStatics.h"
 #include "TPPDamageType.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Debug/TPPLatencySubsystem.h"
+#include "Game/TPPAssetStreamingSubsystem.h"
 #include "Weapon/TPPWeaponBase.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+#include "Debug/TPPStartupProfiler.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dormant Dropped Weapons"), STAT_TPPDormantDroppedWeapons, STATGROUP_ThirdPersonProject);
+
+FOnWeaponOwnerChanged ATPPWeaponBase::OnWeaponOwnerChanged;
 
 // Sets default values
 ATPPWeaponBase::ATPPWeaponBase()
@@ -21,29 +30,86 @@ ATPPWeaponBase::ATPPWeaponBase()
 
 	BaseWeaponDamage = 8.0f;
 	bReplicates = true;
+
+	// Equipped weapons are relevant whenever their character is. Dropped weapons are culled by distance.
+	NetCullDistanceSquared = 25000000.0f;
+}
+
+void ATPPWeaponBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (HasAuthority() && NetDormancy > DORM_Awake)
+	{
+		DEC_DWORD_STAT(STAT_TPPDormantDroppedWeapons);
+	}
+
+	UTPPAssetStreamingSubsystem* StreamingSubsystem = UTPPAssetStreamingSubsystem::Get(this);
+	if (StreamingSubsystem)
+	{
+		StreamingSubsystem->UnregisterProximityPreload(this);
+		StreamingSubsystem->ReleaseAssets(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ATPPWeaponBase::BeginPlay()
 {
+	FTPPScopedStartupTimer StartupTimer(this);
 	Super::BeginPlay();
 	LoadedAmmo = MaxLoadedAmmo;
 	CurrentAmmoPool = MaxAmmoInPool;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPWeaponBase, LoadedAmmo, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPWeaponBase, CurrentAmmoPool, this);
 	SetWeaponReady(true);
+
+	if (FTPPStartupProfiler::ShouldDeferStartupInit())
+	{
+		GetWorldTimerManager().SetTimerForNextTick(this, &ATPPWeaponBase::RegisterProximityPreload);
+	}
+	else
+	{
+		RegisterProximityPreload();
+	}
+}
+
+void ATPPWeaponBase::RegisterProximityPreload()
+{
+	FTPPScopedStartupTimer StartupTimer(TEXT("Weapon Proximity Preload"));
+
+	// Unowned weapons are waiting to be picked up, so stream their assets in as players approach.
+	UTPPAssetStreamingSubsystem* StreamingSubsystem = UTPPAssetStreamingSubsystem::Get(this);
+	if (StreamingSubsystem && !CharacterOwner)
+	{
+		TArray<FSoftObjectPath> StreamedAssets;
+		GetStreamedAssets(StreamedAssets);
+		StreamingSubsystem->RegisterProximityPreload(this, StreamedAssets);
+	}
 }
 
 void ATPPWeaponBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(ATPPWeaponBase, LoadedAmmo);
-	DOREPLIFETIME(ATPPWeaponBase, CurrentAmmoPool);
-	DOREPLIFETIME(ATPPWeaponBase, CharacterOwner);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPWeaponBase, LoadedAmmo, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPWeaponBase, CurrentAmmoPool, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPWeaponBase, CharacterOwner, Params);
 }
 
 void ATPPWeaponBase::ServerEquip_Implementation(ATPPPlayerCharacter* NewWeaponOwner)
 {
 	if (NewWeaponOwner)
 	{
+		// Wake a dropped weapon before its owner and ammo start changing.
+		if (NetDormancy > DORM_Awake)
+		{
+			DEC_DWORD_STAT(STAT_TPPDormantDroppedWeapons);
+			SetNetDormancy(DORM_Awake);
+		}
+
 		CharacterOwner = NewWeaponOwner;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ATPPWeaponBase, CharacterOwner, this);
 		WeaponMesh->SetCollisionProfileName(FName(TEXT("No Collision")));
 		WeaponMesh->SetSimulatePhysics(false);
 
@@ -51,6 +117,7 @@ void ATPPWeaponBase::ServerEquip_Implementation(ATPPPlayerCharacter* NewWeaponOw
 
 		OnRep_CharacterOwner();
 		ClientWeaponEquipped();
+		OnWeaponOwnerChanged.Broadcast(this, CharacterOwner);
 	}
 }
 
@@ -77,6 +144,19 @@ void ATPPWeaponBase::ServerDrop_Implementation(bool bShouldBecomePickup)
 	SetWeaponReady(false);
 
 	PrimaryActorTick.bCanEverTick = false;
+
+	CharacterOwner = nullptr;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPWeaponBase, CharacterOwner, this);
+	OnRep_CharacterOwner();
+
+	// Nothing on a dropped weapon changes until it is picked up again. Pending changes are sent before the channel goes dormant.
+	if (NetDormancy == DORM_Awake)
+	{
+		INC_DWORD_STAT(STAT_TPPDormantDroppedWeapons);
+		SetNetDormancy(DORM_DormantAll);
+	}
+
+	OnWeaponOwnerChanged.Broadcast(this, nullptr);
 }
 
 void ATPPWeaponBase::OnRep_CharacterOwner()
@@ -85,17 +165,46 @@ void ATPPWeaponBase::OnRep_CharacterOwner()
 	{
 		WeaponMesh->SetCollisionProfileName(FName(TEXT("No Collision")));
 		WeaponMesh->SetSimulatePhysics(false);
+
+		// Keep assets loaded for as long as the weapon exists once it has been equipped.
+		UTPPAssetStreamingSubsystem* StreamingSubsystem = UTPPAssetStreamingSubsystem::Get(this);
+		if (StreamingSubsystem)
+		{
+			TArray<FSoftObjectPath> StreamedAssets;
+			GetStreamedAssets(StreamedAssets);
+			StreamingSubsystem->UnregisterProximityPreload(this);
+			StreamingSubsystem->RequestAssets(this, StreamedAssets);
+		}
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Hmm"));
+		// Dropped, so only hold assets while players are near it, like a weapon that was never picked up.
+		UTPPAssetStreamingSubsystem* StreamingSubsystem = UTPPAssetStreamingSubsystem::Get(this);
+		if (StreamingSubsystem)
+		{
+			StreamingSubsystem->ReleaseAssets(this);
+		}
+		RegisterProximityPreload();
 	}
 }
 
+void ATPPWeaponBase::GetStreamedAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+#if TPP_WITH_COSMETICS
+	OutAssets.Add(ImpactProperties.WeaponHitMaterial.ToSoftObjectPath());
+	OutAssets.Add(WeaponFireSound.ToSoftObjectPath());
+	OutAssets.Add(HUDImage.ToSoftObjectPath());
+#endif
+}
+
 void ATPPWeaponBase::ServerModifyWeaponAmmo_Implementation(const int32 ChamberAmmoChange, const int32 PooledAmmoChange)
 {
+	FlushNetDormancy();
+
 	LoadedAmmo = FMath::Clamp(LoadedAmmo + ChamberAmmoChange, 0, MaxLoadedAmmo);
 	CurrentAmmoPool = FMath::Clamp(CurrentAmmoPool + PooledAmmoChange, 0, MaxAmmoInPool);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPWeaponBase, LoadedAmmo, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPWeaponBase, CurrentAmmoPool, this);
 
 	OnRep_AmmoCount();
 }
@@ -160,9 +269,16 @@ void ATPPWeaponBase::InterruptReload()
 
 }
 
-void ATPPWeaponBase::OnWeaponHit_Implementation(const FHitResult& HitResult, const float DamageApplied)
+void ATPPWeaponBase::OnWeaponHit_Implementation(const FHitResult& HitResult, const float DamageApplied, uint16 ShotSequenceId)
 {
-	if (DamageApplied > 0.0f)
+	UTPPLatencySubsystem* LatencySubsystem = UTPPLatencySubsystem::Get(this);
+	if (LatencySubsystem)
+	{
+		LatencySubsystem->MarkStage(CharacterOwner, ETPPLatencyTrace::Shot, ShotSequenceId, ETPPLatencyStage::ClientWeaponHit);
+		LatencySubsystem->EndSequence(CharacterOwner, ETPPLatencyTrace::Shot, ShotSequenceId);
+	}
+
+	if (DamageApplied > 0.0f && CharacterOwner)
 	{
 		ATPPHUD* TPPHUD = CharacterOwner->GetCharacterHUD();
 		if (TPPHUD)
@@ -172,7 +288,7 @@ void ATPPWeaponBase::OnWeaponHit_Implementation(const FHitResult& HitResult, con
 	}
 }
 
-void ATPPWeaponBase::ApplyWeaponPointDamage_Implementation(const FHitResult& HitResult, const FVector& StartingLocation)
+void ATPPWeaponBase::ApplyWeaponPointDamage_Implementation(const FHitResult& HitResult, const FVector& StartingLocation, uint16 ShotSequenceId)
 {
 	if (HitResult.bBlockingHit && HitResult.Component != nullptr && CharacterOwner)
 	{
@@ -186,28 +302,33 @@ void ATPPWeaponBase::ApplyWeaponPointDamage_Implementation(const FHitResult& Hit
 				BaseDamage *= DamageType->DamageHeadshotMultiplier;
 			}
 			const float DamageApplied = UGameplayStatics::ApplyPointDamage(CharacterHit, BaseDamage, StartingLocation.GetSafeNormal(), HitResult, CharacterOwner->GetController(), CharacterOwner, HitDamageClass);
-			OnWeaponHit(HitResult, DamageApplied);
+			OnWeaponHit(HitResult, DamageApplied, ShotSequenceId);
 		}
 	}
 }
 
 void ATPPWeaponBase::SpawnWeaponImpactDecal(const FHitResult& ImpactResult)
 {
+#if TPP_WITH_COSMETICS
 	UPrimitiveComponent* PrimitiveComp = ImpactResult.Component.Get();
-	UDecalComponent* SpawnedDecal = UTPPBlueprintFunctionLibrary::SpawnDecalWithParameters(PrimitiveComp, ImpactProperties.WeaponHitMaterial, 10.0f, ImpactResult.ImpactPoint, ImpactResult.ImpactNormal.Rotation(), ImpactProperties.WeaponHitDecalSize);
+	UDecalComponent* SpawnedDecal = UTPPBlueprintFunctionLibrary::SpawnDecalWithParameters(PrimitiveComp, UTPPAssetStreamingSubsystem::GetLoadedAsset(ImpactProperties.WeaponHitMaterial), 10.0f, ImpactResult.ImpactPoint, ImpactResult.ImpactNormal.Rotation(), ImpactProperties.WeaponHitDecalSize);
 	if (SpawnedDecal)
 	{
 		SpawnedDecal->Activate();
 	}
+#endif
 }
 
 void ATPPWeaponBase::PlayWeaponFireSound_Implementation()
 {
-	if (WeaponFireSound)
+#if TPP_WITH_COSMETICS
+	USoundWave* FireSound = UTPPAssetStreamingSubsystem::GetLoadedAsset(WeaponFireSound);
+	if (FireSound)
 	{
-		AudioComponent->SetSound(WeaponFireSound);
+		AudioComponent->SetSound(FireSound);
 		AudioComponent->Play();
 	}
+#endif
 }
 
 void ATPPWeaponBase::ApplyWeaponBlastDamage(const FVector& BlastCenter)
@@ -13,6 +13,9 @@
 #include "Particles/ParticleSystemComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Debug/TPPLatencySubsystem.h"
+#include "Game/TPPAssetStreamingSubsystem.h"
 
 ATPPWeaponFirearm::ATPPWeaponFirearm()
 {
@@ -33,17 +36,23 @@ void ATPPWeaponFirearm::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	UpdateWeaponSpreadRadius();
+	if (!CharacterOwner || CharacterOwner->GetSignificanceTierSettings().bUpdateWeaponSpread)
+	{
+		UpdateWeaponSpreadRadius();
+	}
 }
 
 void ATPPWeaponFirearm::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(ATPPWeaponFirearm, CurrentFiringMode);
-	DOREPLIFETIME(ATPPWeaponFirearm, TimeSinceLastShot);
-	DOREPLIFETIME(ATPPWeaponFirearm, BurstCount);
-	DOREPLIFETIME(ATPPWeaponFirearm, CurrentWeaponSpreadAngle);
-	DOREPLIFETIME(ATPPWeaponFirearm, WeaponRecoilResetTimer);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPWeaponFirearm, CurrentFiringMode, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPWeaponFirearm, TimeSinceLastShot, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPWeaponFirearm, BurstCount, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPWeaponFirearm, CurrentWeaponSpreadAngle, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPWeaponFirearm, WeaponRecoilResetTimer, Params);
 }
 
 void ATPPWeaponFirearm::UpdateWeaponSpreadRadius()
@@ -80,7 +89,21 @@ void ATPPWeaponFirearm::UpdateWeaponSpreadRadius()
 		SpreadRadius *= ADSAimMultiplier;
 	}
 
+	const float PreviousSpreadAngle = CurrentWeaponSpreadAngle;
 	CurrentWeaponSpreadAngle = FMath::Min(SpreadRadius, AimProperties->InaccuracySpreadMaxAngle);
+	if (CurrentWeaponSpreadAngle != PreviousSpreadAngle)
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(ATPPWeaponFirearm, CurrentWeaponSpreadAngle, this);
+	}
+
+	// Observers only redraw on notable changes, plus once when spread stops changing so they show the exact value.
+	const bool bPassedThreshold = FMath::Abs(CurrentWeaponSpreadAngle - LastNotifiedSpreadAngle) >= SpreadChangeNotifyThreshold;
+	const bool bSettled = CurrentWeaponSpreadAngle == PreviousSpreadAngle && CurrentWeaponSpreadAngle != LastNotifiedSpreadAngle;
+	if (bPassedThreshold || bSettled)
+	{
+		LastNotifiedSpreadAngle = CurrentWeaponSpreadAngle;
+		OnWeaponSpreadChanged.Broadcast(CurrentWeaponSpreadAngle);
+	}
 }
 
 void ATPPWeaponFirearm::ModifyAimVectorFromSpread(FVector& AimingVector)
@@ -127,11 +150,24 @@ void ATPPWeaponFirearm::FireWeapon_Implementation()
 	}
 }
 
+void ATPPWeaponFirearm::GetStreamedAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	Super::GetStreamedAssets(OutAssets);
+
+	OutAssets.Add(WeaponFireCharacterMontage.ToSoftObjectPath());
+	OutAssets.Add(WeaponFireADSCharacterMontage.ToSoftObjectPath());
+	OutAssets.Add(WeaponReloadCharacterMontage.ToSoftObjectPath());
+#if TPP_WITH_COSMETICS
+	OutAssets.Add(WeaponTrailEffect.ToSoftObjectPath());
+#endif
+}
+
 bool ATPPWeaponFirearm::ShouldUseWeaponIk_Implementation() const
 {
 	UAnimInstance* AnimInstance = CharacterOwner ? CharacterOwner->GetMesh()->GetAnimInstance() : nullptr;
-	const bool bIsPlayingReloadAnim = AnimInstance && AnimInstance->Montage_IsPlaying(WeaponReloadCharacterMontage);
-	return bShouldUseLeftHandIK && bIsWeaponReady && AnimInstance && !bIsPlayingReloadAnim && CharacterOwner->GetCurrentAnimationBlendSlot() != EAnimationBlendSlot::FullBody;
+	const UAnimMontage* ReloadMontage = WeaponReloadCharacterMontage.Get();
+	const bool bIsPlayingReloadAnim = AnimInstance && ReloadMontage && AnimInstance->Montage_IsPlaying(ReloadMontage);
+	return bShouldUseLeftHandIK && bIsWeaponReady && AnimInstance && CharacterOwner->GetSignificanceTierSettings().bUseWeaponIK && !bIsPlayingReloadAnim && CharacterOwner->GetCurrentAnimationBlendSlot() != EAnimationBlendSlot::FullBody;
 }
 
 FRotator ATPPWeaponFirearm::CalculateRecoil() const
@@ -177,7 +213,7 @@ void ATPPWeaponFirearm::HitscanFire()
 	}
 
 	const bool bIsAiming = CharacterOwner->IsPlayerAiming();
-	UAnimMontage* MontageToPlay = bIsAiming ? WeaponFireADSCharacterMontage : WeaponFireCharacterMontage;
+	UAnimMontage* MontageToPlay = UTPPAssetStreamingSubsystem::GetLoadedAsset(bIsAiming ? WeaponFireADSCharacterMontage : WeaponFireCharacterMontage);
 	if (MontageToPlay)
 	{
 		CharacterOwner->SetAnimationBlendSlot(EAnimationBlendSlot::UpperBody);
@@ -196,6 +232,9 @@ void ATPPWeaponFirearm::HitscanFire()
 
 	GetWorldTimerManager().ClearTimer(WeaponRecoilResetTimer);
 	GetWorldTimerManager().SetTimer(WeaponRecoilResetTimer, this, &ATPPWeaponFirearm::OnWeaponRecoilReset, .15f, false);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPWeaponFirearm, BurstCount, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPWeaponFirearm, TimeSinceLastShot, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPWeaponFirearm, WeaponRecoilResetTimer, this);
 
 	FVector StartingLocation;
 	FVector EndLocation;
@@ -212,21 +251,37 @@ void ATPPWeaponFirearm::HitscanFire()
 
 	World->LineTraceMultiByChannel(TraceResults, StartingLocation, EndLocation, ECollisionChannel::ECC_GameTraceChannel1, QueryParams);
 	const FHitResult HitResultToUse = TraceResults.Num() > 0 ? TraceResults[0] : FHitResult();
-	ServerHitscanFire(HitResultToUse);
+
+	uint16 ShotSequenceId = 0;
+	UTPPLatencySubsystem* LatencySubsystem = UTPPLatencySubsystem::Get(this);
+	if (LatencySubsystem)
+	{
+		ShotSequenceId = LatencySubsystem->BeginSequence(CharacterOwner, ETPPLatencyTrace::Shot, PlayerController->GetLastFireInputTime());
+		LatencySubsystem->MarkStage(CharacterOwner, ETPPLatencyTrace::Shot, ShotSequenceId, ETPPLatencyStage::HitscanFire);
+	}
+	ServerHitscanFire(HitResultToUse, ShotSequenceId);
 
 	//DrawDebugSphere(World, HitTrace.Location, 15.f, 2, FColor::Green, false, 3.5f, 0, 1.5f);
 
+#if TPP_WITH_COSMETICS
 	const FVector ParticleTrailEndLocation = HitResultToUse.Actor.IsValid() ? HitResultToUse.ImpactPoint : EndLocation;
 	const FVector MuzzleLocation = WeaponMesh->GetSocketLocation("Muzzle");
-	UParticleSystemComponent* ParticleSystemComp = UGameplayStatics::SpawnEmitterAtLocation(World, WeaponTrailEffect, MuzzleLocation);
+	UParticleSystemComponent* ParticleSystemComp = UGameplayStatics::SpawnEmitterAtLocation(World, UTPPAssetStreamingSubsystem::GetLoadedAsset(WeaponTrailEffect), MuzzleLocation);
 	if (ParticleSystemComp)
 	{
 		ParticleSystemComp->SetVectorParameter(TrailTargetParam, ParticleTrailEndLocation);
 	}
+#endif
 }
 
-void ATPPWeaponFirearm::ServerHitscanFire_Implementation(const FHitResult& ClientHitResult)
+void ATPPWeaponFirearm::ServerHitscanFire_Implementation(const FHitResult& ClientHitResult, uint16 ShotSequenceId)
 {
+	UTPPLatencySubsystem* LatencySubsystem = UTPPLatencySubsystem::Get(this);
+	if (LatencySubsystem)
+	{
+		LatencySubsystem->MarkStage(CharacterOwner, ETPPLatencyTrace::Shot, ShotSequenceId, ETPPLatencyStage::ServerHitscanFire);
+	}
+
 	UWorld* World = GetWorld();
 	const UTPPGameInstance* GameInstance = UTPPGameInstance::Get();
 	const UTPPAimProperties* AimProperties = GameInstance ? GameInstance->GetAimProperties() : nullptr;
@@ -240,6 +295,7 @@ void ATPPWeaponFirearm::ServerHitscanFire_Implementation(const FHitResult& Clien
 
 	BurstCount -= (int32)((World->GetTimeSeconds() - TimeSinceLastShot) / BurstRecoveryTime);
 	BurstCount = FMath::Max(BurstCount, 0);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPWeaponFirearm, BurstCount, this);
 
 	/* TODO: Lag compensation
 
@@ -270,17 +326,23 @@ void ATPPWeaponFirearm::ServerHitscanFire_Implementation(const FHitResult& Clien
 	*/
 
 	ClientHitscanFired(ClientHitResult);
-	ApplyWeaponPointDamage(ClientHitResult, ClientHitResult.TraceStart);
+	ApplyWeaponPointDamage(ClientHitResult, ClientHitResult.TraceStart, ShotSequenceId);
 }
 
 void ATPPWeaponFirearm::ClientHitscanFired_Implementation(const FHitResult& ClientHitResult)
 {
+#if TPP_WITH_COSMETICS
 	const ENetRole NetRole = CharacterOwner ? CharacterOwner->GetLocalRole() : ENetRole::ROLE_None;
+	if (CharacterOwner && !CharacterOwner->GetSignificanceTierSettings().bSpawnCosmetics)
+	{
+		return;
+	}
+
 	if (NetRole == ENetRole::ROLE_SimulatedProxy)
 	{
 		const FVector ParticleTrailEndLocation = ClientHitResult.Actor.IsValid() ? ClientHitResult.ImpactPoint : ClientHitResult.TraceEnd;
 		const FVector MuzzleLocation = WeaponMesh->GetSocketLocation("Muzzle");
-		UParticleSystemComponent* ParticleSystemComp = UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), WeaponTrailEffect, MuzzleLocation);
+		UParticleSystemComponent* ParticleSystemComp = UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), UTPPAssetStreamingSubsystem::GetLoadedAsset(WeaponTrailEffect), MuzzleLocation);
 		if (ParticleSystemComp)
 		{
 			ParticleSystemComp->SetVectorParameter(TrailTargetParam, ParticleTrailEndLocation);
@@ -292,6 +354,7 @@ void ATPPWeaponFirearm::ClientHitscanFired_Implementation(const FHitResult& Clie
 	{
 		SpawnWeaponImpactDecal(ClientHitResult);
 	}
+#endif
 }
 
 void ATPPWeaponFirearm::ProjectileFire()
@@ -301,13 +364,14 @@ void ATPPWeaponFirearm::ProjectileFire()
 
 void ATPPWeaponFirearm::StartWeaponReload()
 {
-	if (CharacterOwner && WeaponFireCharacterMontage)
+	if (CharacterOwner && !WeaponFireCharacterMontage.IsNull())
 	{
 		const UAnimInstance* AnimInstance = CharacterOwner->GetMesh()->GetAnimInstance();
-		if (WeaponReloadCharacterMontage && !AnimInstance->Montage_IsPlaying(WeaponReloadCharacterMontage))
+		UAnimMontage* ReloadMontage = UTPPAssetStreamingSubsystem::GetLoadedAsset(WeaponReloadCharacterMontage);
+		if (ReloadMontage && !AnimInstance->Montage_IsPlaying(ReloadMontage))
 		{
 			CharacterOwner->SetAnimationBlendSlot(EAnimationBlendSlot::UpperBody);
-			CharacterOwner->PlayAnimMontage(WeaponReloadCharacterMontage);
+			CharacterOwner->PlayAnimMontage(ReloadMontage);
 		}
 	}
 }
@@ -322,9 +386,10 @@ void ATPPWeaponFirearm::InterruptReload()
 {
 	USkeletalMeshComponent* SkeletalMeshComp = CharacterOwner ? CharacterOwner->GetMesh() : nullptr;
 	const UAnimInstance* AnimInstance = SkeletalMeshComp ? SkeletalMeshComp->GetAnimInstance() : nullptr;
-	if (AnimInstance && WeaponReloadCharacterMontage && AnimInstance->Montage_IsPlaying(WeaponReloadCharacterMontage))
+	UAnimMontage* ReloadMontage = WeaponReloadCharacterMontage.Get();
+	if (AnimInstance && ReloadMontage && AnimInstance->Montage_IsPlaying(ReloadMontage))
 	{
-		CharacterOwner->StopAnimMontage(WeaponReloadCharacterMontage);
+		CharacterOwner->StopAnimMontage(ReloadMontage);
 	}
 }
 
@@ -2,10 +2,17 @@
 
 
 #include "Widgets/TPPCrosshairWidget.h"
+#include "Weapon/TPPWeaponFirearm.h"
+#include "Rendering/DrawElements.h"
+#include "TimerManager.h"
+#include "ThirdPersonProject/ThirdPersonProject.h"
+
+DECLARE_CYCLE_STAT(TEXT("Crosshair Paint"), STAT_TPPCrosshairPaint, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crosshair Invalidations"), STAT_TPPCrosshairInvalidations, STATGROUP_ThirdPersonProject);
 
 void UTPPCrosshairWidget::SetObservedWeapon(ATPPWeaponBase* WeaponToObserve)
 {
-	if (WeaponToObserve && WeaponToObserve != ObservedWeapon)
+	if (ObservedWeapon && ObservedWeapon != WeaponToObserve)
 	{
 		RemoveWeaponDelegates(ObservedWeapon);
 	}
@@ -13,9 +20,83 @@ void UTPPCrosshairWidget::SetObservedWeapon(ATPPWeaponBase* WeaponToObserve)
 	ObservedWeapon = WeaponToObserve;
 	AssignWeaponDelegates(ObservedWeapon);
 
+	const ATPPWeaponFirearm* Firearm = Cast<ATPPWeaponFirearm>(ObservedWeapon);
+	CachedSpreadAngle = Firearm ? Firearm->GetWeaponSpreadAngle() : 0.0f;
+	Invalidate(EInvalidateWidgetReason::Paint);
+
 	OnWeaponChanged();
 }
 
+int32 UTPPCrosshairWidget::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	LayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	SCOPE_CYCLE_COUNTER(STAT_TPPCrosshairPaint);
+
+	if (!ObservedWeapon)
+	{
+		return LayerId;
+	}
+
+	++LayerId;
+	UpdateCrosshairLines(AllottedGeometry.GetLocalSize());
+
+	const FPaintGeometry PaintGeometry = AllottedGeometry.ToPaintGeometry();
+	const FLinearColor LineColor = CrosshairColor * InWidgetStyle.GetColorAndOpacityTint();
+	const int32 NumLines = bShowHitMarker ? CachedCrosshairLines.Num() / 2 : 4;
+	for (int32 i = 0; i < NumLines; ++i)
+	{
+		const TArray<FVector2D> LinePoints = { CachedCrosshairLines[i * 2], CachedCrosshairLines[i * 2 + 1] };
+		FSlateDrawElement::MakeLines(OutDrawElements, LayerId, PaintGeometry, LinePoints, ESlateDrawEffect::None, i < 4 ? LineColor : HitMarkerColor * InWidgetStyle.GetColorAndOpacityTint(), true, CrosshairLineThickness);
+	}
+
+	return LayerId;
+}
+
+void UTPPCrosshairWidget::NativeDestruct()
+{
+	RemoveWeaponDelegates(ObservedWeapon);
+
+	const UWorld* World = GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(HitMarkerTimerHandle);
+	}
+
+	Super::NativeDestruct();
+}
+
+void UTPPCrosshairWidget::UpdateCrosshairLines(const FVector2D& LocalSize) const
+{
+	if (CachedLinesSpreadAngle == CachedSpreadAngle && CachedLinesSize == LocalSize && CachedCrosshairLines.Num() > 0)
+	{
+		return;
+	}
+
+	CachedLinesSpreadAngle = CachedSpreadAngle;
+	CachedLinesSize = LocalSize;
+
+	const FVector2D Center = LocalSize * .5f;
+	const float InnerOffset = CrosshairMinGap + CachedSpreadAngle * CrosshairGapPerSpreadDegree;
+	const float OuterOffset = InnerOffset + CrosshairLineLength;
+	const FVector2D Directions[] = { FVector2D(1.0f, 0.0f), FVector2D(-1.0f, 0.0f), FVector2D(0.0f, 1.0f), FVector2D(0.0f, -1.0f) };
+
+	CachedCrosshairLines.Reset(16);
+	for (const FVector2D& Direction : Directions)
+	{
+		CachedCrosshairLines.Add(Center + Direction * InnerOffset);
+		CachedCrosshairLines.Add(Center + Direction * OuterOffset);
+	}
+
+	// Hit marker diagonals, only drawn while a hit is shown
+	const FVector2D Diagonals[] = { FVector2D(1.0f, 1.0f), FVector2D(-1.0f, 1.0f), FVector2D(1.0f, -1.0f), FVector2D(-1.0f, -1.0f) };
+	for (const FVector2D& Diagonal : Diagonals)
+	{
+		CachedCrosshairLines.Add(Center + Diagonal * HitMarkerSize * .5f);
+		CachedCrosshairLines.Add(Center + Diagonal * HitMarkerSize);
+	}
+}
+
 void UTPPCrosshairWidget::OnWeaponFired_Implementation()
 {
 }
@@ -27,14 +108,44 @@ void UTPPCrosshairWidget::OnWeaponReloaded_Implementation()
 
 void UTPPCrosshairWidget::OnWeaponHit_Implementation(const FHitResult& HitResult, const float DamageApplied)
 {
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
 
+	bShowHitMarker = true;
+	World->GetTimerManager().SetTimer(HitMarkerTimerHandle, this, &UTPPCrosshairWidget::HideHitMarker, HitMarkerDuration);
+
+	INC_DWORD_STAT(STAT_TPPCrosshairInvalidations);
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void UTPPCrosshairWidget::OnWeaponSpreadChanged(float SpreadAngle)
+{
+	CachedSpreadAngle = SpreadAngle;
+
+	INC_DWORD_STAT(STAT_TPPCrosshairInvalidations);
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void UTPPCrosshairWidget::HideHitMarker()
+{
+	bShowHitMarker = false;
+	Invalidate(EInvalidateWidgetReason::Paint);
 }
 
 void UTPPCrosshairWidget::AssignWeaponDelegates(ATPPWeaponBase* Weapon)
 {
 	if (Weapon)
 	{
-		Weapon->OnWeaponFired.AddDynamic(this, &UTPPCrosshairWidget::OnWeaponFired);
+		Weapon->OnWeaponFired.AddUniqueDynamic(this, &UTPPCrosshairWidget::OnWeaponFired);
+
+		ATPPWeaponFirearm* Firearm = Cast<ATPPWeaponFirearm>(Weapon);
+		if (Firearm)
+		{
+			Firearm->OnWeaponSpreadChanged.AddUniqueDynamic(this, &UTPPCrosshairWidget::OnWeaponSpreadChanged);
+		}
 	}
 }
 
@@ -43,5 +154,11 @@ void UTPPCrosshairWidget::RemoveWeaponDelegates(ATPPWeaponBase* Weapon)
 	if (Weapon)
 	{
 		Weapon->OnWeaponFired.RemoveDynamic(this, &UTPPCrosshairWidget::OnWeaponFired);
+
+		ATPPWeaponFirearm* Firearm = Cast<ATPPWeaponFirearm>(Weapon);
+		if (Firearm)
+		{
+			Firearm->OnWeaponSpreadChanged.RemoveDynamic(this, &UTPPCrosshairWidget::OnWeaponSpreadChanged);
+		}
 	}
-}
\ No newline at end of file
+}
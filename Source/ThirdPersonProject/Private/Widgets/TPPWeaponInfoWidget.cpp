@@ -13,16 +13,36 @@ void UTPPWeaponInfoWidget::SetObservedWeapon(ATPPWeaponBase* WeaponToObserve)
 	ObservedWeapon = WeaponToObserve;
 	AssignWeaponDelegates(ObservedWeapon);
 	OnWeaponChanged();
+	RefreshAmmo();
 }
 
-void UTPPWeaponInfoWidget::OnWeaponFired_Implementation()
+void UTPPWeaponInfoWidget::RefreshAmmo()
+{
+	const int32 LoadedAmmo = ObservedWeapon ? ObservedWeapon->GetLoadedAmmoCount() : 0;
+	const int32 PooledAmmo = ObservedWeapon ? ObservedWeapon->GetCurrentPooledAmmo() : 0;
+	if (LoadedAmmo != CachedLoadedAmmo || PooledAmmo != CachedPooledAmmo)
+	{
+		CachedLoadedAmmo = LoadedAmmo;
+		CachedPooledAmmo = PooledAmmo;
+		OnAmmoChanged();
+	}
+}
+
+void UTPPWeaponInfoWidget::NativeDestruct()
 {
+	RemoveWeaponDelegates(ObservedWeapon);
 
+	Super::NativeDestruct();
 }
 
-void UTPPWeaponInfoWidget::OnWeaponReloaded_Implementation()
+void UTPPWeaponInfoWidget::OnWeaponFired_Implementation()
 {
+	RefreshAmmo();
+}
 
+void UTPPWeaponInfoWidget::OnWeaponReloaded_Implementation()
+{
+	RefreshAmmo();
 }
 
 void UTPPWeaponInfoWidget::OnWeaponHit_Implementation(const FHitResult& HitResult, const float DamageApplied)
@@ -34,8 +54,8 @@ void UTPPWeaponInfoWidget::AssignWeaponDelegates(ATPPWeaponBase* Weapon)
 {
 	if (Weapon)
 	{
-		Weapon->OnWeaponFired.AddDynamic(this, &UTPPWeaponInfoWidget::OnWeaponFired);
-		Weapon->OnWeaponAmmoUpdated.AddDynamic(this, &UTPPWeaponInfoWidget::OnWeaponReloaded);
+		Weapon->OnWeaponFired.AddUniqueDynamic(this, &UTPPWeaponInfoWidget::OnWeaponFired);
+		Weapon->OnWeaponAmmoUpdated.AddUniqueDynamic(this, &UTPPWeaponInfoWidget::OnWeaponReloaded);
 	}
 }
 
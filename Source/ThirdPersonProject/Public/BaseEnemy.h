@@ -4,10 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Interfaces/TPPSignificanceInterface.h"
 #include "BaseEnemy.generated.h"
 
 UCLASS()
-class THIRDPERSONPROJECT_API ABaseEnemy : public AActor
+class THIRDPERSONPROJECT_API ABaseEnemy : public AActor, public ITPPSignificanceInterface
 {
 	GENERATED_BODY()
 	
@@ -25,10 +26,17 @@ public:
 	UFUNCTION(BlueprintCallable)
 	virtual FVector GetLockOnLocation();
 
+	virtual void OnSignificanceTierChanged(ETPPSignificanceTier NewTier, const FTPPSignificanceTierSettings& TierSettings) override;
+
+	/** Enemies replicate their movement from the server, so a listen server host must keep them at full rate whatever it can see */
+	virtual bool IsAlwaysSignificant() const override { return HasAuthority() && GetNetMode() != NM_Standalone; }
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UPROPERTY(EditAnywhere, Category = "Movement")
 	float Amplitude;
 
@@ -38,7 +46,8 @@ protected:
 
 private:
 
-	UPROPERTY(VisibleAnywhere)
+	/** If set, the player's aim snaps to this enemy when aiming starts with it near the crosshair */
+	UPROPERTY(EditAnywhere)
 	bool bCanBeLockedOnto;
 
 	FVector StartingPosition;
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TPPInputRecording.generated.h"
+
+/** Single frame of recorded player controller input along with the resulting pawn state */
+USTRUCT()
+struct FTPPRecordedInputFrame
+{
+	GENERATED_BODY()
+
+	/** Delta time the frame was processed with */
+	UPROPERTY()
+	float DeltaTime = 0.0f;
+
+	UPROPERTY()
+	float MoveForwardValue = 0.0f;
+
+	UPROPERTY()
+	float MoveRightValue = 0.0f;
+
+	UPROPERTY()
+	float FireWeaponAxisValue = 0.0f;
+
+	/** Control rotation after rotation input was applied */
+	UPROPERTY()
+	FRotator ControlRotation = FRotator::ZeroRotator;
+
+	/** Bitmask of EPlayerInputAction values pressed this frame */
+	UPROPERTY()
+	uint8 PressedActions = 0;
+
+	/** Bitmask of EPlayerInputAction values released this frame */
+	UPROPERTY()
+	uint8 ReleasedActions = 0;
+
+	/** Pawn location after movement for this frame was applied */
+	UPROPERTY()
+	FVector PawnLocation = FVector::ZeroVector;
+
+	/** Pawn velocity after movement for this frame was applied */
+	UPROPERTY()
+	FVector PawnVelocity = FVector::ZeroVector;
+};
+
+/** Recorded input for a single play session. Serialized to a compact binary file that only stores input fields when they change. */
+USTRUCT()
+struct FTPPInputRecording
+{
+	GENERATED_BODY()
+
+	/** Map the recording was made on */
+	UPROPERTY()
+	FString MapName;
+
+	UPROPERTY()
+	FVector StartLocation = FVector::ZeroVector;
+
+	UPROPERTY()
+	FRotator StartRotation = FRotator::ZeroRotator;
+
+	UPROPERTY()
+	TArray<FTPPRecordedInputFrame> Frames;
+
+	void Reset();
+
+	bool SaveToFile(const FString& Filename) const;
+
+	bool LoadFromFile(const FString& Filename);
+
+	/** Returns the full path for a recording. Relative names are placed in the saved input recordings directory. */
+	static FString GetRecordingPath(const FString& Filename);
+
+	friend FArchive& operator<<(FArchive& Ar, FTPPInputRecording& Recording);
+};
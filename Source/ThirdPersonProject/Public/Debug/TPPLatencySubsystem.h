@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TPPLatencySubsystem.generated.h"
+
+/** Enum detailing the chains of events whose latency is traced */
+UENUM()
+enum class ETPPLatencyTrace : uint8
+{
+	/** Fire input to a server validated hit */
+	Shot,
+	/** Jump or ability input to the resulting movement */
+	Movement,
+	MAX UMETA(Hidden)
+};
+
+/** Enum detailing the points at which a traced sequence is timestamped */
+UENUM()
+enum class ETPPLatencyStage : uint8
+{
+	HitscanFire,
+	ServerHitscanFire,
+	ClientWeaponHit,
+	SpecialMoveBegin,
+	MovementModeChanged,
+	MAX UMETA(Hidden)
+};
+
+/** Fixed bucket histogram of latencies in milliseconds */
+struct FTPPLatencyHistogram
+{
+	static constexpr int32 NumBuckets = 12;
+
+	/** Upper bound of each bucket except the last, which is unbounded */
+	static const float BucketLimits[NumBuckets - 1];
+
+	TStaticArray<uint32, NumBuckets> BucketCounts;
+
+	uint32 NumSamples = 0;
+
+	float MinLatency = 0.0f;
+
+	float MaxLatency = 0.0f;
+
+	double TotalLatency = 0.0;
+
+	FTPPLatencyHistogram();
+
+	void AddSample(float LatencyMs);
+
+	void Reset();
+
+	/** Returns the upper bound of the bucket containing the given percentile */
+	float GetPercentileUpperBound(float Percentile) const;
+
+	FString ToString() const;
+};
+
+/** Sequence in flight, waiting on its later stages */
+struct FTPPLatencySequence
+{
+	TWeakObjectPtr<const UObject> Owner;
+
+	ETPPLatencyTrace Trace = ETPPLatencyTrace::MAX;
+
+	uint16 SequenceId = 0;
+
+	/** Platform time of the first stage seen on this machine */
+	double StartTime = 0.0;
+};
+
+/**
+ * Measures how long input takes to become a result, correlating stages by a sequence ID that is sent along with the RPCs involved.
+ * Stages are measured from the first point of the sequence this machine saw, so clients measure from input and dedicated servers from the first server RPC.
+ * Latencies are written to the CSV profile as they are recorded, and the histograms can be printed with TPPDumpLatency.
+ * Not created in shipping builds.
+ */
+UCLASS()
+class THIRDPERSONPROJECT_API UTPPLatencySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	static UTPPLatencySubsystem* Get(const UObject* WorldContextObject);
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/** Starts a sequence whose first stage happened at the given platform time. Returns its ID. */
+	uint16 BeginSequence(const UObject* Owner, ETPPLatencyTrace Trace, double StartTime);
+
+	/** Records the time from the start of the sequence to this stage. Starts the sequence instead if this machine hasn't seen it. */
+	void MarkStage(const UObject* Owner, ETPPLatencyTrace Trace, uint16 SequenceId, ETPPLatencyStage Stage);
+
+	/** Records the stage for the latest open sequence of the trace, if any. Used for stages that don't know their sequence ID. */
+	void MarkLatestStage(const UObject* Owner, ETPPLatencyTrace Trace, ETPPLatencyStage Stage, bool bEndSequence = false);
+
+	/** Stops tracking a sequence once it has no more stages */
+	void EndSequence(const UObject* Owner, ETPPLatencyTrace Trace, uint16 SequenceId);
+
+	/** Logs every stage histogram and adds them to the CSV profile metadata */
+	void DumpHistograms() const;
+
+	void ResetHistograms();
+
+protected:
+
+	static constexpr int32 MaxOpenSequences = 32;
+
+	/** Sequences older than this are dropped, such as shots that never hit anything */
+	static constexpr double MaxSequenceAge = 2.0;
+
+	TStaticArray<FTPPLatencySequence, MaxOpenSequences> OpenSequences;
+
+	/** Slot the next sequence is written to. Sequences are overwritten oldest first. */
+	int32 NextSequenceSlot = 0;
+
+	uint16 LastSequenceId = 0;
+
+	TStaticArray<FTPPLatencyHistogram, (uint32)ETPPLatencyStage::MAX> StageHistograms;
+
+	FTPPLatencySequence* FindSequence(const UObject* Owner, ETPPLatencyTrace Trace, uint16 SequenceId);
+
+	FTPPLatencySequence& AddSequence(const UObject* Owner, ETPPLatencyTrace Trace, uint16 SequenceId, double StartTime);
+};
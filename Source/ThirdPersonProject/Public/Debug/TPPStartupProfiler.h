@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/** Time recorded for one startup step */
+struct FTPPStartupEntry
+{
+	double TotalSeconds = 0.0;
+
+	int32 Count = 0;
+};
+
+/**
+ * Records where startup time goes when the game is launched with -TPPProfileStartup.
+ * Covers engine pre-init, game instance init, map load, BeginPlay per actor class and the first two frames after the map loads.
+ * A report ranked by time is logged and written to the profiling directory once the second frame ends, after work deferred with SetTimerForNextTick has run.
+ * The report also lists resident memory after map load and at the end of the second frame, to compare asset loading changes.
+ */
+class THIRDPERSONPROJECT_API FTPPStartupProfiler
+{
+public:
+
+	static FTPPStartupProfiler& Get();
+
+	/** Starts recording if profiling was requested on the command line. Called when the game module loads. */
+	void Initialize();
+
+	void Shutdown();
+
+	bool IsRecording() const { return bIsRecording; }
+
+	void AddTime(const FString& Name, double Seconds);
+
+	/** True if non-critical initialisation such as HUD widgets and asset streaming should wait until after the first frame */
+	static bool ShouldDeferStartupInit();
+
+private:
+
+	bool bIsRecording = false;
+
+	TMap<FString, FTPPStartupEntry> Entries;
+
+	FString LoadingMapName;
+
+	double MapLoadStartTime = 0.0;
+
+	/** Time the first map finished loading, or 0 before then */
+	double FirstFrameStartTime = 0.0;
+
+	/** Time the last recorded frame after map load ended */
+	double LastFrameEndTime = 0.0;
+
+	/** Frames ended since the first map finished loading */
+	int32 NumFramesSinceMapLoad = 0;
+
+	/** Physical memory in use once the first map finished loading */
+	uint64 MapLoadUsedPhysical = 0;
+
+	void OnPreLoadMap(const FString& MapName);
+
+	void OnPostLoadMap(UWorld* LoadedWorld);
+
+	void OnEndFrame();
+
+	/** Frames recorded after map load before reporting, enough for deferred startup work to have run */
+	static constexpr int32 NumFramesToRecord = 2;
+
+	/** Logs and saves the ranked report, then stops recording */
+	void Report();
+};
+
+/** Adds the time until it goes out of scope to a startup entry while recording */
+class THIRDPERSONPROJECT_API FTPPScopedStartupTimer
+{
+public:
+
+	explicit FTPPScopedStartupTimer(const TCHAR* InName);
+
+	/** Times an actor's BeginPlay under its class name */
+	explicit FTPPScopedStartupTimer(const UObject* Object);
+
+	~FTPPScopedStartupTimer();
+
+private:
+
+	FString Name;
+
+	double StartTime = 0.0;
+};
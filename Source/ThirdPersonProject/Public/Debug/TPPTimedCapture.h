@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Times something once per frame over a number of frames, then logs the average and worst frame.
+ * Subclasses bind to the delegates around what they time and pass each frame's time to AddFrame.
+ */
+class THIRDPERSONPROJECT_API FTPPTimedCapture
+{
+public:
+
+	virtual ~FTPPTimedCapture() {}
+
+	/** Starts capturing the given number of frames. Does nothing if a capture is in progress or the subclass can't capture right now. */
+	void Start(int32 InNumFrames);
+
+	bool IsCapturing() const { return NumFramesLeft > 0; }
+
+protected:
+
+	/** Description of what is timed, used in the log */
+	const TCHAR* Description;
+
+	int32 NumFrames = 0;
+
+	double TotalSeconds = 0.0;
+
+	double MaxSeconds = 0.0;
+
+	explicit FTPPTimedCapture(const TCHAR* InDescription) : Description(InDescription) {}
+
+	virtual bool CanStart() const { return true; }
+
+	/** Called when a capture starts, after the totals are reset */
+	virtual void BindDelegates() = 0;
+
+	/** Called once the last frame has been added */
+	virtual void UnbindDelegates() = 0;
+
+	/** Appends anything the subclass measures besides time to the logged summary */
+	virtual FString GetExtraSummary() const { return FString(); }
+
+	/** Records one frame and ends the capture once enough have been recorded */
+	void AddFrame(double FrameSeconds);
+
+private:
+
+	int32 NumFramesLeft = 0;
+};
+
+/** Times whole frames and samples resident memory. Works on dedicated servers. */
+class THIRDPERSONPROJECT_API FTPPFramePerfCapture : public FTPPTimedCapture
+{
+public:
+
+	static FTPPFramePerfCapture& Get();
+
+protected:
+
+	FTPPFramePerfCapture() : FTPPTimedCapture(TEXT("Frames")) {}
+
+	virtual void BindDelegates() override;
+
+	virtual void UnbindDelegates() override;
+
+	virtual FString GetExtraSummary() const override;
+
+private:
+
+	double LastFrameEndTime = 0.0;
+
+	uint64 MaxUsedPhysical = 0;
+
+	FDelegateHandle EndFrameHandle;
+
+	void OnEndFrame();
+};
+
+#if !UE_SERVER
+
+/** Times Slate ticks, which include widget prepass and paint */
+class THIRDPERSONPROJECT_API FTPPSlateTimingCapture : public FTPPTimedCapture
+{
+public:
+
+	static FTPPSlateTimingCapture& Get();
+
+protected:
+
+	FTPPSlateTimingCapture() : FTPPTimedCapture(TEXT("Slate tick, prepass and paint")) {}
+
+	virtual bool CanStart() const override;
+
+	virtual void BindDelegates() override;
+
+	virtual void UnbindDelegates() override;
+
+private:
+
+	double TickStartTime = 0.0;
+
+	FDelegateHandle PreTickHandle;
+
+	FDelegateHandle PostTickHandle;
+
+	void OnPreTick(float DeltaTime);
+
+	void OnPostTick(float DeltaTime);
+};
+
+#endif
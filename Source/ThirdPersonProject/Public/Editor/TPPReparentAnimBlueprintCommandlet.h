@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TPPReparentAnimBlueprintCommandlet.generated.h"
+
+/**
+ * Reparents anim blueprints to UTPPAnimInstance so their values come from the native proxy update instead of the event graph.
+ * Blueprint variables that the native class also declares are removed along with the event graph nodes that set them,
+ * and the anim graph reads the native properties instead. Variables with a different type are left alone and logged.
+ *
+ * UE4Editor-Cmd ThirdPersonProject.uproject -run=TPPReparentAnimBlueprint [-AnimBlueprint=/Game/Mannequin/Animations/ThirdPerson_AnimBP]
+ */
+UCLASS()
+class THIRDPERSONPROJECT_API UTPPReparentAnimBlueprintCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UTPPReparentAnimBlueprintCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Engine/StreamableManager.h"
+#include "TPPAssetStreamingSubsystem.generated.h"
+
+/** Soft referenced asset kept loaded while any requester needs it */
+struct FTPPStreamedAsset
+{
+	TSharedPtr<FStreamableHandle> Handle;
+
+	int32 RefCount = 0;
+};
+
+/** Actor whose assets are requested while a local player is nearby */
+struct FTPPProximityPreload
+{
+	TWeakObjectPtr<AActor> Actor;
+
+	TArray<FSoftObjectPath> Assets;
+
+	bool bIsRequested = false;
+};
+
+/**
+ * Streams soft referenced weapon, special move and character assets in asynchronously and keeps them loaded while they are requested.
+ * Assets are reference counted across requesters and their handles are released when the last requester is done with them, so they can be garbage collected.
+ */
+UCLASS(Config = Game)
+class THIRDPERSONPROJECT_API UTPPAssetStreamingSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	static UTPPAssetStreamingSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Starts loading the assets and keeps them loaded until the requester releases them. Replaces any assets the requester requested before. */
+	void RequestAssets(const UObject* Requester, const TArray<FSoftObjectPath>& Assets);
+
+	void ReleaseAssets(const UObject* Requester);
+
+	/** Requests the actor's assets while a locally controlled pawn is within preload distance of it */
+	void RegisterProximityPreload(AActor* Actor, const TArray<FSoftObjectPath>& Assets);
+
+	/** Stops proximity preloading and releases the actor's assets if they were requested by proximity */
+	void UnregisterProximityPreload(AActor* Actor);
+
+	/** Returns the asset if it is loaded. Otherwise loads it synchronously and warns, as it should have been requested ahead of time. */
+	template<typename T>
+	static T* GetLoadedAsset(const TSoftObjectPtr<T>& Asset)
+	{
+		T* LoadedAsset = Asset.Get();
+		if (!LoadedAsset && !Asset.IsNull())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s was not streamed in ahead of use and is being loaded synchronously"), *Asset.ToString());
+			LoadedAsset = Asset.LoadSynchronous();
+		}
+		return LoadedAsset;
+	}
+
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+
+	/** Distance from a local pawn at which proximity preloads are requested */
+	UPROPERTY(Config)
+	float ProximityPreloadDistance = 2000.0f;
+
+	/** Distance from every local pawn at which proximity preloads are released. Larger than the preload distance to avoid thrashing. */
+	UPROPERTY(Config)
+	float ProximityReleaseDistance = 3000.0f;
+
+	/** Time between proximity checks */
+	UPROPERTY(Config)
+	float ProximityUpdateInterval = .5f;
+
+	TMap<FSoftObjectPath, FTPPStreamedAsset> StreamedAssets;
+
+	/** Assets held by each requester. Requesters must release their assets before they are destroyed. */
+	TMap<const UObject*, TArray<FSoftObjectPath>> RequesterAssets;
+
+	TArray<FTPPProximityPreload> ProximityPreloads;
+
+	float TimeSinceProximityUpdate = 0.0f;
+
+	void AddAssetReference(const FSoftObjectPath& Asset);
+
+	void RemoveAssetReference(const FSoftObjectPath& Asset);
+
+	void UpdateProximityPreloads();
+};
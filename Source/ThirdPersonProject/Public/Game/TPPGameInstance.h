@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Engine/GameInstance.h"
 #include "TPPAimProperties.h"
+#include "TPPInputProperties.h"
 #include "TPPGameInstance.generated.h"
 
 class ATPPHUD;
@@ -28,12 +29,24 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	TSubclassOf<UTPPAimProperties> AimPropertiesClass;
 
+	/** Reference to default input properties object */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	TSubclassOf<UTPPInputProperties> InputPropertiesClass;
+
 protected:
 
 	/** Instantiated aim properties asset */
 	UPROPERTY(Transient)
 	UTPPAimProperties* AimProperties;
 
+	/** Instantiated input properties asset */
+	UPROPERTY(Transient)
+	UTPPInputProperties* InputProperties;
+
+	/** Input recording to replay once the map it was recorded on has loaded */
+	UPROPERTY(Transient)
+	FString PendingInputReplay;
+
 public:
 
 	static UTPPGameInstance* Get() { return Instance; }
@@ -48,4 +61,15 @@ public:
 	/** Get a pointer to the aim properties object */
 	UFUNCTION(BlueprintCallable)
 	UTPPAimProperties* GetAimProperties() const { return AimProperties; }
+
+	/** Get a pointer to the input properties object */
+	UFUNCTION(BlueprintCallable)
+	UTPPInputProperties* GetInputProperties() const { return InputProperties; }
+
+	void SetPendingInputReplay(const FString& Filename) { PendingInputReplay = Filename; }
+
+	const FString& GetPendingInputReplay() const { return PendingInputReplay; }
+
+	/** Returns the recording waiting to be replayed after travel and clears it */
+	FString ConsumePendingInputReplay() { return MoveTemp(PendingInputReplay); }
 };
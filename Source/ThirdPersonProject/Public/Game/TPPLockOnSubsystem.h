@@ -0,0 +1,152 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "TPPLockOnSubsystem.generated.h"
+
+class ABaseEnemy;
+
+/** View cone to search for a lock-on or aim assist target */
+USTRUCT(BlueprintType)
+struct FTPPLockOnQuery
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector ViewLocation = FVector::ZeroVector;
+
+	/** Normalized direction of the cone's axis */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FVector ViewDirection = FVector::ForwardVector;
+
+	/** Half angle of the cone in degrees */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ConeHalfAngle = 20.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float MaxDistance = 3000.0f;
+
+	/** Actor ignored by line of sight traces, usually the querying character */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	AActor* IgnoredActor = nullptr;
+};
+
+/** Node of the lock-on bounding volume hierarchy. Leaves hold a single target. */
+struct FTPPLockOnTreeNode
+{
+	/** Bounds of the subtree. Leaf bounds are padded so small movements don't require reinsertion. */
+	FBox Bounds = FBox(ForceInit);
+
+	/** Parent node, or the next free node while this node is unused */
+	int32 Parent = INDEX_NONE;
+
+	int32 Children[2] = { INDEX_NONE, INDEX_NONE };
+
+	/** 0 for leaves, INDEX_NONE while unused */
+	int32 Height = 0;
+
+	ABaseEnemy* Target = nullptr;
+
+	/** Lock-on location of the target at the last refit */
+	FVector TargetLocation = FVector::ZeroVector;
+
+	bool IsLeaf() const { return Height == 0; }
+};
+
+/**
+ * Finds lock-on and aim assist targets among the enemies that can be locked onto.
+ * Targets are kept in a dynamic bounding volume hierarchy. Leaves that move outside their padded bounds are reinserted each frame, and the tree is rebuilt if it grows unbalanced.
+ * Queries cull subtrees against the view cone, score the targets inside it and only trace line of sight to the best few.
+ */
+UCLASS(Config = Game)
+class THIRDPERSONPROJECT_API UTPPLockOnSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	static UTPPLockOnSubsystem* Get(const UObject* WorldContextObject);
+
+	void RegisterTarget(ABaseEnemy* Target);
+
+	void UnregisterTarget(ABaseEnemy* Target);
+
+	/** Returns the best visible target in the query cone, or null if there is none */
+	UFUNCTION(BlueprintCallable)
+	ABaseEnemy* FindBestTarget(const FTPPLockOnQuery& Query) const;
+
+	/** Returns the score FindBestTarget gives a target at the location, lower being better, or MAX_flt if it is outside the query cone. Ignores line of sight. */
+	float GetTargetScore(const FTPPLockOnQuery& Query, const FVector& TargetLocation) const;
+
+	/** Height of the hierarchy, 0 for a single target and INDEX_NONE if empty */
+	int32 GetTreeHeight() const { return RootNode != INDEX_NONE ? Nodes[RootNode].Height : INDEX_NONE; }
+
+	/** Height past which the hierarchy is rebuilt on the next tick */
+	static int32 GetMaxTreeHeight(int32 NumTargets) { return 2 * (int32)FMath::CeilLogTwo(NumTargets) + 4; }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+
+	/** Padding added to leaf bounds. Larger values mean fewer reinsertions but looser culling. */
+	UPROPERTY(Config)
+	float LeafBoundsMargin = 100.0f;
+
+	/** Number of best scoring targets tested for line of sight, in score order, until one is visible */
+	UPROPERTY(Config)
+	int32 MaxLineOfSightCandidates = 4;
+
+	/** Score weight of the angle from the cone's axis */
+	UPROPERTY(Config)
+	float AngleScoreWeight = 1.0f;
+
+	/** Score weight of the distance from the view */
+	UPROPERTY(Config)
+	float DistanceScoreWeight = .5f;
+
+	UPROPERTY(Config)
+	TEnumAsByte<ECollisionChannel> LineOfSightChannel = ECollisionChannel::ECC_Visibility;
+
+	TArray<FTPPLockOnTreeNode> Nodes;
+
+	int32 RootNode = INDEX_NONE;
+
+	/** Head of the list of unused nodes */
+	int32 FreeNode = INDEX_NONE;
+
+	/** Leaf node of each registered target */
+	TMap<ABaseEnemy*, int32> TargetLeaves;
+
+	int32 AllocateNode();
+
+	void ReleaseNode(int32 NodeIndex);
+
+	void InsertLeaf(int32 LeafIndex);
+
+	void RemoveLeaf(int32 LeafIndex);
+
+	/** Recomputes bounds and heights from the node up to the root */
+	void RefitAncestors(int32 NodeIndex);
+
+	/** Rebuilds every internal node by splitting leaves at the median of their longest axis */
+	void RebuildTree();
+
+	int32 BuildSubtree(TArray<int32>& Leaves, int32 Start, int32 Count);
+
+	/** Scores a target against a query whose cone half angle has the given cosine. Returns MAX_flt if it is outside the cone. */
+	float ScoreTarget(const FTPPLockOnQuery& Query, float CosHalfAngle, const FVector& TargetLocation) const;
+
+	FBox GetLeafBounds(const FVector& TargetLocation) const;
+};
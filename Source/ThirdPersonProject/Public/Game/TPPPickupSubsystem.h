@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "TPPPickupSubsystem.generated.h"
+
+class ATPPPickupBase;
+class ATPPPlayerCharacter;
+
+/** Character tested against nearby pickups when it moves */
+struct FTPPPickupCollector
+{
+	TWeakObjectPtr<ATPPPlayerCharacter> Character;
+
+	/** Location of the last proximity test */
+	FVector LastQueryLocation = FVector(BIG_NUMBER);
+};
+
+/** Pickup waiting to respawn in a timing wheel slot */
+struct FTPPPickupRespawn
+{
+	TWeakObjectPtr<ATPPPickupBase> Pickup;
+
+	/** World time the pickup respawns */
+	float RespawnTime = 0.0f;
+};
+
+/**
+ * Handles pickup collection and respawning for every pickup in the world, so pickups don't tick or generate overlaps.
+ * Pickups are kept in a spatial hash that is only queried around characters that have moved, or around a pickup when it activates.
+ * Respawns are driven from a single timing wheel. Nothing ticks while no character is registered and no respawns are pending.
+ */
+UCLASS(Config = Game)
+class THIRDPERSONPROJECT_API UTPPPickupSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	static UTPPPickupSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Adds a pickup to the spatial hash. Pickups are expected not to move once registered. */
+	void RegisterPickup(ATPPPickupBase* Pickup);
+
+	void UnregisterPickup(ATPPPickupBase* Pickup);
+
+	void RegisterCharacter(ATPPPlayerCharacter* Character);
+
+	void UnregisterCharacter(ATPPPlayerCharacter* Character);
+
+	/** Activates the pickup once the delay has passed */
+	void ScheduleRespawn(ATPPPickupBase* Pickup, float Delay);
+
+	/** Gives characters already standing on a pickup the chance to collect it */
+	void OnPickupActivated(ATPPPickupBase* Pickup);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+
+	/** Size of a spatial hash cell. Should be a few times larger than the largest pickup radius. */
+	UPROPERTY(Config)
+	float CellSize = 1000.0f;
+
+	/** Distance a character must move before it is tested against pickups again */
+	UPROPERTY(Config)
+	float MinQueryMoveDistance = 5.0f;
+
+	/** Time covered by each timing wheel slot */
+	UPROPERTY(Config)
+	float RespawnSlotDuration = .25f;
+
+	static constexpr int32 NumRespawnSlots = 64;
+
+	/** Pickups in each occupied cell */
+	TMap<FIntVector, TArray<ATPPPickupBase*>> PickupCells;
+
+	/** Cell each pickup was registered to */
+	TMap<ATPPPickupBase*, FIntVector> PickupCellKeys;
+
+	/** Largest radius of any registered pickup. Used to pad cell queries. */
+	float MaxPickupRadius = 0.0f;
+
+	TArray<FTPPPickupCollector> Collectors;
+
+	/** Respawns bucketed by slot. Respawns further out than a full turn stay in their slot until their time comes around. */
+	TStaticArray<TArray<FTPPPickupRespawn>, NumRespawnSlots> RespawnSlots;
+
+	int32 NumPendingRespawns = 0;
+
+	/** Absolute index of the last slot processed */
+	int64 LastProcessedSlot = INDEX_NONE;
+
+	FIntVector GetCellKey(const FVector& Location) const;
+
+	int64 GetAbsoluteSlot(float WorldTime) const;
+
+	/** Activates every pickup in the slot whose respawn time has passed */
+	void ProcessRespawnSlot(int64 AbsoluteSlot, float CurrentTime);
+
+	/** Collects any active pickup within reach of the character */
+	void QueryPickups(ATPPPlayerCharacter* Character);
+
+	/** Returns true if the character is within reach of the pickup */
+	bool IsWithinReach(const ATPPPlayerCharacter* Character, const ATPPPickupBase* Pickup) const;
+};
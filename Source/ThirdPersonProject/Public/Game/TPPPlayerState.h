@@ -6,6 +6,29 @@
 #include "GameFramework/PlayerState.h"
 #include "TPPPlayerState.generated.h"
 
+/** Replicated health state. Current health is evaluated from this instead of being written every frame while regenerating. */
+USTRUCT()
+struct FTPPHealthRegenState
+{
+	GENERATED_BODY()
+
+	/** Health at the time regen started, or the current health if not regenerating */
+	UPROPERTY()
+	float HealthAtStart = 125.0f;
+
+	/** Server world time that regen started */
+	UPROPERTY()
+	float RegenStartServerTime = 0.0f;
+
+	/** Health gained per second. Zero if not regenerating */
+	UPROPERTY()
+	float RegenRate = 0.0f;
+
+	/** Health that regen stops at */
+	UPROPERTY()
+	float MaxHealth = 125.0f;
+};
+
 /**
  * 
  */
@@ -18,26 +41,47 @@ public:
 
 	// Required network scaffolding
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
-	
+
 protected:
 
-	UPROPERTY(ReplicatedUsing = OnRep_PlayerHealth, meta = (ClampMin="0.0"))
-	float PlayerHealth = 125.0f;
+	UPROPERTY(ReplicatedUsing = OnRep_PlayerHealth)
+	FTPPHealthRegenState PlayerHealth;
 
 	UPROPERTY(Replicated)
 	bool bIsPlayerAlive = true;
 
+	/** Fires when regen reaches max health so the rate can be cleared */
+	FTimerHandle RegenCompleteTimerHandle;
+
+	/** Returns the server world time, falling back to local world time before the game state has replicated */
+	float GetServerWorldTimeSeconds() const;
+
+	/** Stops regen at max health, or sets a timer for when it will get there. Server only. */
+	void UpdateRegenCompleteTimer();
+
 public:
 
+	/** Returns current health, including any health gained from regen since it started */
 	UFUNCTION(BlueprintCallable)
-	float GetHealth() const { return PlayerHealth; }
+	float GetHealth() const;
 
 	UFUNCTION(BlueprintCallable)
 	bool IsPlayerCharacterAlive() const { return bIsPlayerAlive; }
 
+	/** Returns true if health is regenerating and hasn't reached max health */
+	UFUNCTION(BlueprintPure)
+	bool IsRegeneratingHealth() const;
+
+	/** Sets health. Any active regen continues from the new value. */
 	UFUNCTION(Server, Reliable)
 	void SetPlayerHealth(float HealthDelta);
 
+	/** Starts regenerating health at the given rate until max health is reached. Server only. */
+	void BeginHealthRegen(float RegenRate, float MaxHealth);
+
+	/** Stops regenerating, keeping the health gained so far. Server only. */
+	void StopHealthRegen();
+
 protected:
 
 	UFUNCTION()
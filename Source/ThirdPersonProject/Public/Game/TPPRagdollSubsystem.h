@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "TPPRagdollSubsystem.generated.h"
+
+class USkeletalMeshComponent;
+
+/** Enum detailing the physics state of a ragdoll */
+UENUM()
+enum class ETPPRagdollState : uint8
+{
+	Simulating,
+	/** Bodies have settled and been put to sleep. Still wakes up if hit. */
+	Sleeping,
+	/** Physics disabled and the last simulated pose held */
+	Frozen
+};
+
+/** Ragdoll tracked by the ragdoll subsystem */
+struct FTPPRagdollEntry
+{
+	TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+
+	ETPPRagdollState State = ETPPRagdollState::Simulating;
+
+	/** World time the ragdoll began */
+	float StartTime = 0.0f;
+
+	/** Time the ragdoll has been below the sleep velocity threshold */
+	float SettledTime = 0.0f;
+};
+
+/**
+ * Keeps the cost of ragdolls bounded. Settled ragdolls are put to sleep, ragdolls are frozen to their last pose after a timeout
+ * or when too many are simulating, and the oldest corpses are recycled once the corpse budget is exceeded.
+ * Sleeping and freezing are local, but only the server recycles corpses. Clients follow the replicated result.
+ */
+UCLASS(Config = Game)
+class THIRDPERSONPROJECT_API UTPPRagdollSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	static UTPPRagdollSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Starts tracking a mesh that has begun simulating as a ragdoll */
+	void RegisterRagdoll(USkeletalMeshComponent* Mesh);
+
+	void UnregisterRagdoll(USkeletalMeshComponent* Mesh);
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+
+	/** Max ragdolls simulating at once. The oldest simulating ragdoll is frozen when exceeded. */
+	UPROPERTY(Config)
+	int32 MaxSimulatingRagdolls = 4;
+
+	/** Max corpses of any state. The oldest corpse is recycled when exceeded. */
+	UPROPERTY(Config)
+	int32 MaxCorpses = 12;
+
+	/** Speed below which a ragdoll is considered settled */
+	UPROPERTY(Config)
+	float SleepVelocityThreshold = 5.0f;
+
+	/** Time a ragdoll must be settled before being put to sleep */
+	UPROPERTY(Config)
+	float SleepDelay = .5f;
+
+	/** Time after which a ragdoll is frozen to its current pose, even if it hasn't settled */
+	UPROPERTY(Config)
+	float FreezeTimeout = 8.0f;
+
+	/** Tracked ragdolls, oldest first */
+	TArray<FTPPRagdollEntry> RagdollEntries;
+
+	void FreezeRagdoll(FTPPRagdollEntry& Entry);
+
+	/** Server only. Removes the corpse from the world. Unpossessed owners are destroyed, otherwise the owner is hidden and stops colliding. */
+	void RecycleRagdoll(FTPPRagdollEntry& Entry);
+};
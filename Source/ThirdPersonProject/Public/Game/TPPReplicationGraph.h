@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "TPPReplicationGraph.generated.h"
+
+class ATPPPlayerCharacter;
+class ATPPWeaponBase;
+class UReplicationGraphNode_GridSpatialization2D;
+class UReplicationGraphNode_ActorList;
+class UReplicationGraphNode_PlayerStateFrequencyLimiter;
+
+/** How actors of a class are routed into the replication graph */
+enum class ETPPClassRepNodeMapping : uint8
+{
+	/** Not routed to a node. Replicated through the connection or as a dependent of another actor. */
+	NotRouted,
+
+	RelevantAllConnections,
+
+	/** Spatialized actors that never move */
+	Spatialize_Static,
+
+	/** Spatialized actors that move every frame */
+	Spatialize_Dynamic,
+
+	/** Spatialized actors that are treated as static while dormant */
+	Spatialize_Dormancy,
+
+	/** Weapons replicate with their owning character while equipped and are spatialized once dropped */
+	Weapon,
+};
+
+/**
+ * Replication graph that replaces the per-connection relevancy checks of the net driver.
+ * Characters and enemies go in a spatial grid, equipped weapons replicate with their owner and player states are sent a few per frame.
+ * Enabled through ReplicationDriverClassName in DefaultEngine.ini.
+ */
+UCLASS(Transient, Config = Game)
+class THIRDPERSONPROJECT_API UTPPReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void InitGlobalActorClassSettings() override;
+
+	virtual void InitGlobalGraphNodes() override;
+
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+
+	virtual void RemoveClientConnection(UNetConnection* NetConnection) override;
+
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	virtual void BeginDestroy() override;
+
+	/** Times replication for the scaling log enabled with TPP.RepGraphScalingLogFrames */
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+protected:
+
+	/** Size of a spatial grid cell */
+	UPROPERTY(Config)
+	float GridCellSize = 10000.0f;
+
+	/** Offset of the grid origin. Should place the whole map in positive grid space. */
+	UPROPERTY(Config)
+	FVector2D GridSpatialBias = FVector2D(-150000.0f, -150000.0f);
+
+	/** Player states replicated to each connection per frame */
+	UPROPERTY(Config)
+	int32 PlayerStatesPerFrame = 2;
+
+	UPROPERTY()
+	UReplicationGraphNode_GridSpatialization2D* GridNode = nullptr;
+
+	UPROPERTY()
+	UReplicationGraphNode_ActorList* AlwaysRelevantNode = nullptr;
+
+	UPROPERTY()
+	UReplicationGraphNode_PlayerStateFrequencyLimiter* PlayerStateNode = nullptr;
+
+	TClassMap<ETPPClassRepNodeMapping> ClassRepNodePolicies;
+
+	/** Replication time and frames since the last scaling log line */
+	double ScalingLogSeconds = 0.0;
+
+	int32 ScalingLogFrames = 0;
+
+	int32 ScalingLogReplicatedActors = 0;
+
+	/** Character each routed weapon depends on. Null while the weapon is dropped and spatialized. */
+	TMap<TObjectKey<ATPPWeaponBase>, TWeakObjectPtr<ATPPPlayerCharacter>> WeaponOwners;
+
+	ETPPClassRepNodeMapping GetMappingPolicy(UClass* Class);
+
+	void InitClassReplicationInfo(UClass* Class);
+
+	/** Moves a weapon between its owner's dependent actors and the spatial grid */
+	void OnWeaponOwnerChanged(ATPPWeaponBase* Weapon, ATPPPlayerCharacter* NewOwner);
+
+	void AddWeapon(ATPPWeaponBase* Weapon, ATPPPlayerCharacter* Owner);
+
+	void RemoveWeapon(ATPPWeaponBase* Weapon);
+};
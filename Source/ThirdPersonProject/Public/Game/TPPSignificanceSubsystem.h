@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Interfaces/TPPSignificanceInterface.h"
+#include "TPPSignificanceSubsystem.generated.h"
+
+/** Actor tracked by the significance subsystem */
+struct FTPPSignificanceEntry
+{
+	TWeakObjectPtr<AActor> Actor;
+
+	ETPPSignificanceTier Tier = ETPPSignificanceTier::High;
+};
+
+/**
+ * Scores registered actors by distance, screen size and visibility relative to the local view and buckets them into tiers.
+ * Actors are notified when their tier changes so they can adjust tick and animation update rates.
+ */
+UCLASS(Config = Game)
+class THIRDPERSONPROJECT_API UTPPSignificanceSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	UTPPSignificanceSubsystem();
+
+	static UTPPSignificanceSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Starts tracking an actor. The actor must implement ITPPSignificanceInterface. */
+	void RegisterActor(AActor* Actor);
+
+	void UnregisterActor(AActor* Actor);
+
+	const FTPPSignificanceTierSettings& GetTierSettings(ETPPSignificanceTier Tier) const;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+
+	/** Time between significance updates */
+	UPROPERTY(Config)
+	float SignificanceUpdateInterval = .25f;
+
+	/** Settings for each tier, indexed by ETPPSignificanceTier. Resized to one entry per tier on initialize if config changes the count. */
+	UPROPERTY(Config)
+	TArray<FTPPSignificanceTierSettings> TierSettings;
+
+	/** Tracked actors. Not a UPROPERTY since registered actors are kept alive by the world. */
+	TArray<FTPPSignificanceEntry> SignificanceEntries;
+
+	UPROPERTY(Transient)
+	float TimeSinceSignificanceUpdate = 0.0f;
+
+	/** Re-scores every tracked actor against the given view */
+	void UpdateSignificance(const FVector& ViewLocation, const float ViewFOV);
+
+	ETPPSignificanceTier CalculateTier(AActor* Actor, const FVector& ViewLocation, const float TanHalfFOV) const;
+};
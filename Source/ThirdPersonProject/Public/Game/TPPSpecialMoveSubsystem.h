@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "SpecialMove/TPPSpecialMove.h"
+#include "TPPSpecialMoveSubsystem.generated.h"
+
+class UTPPSpecialMoveSubsystem;
+
+/** Tick function that ticks every special move registered to one tick group */
+USTRUCT()
+struct FTPPSpecialMoveTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UTPPSpecialMoveSubsystem* Subsystem = nullptr;
+
+	ETPPSpecialMoveTickGroup SpecialMoveTickGroup = ETPPSpecialMoveTickGroup::BeforeMovement;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FTPPSpecialMoveTickFunction> : public TStructOpsTypeTraitsBase2<FTPPSpecialMoveTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Ticks active special moves for every character in one loop per tick group instead of from each character's tick.
+ * Moves that only wait on montage or movement events are kept asleep and never ticked.
+ * The before movement group ticks ahead of the movement components of the characters whose moves it runs, and the after movement group behind them.
+ */
+UCLASS()
+class THIRDPERSONPROJECT_API UTPPSpecialMoveSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	static UTPPSpecialMoveSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/** Starts ticking a move that has begun, or puts it to sleep if it doesn't want to tick */
+	void RegisterSpecialMove(UTPPSpecialMove* SpecialMove);
+
+	void UnregisterSpecialMove(UTPPSpecialMove* SpecialMove);
+
+	/** Ticks every move registered to the tick group */
+	void TickSpecialMoves(ETPPSpecialMoveTickGroup TickGroup, float DeltaTime);
+
+protected:
+
+	UPROPERTY(Transient)
+	TArray<UTPPSpecialMove*> BeforeMovementSpecialMoves;
+
+	UPROPERTY(Transient)
+	TArray<UTPPSpecialMove*> AfterMovementSpecialMoves;
+
+	/** Moves that are running but only waiting on events */
+	UPROPERTY(Transient)
+	TArray<UTPPSpecialMove*> SleepingSpecialMoves;
+
+	FTPPSpecialMoveTickFunction BeforeMovementTickFunction;
+
+	FTPPSpecialMoveTickFunction AfterMovementTickFunction;
+
+	/** True while a tick list is being iterated. Unregistered moves are nulled out and removed after the loop. */
+	bool bIsTickingSpecialMoves = false;
+
+	TArray<UTPPSpecialMove*>& GetTickList(ETPPSpecialMoveTickGroup TickGroup);
+
+	FTPPSpecialMoveTickFunction& GetTickFunction(ETPPSpecialMoveTickGroup TickGroup);
+
+	/** Registers the group's tick function if needed and only enables it while it has moves to tick */
+	void UpdateTickFunction(ETPPSpecialMoveTickGroup TickGroup);
+
+	/** Orders the group's tick function against the movement component of the move's character, or removes that ordering */
+	void UpdateTickPrerequisite(UTPPSpecialMove* SpecialMove, ETPPSpecialMoveTickGroup TickGroup, bool bAdd);
+
+	void UpdateStats();
+};
@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "TPPSignificanceInterface.generated.h"
+
+/** Enum detailing how significant an actor is to the local view. Lower values are more significant. */
+UENUM(BlueprintType)
+enum class ETPPSignificanceTier : uint8
+{
+	High,
+	Medium,
+	Low,
+	Culled,
+	MAX UMETA(Hidden)
+};
+
+/** Update rates and features enabled for actors in a significance tier */
+USTRUCT(BlueprintType)
+struct FTPPSignificanceTierSettings
+{
+	GENERATED_BODY()
+
+	/** Max distance from the view for an actor to be in this tier */
+	UPROPERTY(EditDefaultsOnly)
+	float MaxDistance = BIG_NUMBER;
+
+	/** Min screen radius, as a fraction of the screen, for an actor to be in this tier */
+	UPROPERTY(EditDefaultsOnly)
+	float MinScreenRadius = 0.0f;
+
+	/** Actor tick interval. Zero ticks every frame */
+	UPROPERTY(EditDefaultsOnly)
+	float TickInterval = 0.0f;
+
+	/** True if skeletal meshes should use update rate optimizations */
+	UPROPERTY(EditDefaultsOnly)
+	bool bUseUpdateRateOptimizations = false;
+
+	UPROPERTY(EditDefaultsOnly)
+	EVisibilityBasedAnimTickOption AnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPose;
+
+	/** True if equipped weapons should update their spread */
+	UPROPERTY(EditDefaultsOnly)
+	bool bUpdateWeaponSpread = true;
+
+	/** True if equipped weapons should use left hand IK */
+	UPROPERTY(EditDefaultsOnly)
+	bool bUseWeaponIK = true;
+
+	/** True if cosmetic effects such as weapon trails and impact decals should be spawned */
+	UPROPERTY(EditDefaultsOnly)
+	bool bSpawnCosmetics = true;
+};
+
+// This class does not need to be modified.
+UINTERFACE(MinimalAPI)
+class UTPPSignificanceInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by actors whose update rate is driven by the significance subsystem.
+ */
+class THIRDPERSONPROJECT_API ITPPSignificanceInterface
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Called when the actor is moved into a new significance tier */
+	virtual void OnSignificanceTierChanged(ETPPSignificanceTier NewTier, const FTPPSignificanceTierSettings& TierSettings) = 0;
+
+	/** Returns true if the actor should always be in the highest tier, regardless of where it is relative to the view */
+	virtual bool IsAlwaysSignificant() const { return false; }
+};
@@ -30,15 +30,15 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (EditCondition = "!bDestroyOnPickedUp"))
 	float RespawnTime = 6.0f;
 
-protected:
+	/** Distance from a character's capsule within which the pickup is collected. Replaces overlap events. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float PickupRadius = 50.0f;
 
-	/** True if the pickup is active and can be picked up */
-	UPROPERTY(Transient, BlueprintReadOnly)
-	bool bIsActive = false;
+protected:
 
-	/** Respawn timer handle */
-	UPROPERTY(Transient)
-	FTimerHandle RespawnTimerHandle;
+	/** True if the pickup is active and can be picked up. Starts true so clients match the server before the pickup first replicates. */
+	UPROPERTY(Transient, BlueprintReadOnly, ReplicatedUsing=OnRep_IsActive)
+	bool bIsActive = true;
 	
 public:	
 	// Sets default values for this actor's properties
@@ -48,12 +48,17 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Required network scaffolding
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 public:	
 
-	virtual void NotifyActorBeginOverlap(AActor* OtherActor);
+	/** Collects the pickup if the character is allowed to. Called by the pickup subsystem when a character comes within reach. */
+	void TryPickup(ATPPPlayerCharacter* CharacterInstigator);
 
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	bool IsPickupActive() const { return bIsActive; }
 
 public:
 
@@ -67,18 +72,24 @@ public:
 
 	virtual void ObtainPickup_Implementation(ATPPPlayerCharacter* InstigatorCharacter);
 
-	/** Activates the pickup */
+	/** Activates the pickup. Server only. */
 	void Activate();
 
-	/** Deactivates the pickup */
+	/** Deactivates the pickup. Server only. */
 	void Deactivate();
 
 protected:
 
-	UFUNCTION(BlueprintImplementableEvent)
-	void OnActiveStateChanged(bool bIsPickupActive);
+	/** Wakes the pickup on the net driver for one update and changes its active state */
+	void SetPickupActive(bool bNewIsActive);
 
 	UFUNCTION()
-	void OnRespawnTimerExpired();
+	void OnRep_IsActive();
+
+	/** Applies visibility and collision for the current active state */
+	void ApplyActiveState();
+
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnActiveStateChanged(bool bIsPickupActive);
 
 };
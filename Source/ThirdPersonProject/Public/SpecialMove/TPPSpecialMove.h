@@ -4,10 +4,64 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "Engine/NetSerialization.h"
+#include "GameFramework/RootMotionSource.h"
 #include "TPPSpecialMove.generated.h"
 
 class ATPPPlayerCharacter;
 
+/** Actions a character can take. Blocking state is folded into a single mask so each query is one AND. */
+UENUM(meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class ETPPCharacterCapability : uint8
+{
+	None = 0 UMETA(Hidden),
+	Sprint = 0x01,
+	Crouch = 0x02,
+	Slide = 0x04,
+	Jump = 0x08,
+	Aim = 0x10,
+	Fire = 0x20,
+	Reload = 0x40
+};
+ENUM_CLASS_FLAGS(ETPPCharacterCapability);
+
+/** When a special move ticks relative to character movement */
+UENUM()
+enum class ETPPSpecialMoveTickGroup : uint8
+{
+	/** Ticks before the character's movement component, so changes to input or movement state apply to this frame's move */
+	BeforeMovement,
+	/** Ticks after the character's movement component, so the move sees this frame's movement */
+	AfterMovement
+};
+
+/** Compact description of the special move a character is running. Replicated so non-owning machines can run the same move locally. */
+USTRUCT()
+struct FTPPReplicatedSpecialMove
+{
+	GENERATED_BODY()
+
+	/** Index + 1 into the owning character's replicated special move classes. 0 if no move is running. */
+	UPROPERTY()
+	uint8 MoveClassIndex = 0;
+
+	/** Server world time the move started */
+	UPROPERTY()
+	float StartServerTime = 0.0f;
+
+	/** Move specific location, such as a wall attach point */
+	UPROPERTY()
+	FVector_NetQuantize10 Location = FVector::ZeroVector;
+
+	/** Move specific direction, such as the roll direction */
+	UPROPERTY()
+	FVector_NetQuantizeNormal Direction = FVector::ZeroVector;
+
+	/** Key of the predicted ability activation that started the move, so the server can drop moves from rejected activations */
+	UPROPERTY()
+	uint16 PredictionKey = 0;
+};
+
 /**
 *
 */
@@ -30,6 +84,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, meta = (editCondition = "bDurationBased"))
 	float Duration = 1.0f;
 
+	/** Tick group this move ticks in, if it ticks at all */
+	UPROPERTY(EditDefaultsOnly, Category = "Tick")
+	ETPPSpecialMoveTickGroup TickGroup = ETPPSpecialMoveTickGroup::BeforeMovement;
+
 	UPROPERTY(EditDefaultsOnly, Category = "Input")
 	bool bDisablesMovementInput = false;
 
@@ -54,6 +112,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Weapon")
 	bool bInterruptsReload = false;
 
+	/** Capabilities blocked while this move is running, on top of those blocked by the bDisables flags */
+	UPROPERTY(EditDefaultsOnly, Category = "Input", meta = (Bitmask, BitmaskEnum = "ETPPCharacterCapability"))
+	int32 AdditionalBlockedCapabilities = 0;
+
 public:
 
 	/** If true, disables character rotation forced by the player controller or movement component */
@@ -70,11 +132,18 @@ public:
 	UFUNCTION(BlueprintPure)
 	bool IsMoveBlockingWeaponUse() const { return bIsWeaponUseDisabled; }
 
+	/** Returns the character capabilities this move currently blocks */
+	ETPPCharacterCapability GetBlockedCapabilities() const;
+
 public:
 
 	UPROPERTY(Transient)
 	ATPPPlayerCharacter* OwningCharacter = nullptr;
 
+	/** Key of the predicted ability activation that started this move, or 0 if it wasn't predicted */
+	UPROPERTY(Transient)
+	uint16 PredictionKey = 0;
+
 protected:
 
 	UPROPERTY(Transient)
@@ -83,8 +152,42 @@ protected:
 	UPROPERTY(Transient)
 	bool bWasInterrupted = false;
 
+	/** Set once EndSpecialMove starts so a move that is ended again, such as by an interrupt during its own end, only ends once */
+	UPROPERTY(Transient)
+	bool bHasEnded = false;
+
+	/** True if started from a replicated descriptor instead of by the owning player. Simulated moves are cosmetic and never call server RPCs. */
+	UPROPERTY(Transient)
+	bool bIsSimulatedMove = false;
+
+	/** Server world time the move started. Only set for simulated moves. */
+	UPROPERTY(Transient)
+	float StartServerTime = 0.0f;
+
 public:
 
+	bool IsSimulatedMove() const { return bIsSimulatedMove; }
+
+	bool HasEnded() const { return bHasEnded; }
+
+	/** Sets up this move to be simulated from a replicated descriptor. Called before BeginSpecialMove. */
+	virtual void InitFromReplicatedSpecialMove(const FTPPReplicatedSpecialMove& ReplicatedMove);
+
+	/** Fills in the move specific parameters of the descriptor sent to non-owning machines */
+	virtual void GetReplicatedSpecialMoveParams(FTPPReplicatedSpecialMove& OutReplicatedMove) const {}
+
+	/** Adds the soft referenced assets this move needs. Requested by characters that can perform the move. */
+	virtual void GetStreamedAssets(TArray<FSoftObjectPath>& OutAssets) const {}
+
+	/**
+	* Builds the root motion source the movement component runs for this move. Called on the class default object on every machine,
+	* so the source can only depend on the class defaults and the direction. Returns false if the move has no root motion.
+	*/
+	virtual bool GetRootMotionSource(const FVector& Direction, FRootMotionSource_ConstantForce& OutSource) const { return false; }
+
+	/** Time since a simulated move started on the server. Used to catch up on moves that replicated late. */
+	float GetSimulatedElapsedTime() const;
+
 	UFUNCTION(BlueprintNativeEvent)
 	void BeginSpecialMove();
 
@@ -92,14 +195,21 @@ public:
 
 	virtual void Tick(float DeltaSeconds);
 
+	/** Returns true if this move needs to tick. Moves that only wait on montage or movement events sleep instead. */
+	virtual bool WantsTick() const { return bDurationBased; }
+
 	/** To be called if the move should end prematurely. Sets flag internally that should bypass some ending logic */
 	void InterruptSpecialMove();
 
+	/** Ends the move. Overrides should return straight away if HasEnded() and otherwise call Super last. */
 	UFUNCTION(BlueprintNativeEvent)
 	void EndSpecialMove();
 
 	virtual void EndSpecialMove_Implementation();
 
+	/** Clears transient state so a pooled move can be started again. Overrides should call Super. */
+	virtual void ResetSpecialMove();
+
 protected:
 
 	UFUNCTION()
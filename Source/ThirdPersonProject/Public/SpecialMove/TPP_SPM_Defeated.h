@@ -18,12 +18,14 @@ public:
 
 	/** Defeated anim montage */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animation")
-	UAnimMontage* DeathAnim;
+	TSoftObjectPtr<UAnimMontage> DeathAnim;
 
 public:
 
 	UTPP_SPM_Defeated(const FObjectInitializer& ObjectInitializer);
 
+	virtual void GetStreamedAssets(TArray<FSoftObjectPath>& OutAssets) const override;
+
 	virtual void BeginSpecialMove_Implementation() override;
 
 	virtual void EndSpecialMove_Implementation() override;
@@ -19,15 +19,19 @@ class THIRDPERSONPROJECT_API UTPP_SPM_DodgeRoll : public UTPPSpecialMove
 public:
 
 	UPROPERTY(EditDefaultsOnly)
-	UAnimMontage* AnimMontage;
+	TSoftObjectPtr<UAnimMontage> AnimMontage;
 
 	UPROPERTY(EditDefaultsOnly)
 	float RollSpeed;
 
-	/** Speed when coming out of the roll. Might need to replace with curve */
+	/** Speed along the roll direction when coming out of the roll. Movement input takes over from there. */
 	UPROPERTY(EditDefaultsOnly)
 	float RollRampDownSpeed;
 
+	/** Length of the roll's root motion source. Baked from AnimMontage whenever the move is saved, so the server never has to load the montage. */
+	UPROPERTY(VisibleDefaultsOnly)
+	float RollDuration;
+
 protected:
 
 	UPROPERTY(Transient)
@@ -39,16 +43,30 @@ protected:
 	UPROPERTY(EditDefaultsOnly)
 	FName RootMotionSourceName = FName(TEXT("Dodge Roll"));
 
+	/** Priority of the roll root motion source. Needs to be higher than any source it should override. */
+	UPROPERTY(EditDefaultsOnly)
+	uint16 RootMotionSourcePriority = 5;
+
 public:
 
 	UTPP_SPM_DodgeRoll(const FObjectInitializer& ObjectInitializer);
 
 	virtual void BeginSpecialMove_Implementation() override;
 
-	virtual void Tick(float DeltaTime) override;
-
 	virtual void EndSpecialMove_Implementation() override;
 
+	virtual void ResetSpecialMove() override;
+
+	virtual void InitFromReplicatedSpecialMove(const FTPPReplicatedSpecialMove& ReplicatedMove) override;
+
+	virtual void GetReplicatedSpecialMoveParams(FTPPReplicatedSpecialMove& OutReplicatedMove) const override;
+
+	virtual bool GetRootMotionSource(const FVector& Direction, FRootMotionSource_ConstantForce& OutSource) const override;
+
+#if WITH_EDITOR
+	virtual void PreSave(const class ITargetPlatform* TargetPlatform) override;
+#endif
+
 protected:
 
 	virtual void OnMontageEnded(UAnimMontage* Montage, bool bInterrupted) override;
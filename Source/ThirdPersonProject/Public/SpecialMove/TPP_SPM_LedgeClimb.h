@@ -17,7 +17,12 @@ class THIRDPERSONPROJECT_API UTPP_SPM_LedgeClimb : public UTPPSpecialMove
 public:
 
 	UPROPERTY(EditDefaultsOnly)
-	UAnimMontage* ClimbMontage;
+	TSoftObjectPtr<UAnimMontage> ClimbMontage;
+
+	/** Play length of the climb montage, accounting for its rate scale. 0 if there is no montage. */
+	float GetClimbMontageLength() const;
+
+	virtual void GetStreamedAssets(TArray<FSoftObjectPath>& OutAssets) const override;
 
 protected:
 
@@ -53,6 +58,8 @@ public:
 
 	virtual void EndSpecialMove_Implementation() override;
 
+	virtual void ResetSpecialMove() override;
+
 protected:
 
 	virtual void OnMontageEnded(UAnimMontage* Montage, bool bInterrupted) override;
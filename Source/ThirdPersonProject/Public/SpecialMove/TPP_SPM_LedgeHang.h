@@ -28,8 +28,13 @@ public:
 
 	virtual void EndSpecialMove_Implementation() override;
 
+	virtual void ResetSpecialMove() override;
+
 	virtual void Tick(float DeltaTime) override;
 
+	/** Ticks to wait out the action delay and read input. Simulated hangs have no input, so they sleep. */
+	virtual bool WantsTick() const override { return !bIsSimulatedMove; }
+
 protected:
 
 	UPROPERTY(Transient)
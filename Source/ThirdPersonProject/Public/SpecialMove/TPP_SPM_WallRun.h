@@ -43,8 +43,13 @@ public:
 
 	virtual void EndSpecialMove_Implementation() override;
 
+	virtual void ResetSpecialMove() override;
+
 	virtual void Tick(float DeltaTime) override;
 
+	/** Ticks to read input while owned by the player, even if not duration based */
+	virtual bool WantsTick() const override { return Super::WantsTick() || !bIsSimulatedMove; }
+
 protected:
 
 	void OnWallRunDestinationReached();
@@ -6,6 +6,19 @@
 #include "TPPAbilityBase.generated.h"
 
 class ATPPPlayerCharacter;
+class UTPPSpecialMove;
+
+/** Activation predicted by the owning client that the server hasn't responded to yet */
+struct FTPPPendingAbilityActivation
+{
+	uint16 PredictionKey = 0;
+
+	/** Platform time the activation was predicted. Used to measure confirmation latency. */
+	double ActivationTime = 0.0;
+
+	/** Last use time before the activation, restored if the server rejects it */
+	float PreviousAbilityUseTime = 0.0f;
+};
 
 /**
  * 
@@ -28,6 +41,14 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (UIMin = "0.0", ClampMin = "0.0"))
 	float AbilityCooldownTime = 0.0f;
 
+	/** Leeway given to the cooldown when the server confirms a predicted activation, to absorb clock error */
+	UPROPERTY(EditDefaultsOnly, meta = (UIMin = "0.0", ClampMin = "0.0"))
+	float ConfirmCooldownTolerance = .1f;
+
+	/** Special move this ability starts. The server only runs root motion moves the client sends for a confirmed activation if they are of this class. */
+	UPROPERTY(EditDefaultsOnly)
+	TSubclassOf<UTPPSpecialMove> ActivatedSpecialMoveClass;
+
 public: 
 
 	virtual bool ActivateAbility();
@@ -35,6 +56,22 @@ public:
 	UFUNCTION(BlueprintImplementableEvent)
 	void OnAbilityActivated();
 
+	/** Called on the owning client if the server rejected a predicted activation, after its special moves have been rolled back */
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnAbilityActivationRejected();
+
+	/**
+	 * Activates the ability on the owning client right away and asks the server to confirm it.
+	 * Special moves started during activation are tagged with the prediction key so they can be rolled back.
+	 */
+	bool PredictActivation();
+
+	/** Server. Validates a predicted activation and commits its cooldown. */
+	bool ConfirmActivation(uint16 PredictionKey);
+
+	/** Owning client. Handles the server's response to a predicted activation. */
+	void OnActivationResult(uint16 PredictionKey, bool bAccepted);
+
 	UFUNCTION()
 	void SetOwningCharacter(ATPPPlayerCharacter* Character);
 
@@ -56,4 +93,12 @@ protected:
 	/** Time since ability was last used. Used for tracking cooldown. */
 	UPROPERTY(Transient, BlueprintReadOnly, Replicated)
 	float LastAbilityUseTime = 0.0f;
+
+	/** Last prediction key handed out by this client. 0 is never used. */
+	uint16 LastPredictionKey = 0;
+
+	TArray<FTPPPendingAbilityActivation> PendingActivations;
+
+	/** Returns true if the ability is off cooldown, with optional leeway */
+	bool IsCooldownComplete(const float Tolerance = 0.0f) const;
 };
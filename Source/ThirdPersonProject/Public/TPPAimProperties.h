@@ -39,4 +39,8 @@ public:
 	/** Length for hitscan line traces */
 	UPROPERTY(EditDefaultsOnly)
 	float HitScanLength = 5000.f;
+
+	/** Half angle of the view cone searched for a lock-on target when aiming starts. Zero disables snapping to targets. */
+	UPROPERTY(EditDefaultsOnly, meta = (ClampMin = "0.0", ClampMax = "89.0"))
+	float LockOnConeHalfAngle = 10.0f;
 };
@@ -0,0 +1,207 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "ThirdPersonProject/TPPPlayerCharacter.h"
+#include "TPPAnimInstance.generated.h"
+
+class UTPPAnimInstance;
+
+/** Character state copied on the game thread for use by the animation worker thread */
+USTRUCT()
+struct FTPPAnimCharacterSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector Velocity = FVector::ZeroVector;
+
+	UPROPERTY()
+	FVector ControllerRelativeMovementSpeed = FVector::ZeroVector;
+
+	UPROPERTY()
+	FRotator AimRotationDelta = FRotator::ZeroRotator;
+
+	UPROPERTY()
+	EAnimationBlendSlot BlendSlot = EAnimationBlendSlot::None;
+
+	UPROPERTY()
+	EWallMovementState WallMovementState = EWallMovementState::None;
+
+	UPROPERTY()
+	bool bIsMovingOnGround = true;
+
+	UPROPERTY()
+	bool bIsCrouching = false;
+
+	UPROPERTY()
+	bool bIsSliding = false;
+
+	UPROPERTY()
+	bool bIsSprinting = false;
+
+	UPROPERTY()
+	bool bIsAiming = false;
+
+	UPROPERTY()
+	bool bIsAlive = true;
+
+	/** True if the equipped weapon wants left hand IK, ignoring montages */
+	UPROPERTY()
+	bool bWeaponWantsIK = false;
+
+	/** Reload montage of the equipped weapon. Only compared against montage evaluation data, never dereferenced off the game thread. */
+	const UAnimMontage* WeaponReloadMontage = nullptr;
+
+	UPROPERTY()
+	float MaxAimAngle = 90.0f;
+
+	UPROPERTY()
+	float LeftHandIKInterpSpeed = 10.0f;
+
+	UPROPERTY()
+	float BlendSlotInterpSpeed = 12.0f;
+};
+
+/** Animation proxy that snapshots character state on the game thread and derives animation values on the worker thread */
+USTRUCT()
+struct THIRDPERSONPROJECT_API FTPPAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FTPPAnimInstanceProxy() {}
+
+	FTPPAnimInstanceProxy(UAnimInstance* InAnimInstance) : FAnimInstanceProxy(InAnimInstance) {}
+
+protected:
+
+	/** Game thread. Copies character state into the snapshot. */
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+
+	/** Worker thread. Computes derived values from the snapshot only. */
+	virtual void Update(float DeltaSeconds) override;
+
+	/** Game thread. Copies derived values back to the anim instance for the anim graph. */
+	virtual void PostUpdate(UAnimInstance* InAnimInstance) const override;
+
+	/** Returns true if the montage is active in the current montage evaluation data */
+	bool IsMontageActive(const UAnimMontage* Montage) const;
+
+protected:
+
+	UPROPERTY(Transient)
+	FTPPAnimCharacterSnapshot Snapshot;
+
+	UPROPERTY(Transient)
+	float Speed = 0.0f;
+
+	UPROPERTY(Transient)
+	float MovementDirection = 0.0f;
+
+	UPROPERTY(Transient)
+	float AimPitch = 0.0f;
+
+	UPROPERTY(Transient)
+	float AimYaw = 0.0f;
+
+	UPROPERTY(Transient)
+	float LeftHandIKAlpha = 0.0f;
+
+	UPROPERTY(Transient)
+	float UpperBodyBlendWeight = 0.0f;
+
+	UPROPERTY(Transient)
+	float FullBodyBlendWeight = 0.0f;
+};
+
+/**
+ * Native anim instance for player characters. Character state is read once per update on the game thread and
+ * everything derived from it is computed in the proxy so the update can run on worker threads.
+ *
+ * Not active yet: ThirdPerson_AnimBP is still parented to UAnimInstance, so none of this runs until the asset is reparented
+ * with the TPPReparentAnimBlueprint commandlet and saved. Characters log a warning on BeginPlay until then.
+ */
+UCLASS(Transient, Blueprintable)
+class THIRDPERSONPROJECT_API UTPPAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+
+	friend struct FTPPAnimInstanceProxy;
+
+public:
+
+	/** Max aim offset angle in either direction */
+	UPROPERTY(EditDefaultsOnly, Category = "Animation|Aim")
+	float MaxAimAngle = 90.0f;
+
+	/** Speed to interpolate left hand IK alpha at */
+	UPROPERTY(EditDefaultsOnly, Category = "Animation|IK")
+	float LeftHandIKInterpSpeed = 10.0f;
+
+	/** Speed to interpolate blend slot weights at */
+	UPROPERTY(EditDefaultsOnly, Category = "Animation|Blending")
+	float BlendSlotInterpSpeed = 12.0f;
+
+	virtual void NativeInitializeAnimation() override;
+
+protected:
+
+	/** Typed owning character. Cached when the animation is initialized. */
+	UPROPERTY(Transient)
+	ATPPPlayerCharacter* OwningCharacter = nullptr;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation")
+	float Speed = 0.0f;
+
+	/** Movement direction relative to the controller, in degrees */
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation")
+	float MovementDirection = 0.0f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation|Aim")
+	float AimPitch = 0.0f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation|Aim")
+	float AimYaw = 0.0f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation|IK")
+	float LeftHandIKAlpha = 0.0f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation|Blending")
+	float UpperBodyBlendWeight = 0.0f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation|Blending")
+	float FullBodyBlendWeight = 0.0f;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation")
+	EWallMovementState WallMovementState = EWallMovementState::None;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation")
+	bool bIsMovingOnGround = true;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation")
+	bool bIsCrouching = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation")
+	bool bIsSliding = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation")
+	bool bIsSprinting = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation")
+	bool bIsAiming = false;
+
+	UPROPERTY(Transient, BlueprintReadOnly, Category = "Animation")
+	bool bIsAlive = true;
+
+private:
+
+	UPROPERTY(Transient)
+	FTPPAnimInstanceProxy Proxy;
+
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override { return &Proxy; }
+
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override {}
+};
@@ -48,6 +48,9 @@ protected:
 
 protected:
 
+	/** Creates the HUD widgets. Deferred past the first frame when TPP.DeferStartupInit is set. */
+	void CreateWidgets();
+
 	UFUNCTION()
 	void OnPlayerEquippedWeapon(ATPPWeaponBase* WeaponEquipped);
 
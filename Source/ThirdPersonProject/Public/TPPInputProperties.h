@@ -31,6 +31,10 @@ public:
 	/** Time to hold button for input action to register */
 	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bIsKeyHold"))
 	float KeyHoldTime = 0.0f;
+
+	/** Time a press blocked by a special move is kept and retried once the move ends. Zero disables buffering, negative keeps the player controller's default. */
+	UPROPERTY(EditDefaultsOnly, meta = (ClampMin = "-1.0", UIMin = "-1.0"))
+	float BufferWindow = -1.0f;
 };
 
 /**
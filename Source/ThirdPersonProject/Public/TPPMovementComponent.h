@@ -6,12 +6,99 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "TPPMovementComponent.generated.h"
 
+class ATPPPlayerCharacter;
+class UTPPSpecialMove;
+
 UENUM()
 enum class ECustomMovementMode : uint8 
 {
 	Sliding = 0,
 };
 
+/** Saved move that keeps slide intent and the root motion special move so replayed moves start and stop them on the same move */
+class FSavedMove_TPPCharacter : public FSavedMove_Character
+{
+public:
+
+	typedef FSavedMove_Character Super;
+
+	virtual void Clear() override;
+
+	virtual void SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override;
+
+	virtual void PrepMoveFor(ACharacter* Character) override;
+
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+
+private:
+
+	friend struct FTPPCharacterNetworkMoveData;
+
+	bool bSavedWantsToSlide = false;
+
+	TSubclassOf<UTPPSpecialMove> SavedRootMotionMoveClass;
+
+	FVector SavedRootMotionMoveDirection = FVector::ZeroVector;
+
+	uint8 SavedRootMotionMoveId = 0;
+
+	uint16 SavedRootMotionMovePredictionKey = 0;
+
+	uint8 SavedAppliedRootMotionMoveId = 0;
+
+	uint16 SavedAppliedRootMotionSourceID = 0;
+};
+
+/** Move data sent to the server. Carries the root motion special move so the server starts and stops its source on the same move as the client. */
+struct FTPPCharacterNetworkMoveData : public FCharacterNetworkMoveData
+{
+	typedef FCharacterNetworkMoveData Super;
+
+	TSubclassOf<UTPPSpecialMove> RootMotionMoveClass;
+
+	FVector_NetQuantizeNormal RootMotionMoveDirection;
+
+	uint8 RootMotionMoveId = 0;
+
+	uint16 RootMotionMovePredictionKey = 0;
+
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+};
+
+struct FTPPCharacterNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+{
+	FTPPCharacterNetworkMoveDataContainer();
+
+	FTPPCharacterNetworkMoveData TPPDefaultMoveData[3];
+};
+
+/** Move response sent to the client. Corrections carry the server's slide step state so moves replayed after them take the same fixed steps. */
+struct FTPPCharacterMoveResponseDataContainer : public FCharacterMoveResponseDataContainer
+{
+	typedef FCharacterMoveResponseDataContainer Super;
+
+	float SlideTimeRemainder = 0.0f;
+
+	FVector_NetQuantize100 SlideExtrapolation;
+
+	virtual void ServerFillResponseData(const UCharacterMovementComponent& CharacterMovement, const FClientAdjustment& PendingAdjustment) override;
+
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap) override;
+};
+
+class FNetworkPredictionData_Client_TPPCharacter : public FNetworkPredictionData_Client_Character
+{
+public:
+
+	typedef FNetworkPredictionData_Client_Character Super;
+
+	FNetworkPredictionData_Client_TPPCharacter(const UCharacterMovementComponent& ClientMovement) : Super(ClientMovement) {}
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
+
 /**
  * 
  */
@@ -20,6 +107,10 @@ class THIRDPERSONPROJECT_API UTPPMovementComponent : public UCharacterMovementCo
 {
 	GENERATED_BODY()
 
+	friend class FSavedMove_TPPCharacter;
+	friend struct FTPPCharacterNetworkMoveData;
+	friend struct FTPPCharacterMoveResponseDataContainer;
+
 	UTPPMovementComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 public:
@@ -45,9 +136,26 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "CustomMovement|Sliding")
 	float EndSlideSpeed;
 
+	/** Friction applied while sliding, proportional to the current slide speed */
 	UPROPERTY(EditDefaultsOnly, Category = "CustomMovement|Sliding")
 	float SlidingFriction;
 
+	/** Constant friction deceleration applied while sliding, regardless of speed */
+	UPROPERTY(EditDefaultsOnly, Category = "CustomMovement|Sliding")
+	float SlidingFrictionDeceleration;
+
+	/** Max speed that sliding down a slope can reach */
+	UPROPERTY(EditDefaultsOnly, Category = "CustomMovement|Sliding")
+	float MaxSlideSpeed;
+
+	/** Fixed time step for slide integration. Slides are frame rate independent as long as this is constant. */
+	UPROPERTY(EditDefaultsOnly, Category = "CustomMovement|Sliding", meta = (ClampMin = "0.001", UIMin = "0.001"))
+	float SlideFixedTimeStep;
+
+	/** Fraction of movement input acceleration that turns the slide. Steering changes direction but never adds speed. */
+	UPROPERTY(EditDefaultsOnly, Category = "CustomMovement|Sliding", meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float SlideSteeringScale;
+
 public:
 
 	/** Friction (Air drag) value */
@@ -58,6 +166,10 @@ public:
 
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	virtual void SetUpdatedComponent(USceneComponent* NewUpdatedComponent) override;
+
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+
 protected:
 
 	virtual void BeginPlay() override;
@@ -68,8 +180,17 @@ protected:
 
 	void PhysSlide(float DeltaTime, int32 Iterations);
 
+	/** Integrates a single fixed slide step. Returns false if the slide ended or the character left the floor. */
+	bool PhysSlideStep(float TimeStep);
+
 	virtual void OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity) override;
 
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+
+	virtual void ClientHandleMoveResponse(const FCharacterMoveResponseDataContainer& MoveResponse) override;
+
 public:
 
 	bool IsInCustomMovementMode(ECustomMovementMode MovementModeIndex) const { return MovementMode == EMovementMode::MOVE_Custom && CustomMovementMode == (uint8)MovementModeIndex; }
@@ -93,6 +214,16 @@ public:
 	UFUNCTION(BlueprintPure)
 	bool IsSliding() const;
 
+	/**
+	* Computes slide velocity after a single time step. Gravity is applied along the floor plane and friction scales with speed.
+	* Steering acceleration only turns the velocity along the floor. Kept free of any component state so the result only depends on its inputs.
+	*/
+	static FVector ComputeSlideVelocity(const FVector& InVelocity, const FVector& FloorNormal, const float GravityZ, const float FrictionCoefficient,
+		const float FrictionDeceleration, const float MaxSpeed, const FVector& SteeringAcceleration, const float TimeStep);
+
+	/** Adds DeltaTime to the carried remainder and returns how many fixed steps are due, leaving the unused time in InOutTimeRemainder */
+	static int32 ConsumeSlideSteps(float& InOutTimeRemainder, const float DeltaTime, const float FixedTimeStep);
+
 	void SlideStarted();
 	
 	void SlideEnded();
@@ -105,12 +236,14 @@ public:
 
 	virtual bool IsMovingOnGround() const override;
 
-	virtual float GetMaxBrakingDeceleration() const override;
-
 	virtual float GetMaxSpeed() const override;
 
 protected:
 
+	/** Typed character owner. Cached whenever the updated component changes */
+	UPROPERTY(Transient)
+	ATPPPlayerCharacter* TPPCharacterOwner = nullptr;
+
 	UPROPERTY(Transient)
 	float Cached2DMinimumSlidingSpeed;
 
@@ -126,6 +259,14 @@ protected:
 	UPROPERTY(Transient)
 	float CachedMaxAirSpeed = MaxWalkSpeed;
 
+	/** Slide time not yet integrated because it was less than a fixed step. Carried into the next frame and sent with corrections. */
+	UPROPERTY(Transient)
+	float SlideTimeRemainder = 0.0f;
+
+	/** Offset the capsule was moved past the last fixed step to cover SlideTimeRemainder. Undone before the next steps are taken. */
+	UPROPERTY(Transient)
+	FVector SlideExtrapolation = FVector::ZeroVector;
+
 public:
 
 	UFUNCTION(Server, Reliable)
@@ -140,13 +281,48 @@ public:
 	UFUNCTION(NetMulticast, Reliable)
 	void SetUseControllerDesiredRotation(const bool bShouldUseDesiredRotation);
 
-	UFUNCTION(Server, Reliable)
-	void ServerAddRootMotionSource(const FRootMotionSource_ConstantForce& RootMotionSource);
+	/**
+	* Starts the root motion source of a special move on the next movement update. The source is built from the move's class defaults,
+	* and the move is sent with each saved move so the server starts it on the same move rather than trusting client physics values.
+	*/
+	void StartRootMotionMove(TSubclassOf<UTPPSpecialMove> MoveClass, const FVector& Direction, uint16 PredictionKey = 0);
 
-	UFUNCTION(Server, Reliable)
-	void ServerEndRootMotionSource(const FName& SourceName);
+	/** Removes the current root motion move's source on the next movement update if it hasn't already run out */
+	void StopRootMotionMove();
+
+	/** Key of the predicted ability activation that started the current root motion move, or 0 */
+	uint16 GetRootMotionMovePredictionKey() const { return RootMotionMoveClass ? RootMotionMovePredictionKey : 0; }
+
+protected:
+
+	/** Special move whose root motion source should be running. Set locally by the owning client and from move data on the server. */
+	UPROPERTY(Transient)
+	TSubclassOf<UTPPSpecialMove> RootMotionMoveClass;
+
+	UPROPERTY(Transient)
+	FVector RootMotionMoveDirection = FVector::ZeroVector;
+
+	/** Incremented each time a root motion move starts so back to back moves of the same class are told apart */
+	UPROPERTY(Transient)
+	uint8 RootMotionMoveId = 0;
+
+	/** Sent with the move so the server ignores root motion moves from rejected ability activations */
+	UPROPERTY(Transient)
+	uint16 RootMotionMovePredictionKey = 0;
+
+	/** Id of the last root motion move whose source was applied */
+	UPROPERTY(Transient)
+	uint8 AppliedRootMotionMoveId = 0;
+
+	/** Source applied for the current root motion move, or invalid once it has been removed or run out */
+	UPROPERTY(Transient)
+	uint16 AppliedRootMotionSourceID = (uint16)ERootMotionSourceID::Invalid;
+
+	FTPPCharacterNetworkMoveDataContainer TPPNetworkMoveDataContainer;
+
+	FTPPCharacterMoveResponseDataContainer TPPMoveResponseDataContainer;
+
+	/** Applies or removes the root motion move's source so it matches RootMotionMoveClass and RootMotionMoveId. Runs at the start of every move. */
+	void UpdateRootMotionMove();
 
-	UFUNCTION(Server, Reliable)
-	void ServerOverrideCharacterVelocity(const FVector& NewVelocity);
-	
 };
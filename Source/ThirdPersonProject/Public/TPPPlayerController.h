@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
 #include "Game/TPPPlayerState.h"
+#include "Debug/TPPInputRecording.h"
 #include "TPPPlayerController.generated.h"
 
 class ATPPPlayerCharacter;
@@ -19,7 +20,83 @@ enum class EPlayerInputAction : uint8
 	Crouch,
 	ADS,
 	Reload,
-	Pause
+	Pause,
+	MAX UMETA(Hidden)
+};
+
+/** Press of an input action that was blocked and is waiting to be retried */
+struct FTPPBufferedInput
+{
+	EPlayerInputAction InputAction = EPlayerInputAction::MAX;
+
+	/** World time the action was triggered */
+	float Timestamp = 0.0f;
+};
+
+/** Fixed size ring buffer of blocked input presses. Once full, the oldest press is overwritten. */
+struct FTPPInputBuffer
+{
+	static constexpr int32 Capacity = 8;
+
+	void Add(EPlayerInputAction InputAction, float Timestamp)
+	{
+		if (NumInputs == Capacity)
+		{
+			PopOldest();
+		}
+
+		FTPPBufferedInput& BufferedInput = Inputs[(FirstIndex + NumInputs) % Capacity];
+		BufferedInput.InputAction = InputAction;
+		BufferedInput.Timestamp = Timestamp;
+		++NumInputs;
+	}
+
+	const FTPPBufferedInput& GetOldest() const { check(NumInputs > 0); return Inputs[FirstIndex]; }
+
+	void PopOldest()
+	{
+		check(NumInputs > 0);
+		FirstIndex = (FirstIndex + 1) % Capacity;
+		--NumInputs;
+	}
+
+	int32 Num() const { return NumInputs; }
+
+	void Reset() { FirstIndex = 0; NumInputs = 0; }
+
+private:
+
+	TStaticArray<FTPPBufferedInput, Capacity> Inputs;
+
+	int32 FirstIndex = 0;
+
+	int32 NumInputs = 0;
+};
+
+/** Settings and hold state of a single input action */
+struct FTPPInputActionState
+{
+	/** Time the action must be held before triggering. Zero triggers on press. */
+	float HoldTime = 0.0f;
+
+	float BufferWindow = 0.0f;
+
+	/** World time the action was last pressed */
+	float PressTime = 0.0f;
+
+	bool bIsPressed = false;
+
+	/** True once a held action has triggered for the current press */
+	bool bHoldTriggered = false;
+};
+
+/** Enum detailing whether input is being recorded or replayed */
+UENUM()
+enum class ETPPInputRecordingMode : uint8
+{
+	None,
+	Recording,
+	Replaying
 };
 
 /**
@@ -40,6 +117,14 @@ public:
 
 	virtual void UpdateRotation(float DeltaTime);
 
+	virtual void SetPawn(APawn* InPawn) override;
+
+	virtual void InitPlayerState() override;
+
+	virtual void OnRep_PlayerState() override;
+
+	virtual void CleanupPlayerState() override;
+
 	/** Threshold of axis value to begin weapon fire */
 	UPROPERTY(EditDefaultsOnly, meta = (ClampMax = "1.0", UIMax = "1.0", ClampMin = "0.0", UIMin = "0.0"))
 	float FireWeaponThreshold = .8f;
@@ -48,18 +133,38 @@ public:
 	UPROPERTY(EditDefaultsOnly, meta = (ClampMin = "0.0", UIMin = "0.0"))
 	float HoldKeyThreshold = .5f;
 
+	/** Buffer window for jump, reload and the movement ability unless the input properties override it */
+	UPROPERTY(EditDefaultsOnly, meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float InputBufferWindow = .2f;
+
 protected:
 
 	// Direction the player intends to move based on keys held.
 	UPROPERTY(Transient, Replicated)
 	FVector DesiredMovementDirection;
 
+	/** Desired movement direction last sent to the server */
+	UPROPERTY(Transient)
+	FVector LastSentDesiredMovementDirection = FVector::ZeroVector;
+
 	UPROPERTY(Transient)
 	bool bIsMovementInputEnabled = true;
 
-	/** Map of keys that are held down */
+	/** Last value received from the fire weapon axis */
 	UPROPERTY(Transient)
-	TMap<EPlayerInputAction, float> KeyHoldTimers;
+	float FireWeaponAxisValue = 0.0f;
+
+	/** Platform time the fire weapon axis was last processed past the fire threshold. Start of a shot's latency trace. */
+	double LastFireInputTime = 0.0;
+
+	/** Hold state and buffer settings of each input action, indexed by EPlayerInputAction */
+	TStaticArray<FTPPInputActionState, (uint32)EPlayerInputAction::MAX> InputActionStates;
+
+	/** Presses blocked by a special move, oldest first */
+	FTPPInputBuffer InputBuffer;
+
+	/** Set when a special move ends, so buffered input is retried on the next tick instead of from inside the move's end */
+	bool bWantsToConsumeBufferedInput = false;
 
 	/** Replicated control rotation. Updated on the server for use on client machines */
 	UPROPERTY(Replicated)
@@ -76,13 +181,35 @@ protected:
 	// Required network scaffolding
 	void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
-	/** Ticks all key hold timers */
+	/** Triggers held actions whose hold time has been reached */
 	void TickKeyHoldTimers(float DeltaTime);
 
+	/** Caches hold and buffer settings from the input properties asset */
+	void InitInputActionStates();
+
+	/** Triggers the action, or starts timing it if it must be held */
+	void HandleInputActionPressed(EPlayerInputAction InputAction);
+
+	void HandleInputActionReleased(EPlayerInputAction InputAction);
+
+	/** Triggers the action, buffering it if a special move blocked it */
+	void TriggerInputAction(EPlayerInputAction InputAction);
+
+	/** Performs the action on the character. Returns false if it was blocked. */
+	bool ExecuteInputAction(EPlayerInputAction InputAction);
+
+	/** Retries buffered presses still inside their buffer window, oldest first, until a special move blocks them again */
+	void ConsumeBufferedInput();
+
+	virtual void ProcessPlayerInput(const float DeltaTime, const bool bGamePaused) override;
+
 public:
 
 	void SetMovementInputEnabled(bool bIsEnabled);
 
+	/** Called by the owning character when its current special move ends */
+	void OnBlockingSpecialMoveEnded() { bWantsToConsumeBufferedInput = true; }
+
 	UFUNCTION(BlueprintPure)
 	FVector GetDesiredMovementDirection() const { return DesiredMovementDirection.GetSafeNormal2D(); }
 
@@ -98,6 +225,11 @@ public:
 
 	FRotator GetReplicatedControlRotation() const { return ReplicatedControlRotation; }
 
+	/** Returns true if the fire weapon axis is held past the fire threshold */
+	bool IsFireWeaponAxisHeld() const { return FireWeaponAxisValue >= FireWeaponThreshold; }
+
+	double GetLastFireInputTime() const { return LastFireInputTime; }
+
 protected:
 
 	virtual void AddYawInput(float value) override;
@@ -137,6 +269,9 @@ protected:
 	UFUNCTION()
 	void OnMovementAbilityPressed();
 
+	UFUNCTION()
+	void OnMovementAbilityReleased();
+
 	UFUNCTION()
 	void HandleWeaponFireAxis(float value);
 
@@ -146,15 +281,24 @@ protected:
 	UFUNCTION()
 	void OnAimWeaponReleased();
 
+	/** Turns the view to the best lock-on target in front of the camera, if there is one */
+	void SnapAimToLockOnTarget();
+
 	UFUNCTION()
 	void OnReloadPressed();
 
+	UFUNCTION()
+	void OnReloadReleased();
+
 	UFUNCTION()
 	void OnPausePressed();
 
+	/** Starts timing an executed jump or ability press until the movement it causes. Returns the sequence ID, or 0 if latency isn't traced. */
+	uint16 BeginMovementLatencySequence();
+
 public:
 
-	ATPPPlayerCharacter* GetOwnerCharacter();
+	ATPPPlayerCharacter* GetOwnerCharacter() const { return CachedOwnerCharacter; }
 
 protected:
 
@@ -204,5 +348,113 @@ public:
 
 public:
 
-	ATPPPlayerState* GetTPPPlayerState() { return Cast<ATPPPlayerState>(PlayerState); }
+	ATPPPlayerState* GetTPPPlayerState() const { return CachedTPPPlayerState; }
+
+protected:
+
+	/** Typed player state. Cached when the player state is created or replicated */
+	UPROPERTY(Transient)
+	ATPPPlayerState* CachedTPPPlayerState = nullptr;
+
+public:
+
+	/** Starts recording input to the given file. Recording is saved when stopped. */
+	UFUNCTION(Exec)
+	void TPPRecordInput(const FString& Filename);
+
+	UFUNCTION(Exec)
+	void TPPStopRecordingInput();
+
+	/**
+	* Replays a recording on a freshly spawned character and compares the resulting location and velocity against the recorded trace.
+	* Travels to the recorded map first if needed. Only runs with authority, so standalone or as a listen server host.
+	* Run headless with -game -nullrhi -TPPReplayExit -ExecCmds="TPPReplayInput <File>" to use as a movement regression check or benchmark.
+	* With -TPPReplayExit the game exits once the replay ends, returning 1 if it failed or diverged.
+	*/
+	UFUNCTION(Exec)
+	void TPPReplayInput(const FString& Filename);
+
+	/** Location difference allowed before a replayed frame is considered divergent */
+	UPROPERTY(EditDefaultsOnly, Category = "Input Recording")
+	float ReplayLocationTolerance = 1.0f;
+
+	/** Velocity difference allowed before a replayed frame is considered divergent */
+	UPROPERTY(EditDefaultsOnly, Category = "Input Recording")
+	float ReplayVelocityTolerance = 1.0f;
+
+	/** Logs shot and movement latency histograms for this machine and adds them to the CSV profile */
+	UFUNCTION(Exec)
+	void TPPDumpLatency();
+
+	UFUNCTION(Exec)
+	void TPPResetLatency();
+
+	/**
+	* Logs the replicated actors the server considers each net tick and how many are dormant, split out for pickups and weapons.
+	* Only does anything with authority. On a dedicated server run it from a client with ServerExec TPPDumpNetObjects.
+	*/
+	UFUNCTION(Exec)
+	void TPPDumpNetObjects();
+
+	/**
+	* Logs average and worst frame time and resident memory over the given number of frames, such as 1800. Use to compare server builds.
+	* On a dedicated server run it from a client with ServerExec TPPCaptureFramePerf <Frames>.
+	*/
+	UFUNCTION(Exec)
+	void TPPCaptureFramePerf(int32 NumFrames);
+
+	/** Logs the average and worst Slate tick time, which covers HUD prepass and paint, over the given number of frames, such as 600 */
+	UFUNCTION(Exec)
+	void TPPCaptureSlateTiming(int32 NumFrames);
+
+protected:
+
+	UPROPERTY(Transient)
+	ETPPInputRecordingMode InputRecordingMode = ETPPInputRecordingMode::None;
+
+	/** Recording currently being written or replayed */
+	UPROPERTY(Transient)
+	FTPPInputRecording InputRecording;
+
+	/** Frame currently being recorded. Committed once the pawn has moved with its input. */
+	UPROPERTY(Transient)
+	FTPPRecordedInputFrame PendingInputFrame;
+
+	UPROPERTY(Transient)
+	bool bHasPendingInputFrame = false;
+
+	UPROPERTY(Transient)
+	FString InputRecordingFilename;
+
+	/** Index of the next frame to replay */
+	UPROPERTY(Transient)
+	int32 ReplayFrameIndex = 0;
+
+	UPROPERTY(Transient)
+	int32 ReplayFirstDivergentFrame = INDEX_NONE;
+
+	UPROPERTY(Transient)
+	float ReplayMaxLocationError = 0.0f;
+
+	UPROPERTY(Transient)
+	float ReplayMaxVelocityError = 0.0f;
+
+	UPROPERTY(Transient)
+	double ReplayStartRealTime = 0.0;
+
+	/** Adds the current pawn state to the pending frame and commits it to the recording */
+	void CommitPendingInputFrame();
+
+	/** Compares pawn state to the last replayed frame, then applies input from the next one */
+	void ReplayInputFrame();
+
+	void FinishInputReplay();
+
+	/** Starts a replay requested before travelling to the recorded map */
+	void StartPendingInputReplay();
+
+	/** Replaces the current pawn with a new character at the recording's start so no crouch, slide, aim or special move state carries over */
+	bool SpawnReplayCharacter();
+
+	void RecordInputAction(EPlayerInputAction Action, bool bPressed);
 };
@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "TPPTargetField.generated.h"
+
+class UInstancedStaticMeshComponent;
+class USphereComponent;
+
+/**
+ * Grid of targets oscillating like ABaseEnemy, for aim and weapon stress tests.
+ * Target state is kept in contiguous arrays and updated four targets at a time, then rendered as instances of a single mesh.
+ * Instances have no collision. A small pool of sphere colliders follows the targets closest to players instead.
+ */
+UCLASS()
+class THIRDPERSONPROJECT_API ATPPTargetField : public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	ATPPTargetField();
+
+	virtual void Tick(float DeltaTime) override;
+
+	int32 GetNumTargets() const { return NumTargets; }
+
+	/** Returns the current world location of a target */
+	FVector GetFieldTargetLocation(int32 TargetIndex) const;
+
+protected:
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(VisibleAnywhere)
+	UInstancedStaticMeshComponent* TargetInstances;
+
+	UPROPERTY(EditAnywhere, Category = "Targets", meta = (ClampMin = "0", UIMin = "0"))
+	int32 NumTargets = 1000;
+
+	UPROPERTY(EditAnywhere, Category = "Targets", meta = (ClampMin = "1", UIMin = "1"))
+	int32 TargetsPerRow = 50;
+
+	UPROPERTY(EditAnywhere, Category = "Targets")
+	float TargetSpacing = 300.0f;
+
+	/** Seed for target amplitudes, periods and phases. The same seed gives the same field on every machine. */
+	UPROPERTY(EditAnywhere, Category = "Targets")
+	int32 RandomSeed = 0;
+
+	UPROPERTY(EditAnywhere, Category = "Movement")
+	float MinAmplitude = 100.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Movement")
+	float MaxAmplitude = 300.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Movement")
+	float MinPeriodScale = .5f;
+
+	UPROPERTY(EditAnywhere, Category = "Movement")
+	float MaxPeriodScale = 2.0f;
+
+	/** Targets within this distance of a player pawn are given a collider */
+	UPROPERTY(EditAnywhere, Category = "Collision")
+	float ColliderActivationDistance = 3000.0f;
+
+	/** Max targets with colliders at once. The closest targets win. */
+	UPROPERTY(EditAnywhere, Category = "Collision", meta = (ClampMin = "0", UIMin = "0"))
+	int32 MaxColliders = 64;
+
+	UPROPERTY(EditAnywhere, Category = "Collision")
+	float ColliderRadius = 50.0f;
+
+	/** Time between reassigning colliders to the targets nearest players. Assigned colliders follow their targets every tick. */
+	UPROPERTY(EditAnywhere, Category = "Collision")
+	float ColliderAssignmentInterval = .1f;
+
+	UPROPERTY(Transient)
+	TArray<USphereComponent*> ColliderPool;
+
+	/** Target each collider follows, or INDEX_NONE if unused */
+	TArray<int32> ColliderTargetIndices;
+
+	/** Target state, padded to a multiple of four with zero amplitude entries */
+	TArray<float> BaseLocationsX;
+	TArray<float> BaseLocationsY;
+	TArray<float> BaseLocationsZ;
+	TArray<float> Amplitudes;
+	TArray<float> PeriodScales;
+	TArray<float> Phases;
+
+	/** Current offset of each target along the field's Y axis */
+	TArray<float> Offsets;
+
+	/** Reused instance transforms passed to the instanced mesh */
+	TArray<FTransform> InstanceTransforms;
+
+	float TimeUntilColliderAssignment = 0.0f;
+
+	void InitializeTargets();
+
+	/** Computes every target offset for the given time */
+	void UpdateOffsets(float WorldTime);
+
+	/** Returns the server world time, falling back to local world time before the game state has replicated. Keeps targets where the server traces against them. */
+	float GetServerWorldTimeSeconds() const;
+
+	/** Gives the pooled colliders to the targets closest to player pawns */
+	void AssignColliders();
+
+	void UpdateColliders();
+};
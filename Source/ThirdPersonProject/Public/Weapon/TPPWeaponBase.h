@@ -13,6 +13,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnWeaponAmmoUpdated);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnWeaponDamageActor, const FHitResult&, HitResult, const float, DamageApplied);
 
 class ATPPPlayerCharacter;
+class ATPPWeaponBase;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWeaponOwnerChanged, ATPPWeaponBase*, ATPPPlayerCharacter*);
 
 UENUM(BlueprintType)
 enum class EWeaponAmmoType : uint8
@@ -35,7 +38,7 @@ struct FTPPWeaponImpactProperties
 
 	/** Weapon hit material to apply */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
-	UMaterial* WeaponHitMaterial = nullptr;
+	TSoftObjectPtr<UMaterial> WeaponHitMaterial;
 
 	/** Size of weapon hit decal */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
@@ -100,7 +103,7 @@ public:
 
 	/** Sound to play when firing */
 	UPROPERTY(EditDefaultsOnly, Category = "Weapon|Audio")
-	USoundWave* WeaponFireSound;
+	TSoftObjectPtr<USoundWave> WeaponFireSound;
 
 protected:
 
@@ -128,6 +131,8 @@ public:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 protected:
 
 	// Required network scaffolding
@@ -141,6 +146,11 @@ protected:
 
 public:
 
+	/** Called on the server when any weapon is equipped, or dropped with a null owner. Lets the replication graph tie weapons to their owner's relevancy. */
+	static FOnWeaponOwnerChanged OnWeaponOwnerChanged;
+
+	ATPPPlayerCharacter* GetCharacterOwner() const { return CharacterOwner; }
+
 	UFUNCTION(BlueprintCallable, Server, Reliable)
 	virtual void ServerEquip(ATPPPlayerCharacter* NewWeaponOwner);
 
@@ -153,11 +163,17 @@ public:
 	UFUNCTION()
 	virtual void OnRep_CharacterOwner();
 
+	/** Adds the soft referenced assets this weapon needs once equipped */
+	virtual void GetStreamedAssets(TArray<FSoftObjectPath>& OutAssets) const;
+
 protected:
 
 	UFUNCTION(NetMulticast, Reliable)
 	void ClientWeaponEquipped();
 
+	/** Streams this weapon's assets in as players approach while it is unowned */
+	void RegisterProximityPreload();
+
 	virtual void ClientWeaponEquipped_Implementation();
 
 public:
@@ -171,6 +187,9 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void SetWeaponReady(bool bWeaponReady);
 
+	UFUNCTION(BlueprintPure)
+	bool IsWeaponReady() const { return bIsWeaponReady; }
+
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent)
 	bool CanFireWeapon() const;
 
@@ -191,13 +210,14 @@ protected:
 
 protected:
 
+	/** Shot sequence IDs are only used to trace shot latency. 0 if the shot isn't traced. */
 	UFUNCTION(Client, Reliable)
-	void OnWeaponHit(const FHitResult& HitResult, const float DamageApplied);
+	void OnWeaponHit(const FHitResult& HitResult, const float DamageApplied, uint16 ShotSequenceId = 0);
 
-	void OnWeaponHit_Implementation(const FHitResult& HitResult, const float DamageApplied);
+	void OnWeaponHit_Implementation(const FHitResult& HitResult, const float DamageApplied, uint16 ShotSequenceId);
 
 	UFUNCTION(Server, Reliable)
-	void ApplyWeaponPointDamage(const FHitResult& HitResult, const FVector& StartingLocation);
+	void ApplyWeaponPointDamage(const FHitResult& HitResult, const FVector& StartingLocation, uint16 ShotSequenceId = 0);
 
 	void ApplyWeaponBlastDamage(const FVector& BlastCenter);
 
@@ -6,6 +6,8 @@
 #include "Weapon/TPPWeaponBase.h"
 #include "TPPWeaponFirearm.generated.h"
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWeaponSpreadChanged, float, SpreadAngle);
+
 /** Hit logic to use for this weapon */
 UENUM(BlueprintType)
 enum class EWeaponHitType : uint8
@@ -85,19 +87,19 @@ public:
 
 	/** Weapon fire montage to be played by owning character */
 	UPROPERTY(EditDefaultsOnly, Category = "Weapon|Animation", BlueprintReadOnly)
-	UAnimMontage* WeaponFireCharacterMontage;
+	TSoftObjectPtr<UAnimMontage> WeaponFireCharacterMontage;
 
 	/** Weapon fire montage to be played when aiming. */
 	UPROPERTY(EditDefaultsOnly, Category = "Weapon|Animation", BlueprintReadOnly)
-	UAnimMontage* WeaponFireADSCharacterMontage;
+	TSoftObjectPtr<UAnimMontage> WeaponFireADSCharacterMontage;
 
 	/** Weapon reload montage to be played by owning character */
 	UPROPERTY(EditDefaultsOnly, Category = "Weapon|Animation")
-	UAnimMontage* WeaponReloadCharacterMontage;
+	TSoftObjectPtr<UAnimMontage> WeaponReloadCharacterMontage;
 
 	/** Weapon trail effect to spawn after firing */
 	UPROPERTY(EditDefaultsOnly, Category = "Weapon|FX")
-	UParticleSystem* WeaponTrailEffect = nullptr;
+	TSoftObjectPtr<UParticleSystem> WeaponTrailEffect;
 
 	/** param name for trace target location */
 	UPROPERTY(EditDefaultsOnly, Category = Effects)
@@ -145,7 +147,7 @@ protected:
 
 	/** Server method to call when firing hitscan weapon. Should account for delay between client and server. */
 	UFUNCTION(Server, Reliable)
-	void ServerHitscanFire(const FHitResult& ClientHitResult);
+	void ServerHitscanFire(const FHitResult& ClientHitResult, uint16 ShotSequenceId);
 
 	/** Multicast for firing a weapon. Should include server calculated hit result. */
 	UFUNCTION(NetMulticast, Reliable)
@@ -156,6 +158,8 @@ protected:
 
 public:
 
+	virtual void GetStreamedAssets(TArray<FSoftObjectPath>& OutAssets) const override;
+
 	/** Starts the reload process and animation */
 	virtual void StartWeaponReload() override;
 
@@ -172,6 +176,13 @@ protected:
 	UPROPERTY(Transient, Replicated)
 	float CurrentWeaponSpreadAngle;
 
+	/** Minimum spread change in degrees before OnWeaponSpreadChanged is broadcast */
+	UPROPERTY(EditDefaultsOnly, Category = "Weapon|Firing|Spread")
+	float SpreadChangeNotifyThreshold = .05f;
+
+	/** Spread angle last broadcast by OnWeaponSpreadChanged */
+	float LastNotifiedSpreadAngle = -1.0f;
+
 	/** Calculates weapon spread based on movement parameters */
 	void UpdateWeaponSpreadRadius();
 
@@ -193,4 +204,8 @@ public:
 
 	UFUNCTION(BlueprintPure)
 	float GetWeaponSpreadAngle() const { return CurrentWeaponSpreadAngle; }
+
+	/** Called when spread changes by more than the notify threshold, or settles on a new value */
+	UPROPERTY(BlueprintAssignable)
+	FOnWeaponSpreadChanged OnWeaponSpreadChanged;
 };
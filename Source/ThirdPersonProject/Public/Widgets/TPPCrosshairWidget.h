@@ -10,7 +10,9 @@
 #include "TPPCrosshairWidget.generated.h"
 
 /**
- * 
+ * Crosshair painted natively from the observed weapon's spread.
+ * Only invalidated when the weapon hits or its spread changes past the weapon's notify threshold, so it can be cached inside an invalidation box.
+ * Firing repaints it through the spread change the shot causes, not the fire event itself.
  */
 UCLASS()
 class THIRDPERSONPROJECT_API UTPPCrosshairWidget : public UUserWidget, public ITPPWeaponObserver
@@ -26,8 +28,62 @@ public:
 
 	void SetObservedWeapon(ATPPWeaponBase* WeaponToObserve);
 
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
 protected:
 
+	virtual void NativeDestruct() override;
+
+	UPROPERTY(EditAnywhere, Category = "Crosshair")
+	FLinearColor CrosshairColor = FLinearColor::White;
+
+	UPROPERTY(EditAnywhere, Category = "Crosshair")
+	float CrosshairLineLength = 10.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Crosshair")
+	float CrosshairLineThickness = 2.0f;
+
+	/** Gap between the center and each line with no spread */
+	UPROPERTY(EditAnywhere, Category = "Crosshair")
+	float CrosshairMinGap = 4.0f;
+
+	/** Extra gap per degree of weapon spread */
+	UPROPERTY(EditAnywhere, Category = "Crosshair")
+	float CrosshairGapPerSpreadDegree = 12.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Crosshair|Hit Marker")
+	FLinearColor HitMarkerColor = FLinearColor::Red;
+
+	/** Half size of the hit marker's diagonal lines */
+	UPROPERTY(EditAnywhere, Category = "Crosshair|Hit Marker")
+	float HitMarkerSize = 8.0f;
+
+	UPROPERTY(EditAnywhere, Category = "Crosshair|Hit Marker")
+	float HitMarkerDuration = .15f;
+
+	/** Spread last received from the observed weapon */
+	UPROPERTY(Transient, BlueprintReadOnly)
+	float CachedSpreadAngle = 0.0f;
+
+	bool bShowHitMarker = false;
+
+	FTimerHandle HitMarkerTimerHandle;
+
+	/** Line points built for CachedLinesSpreadAngle and CachedLinesSize, two per line */
+	mutable TArray<FVector2D> CachedCrosshairLines;
+
+	mutable float CachedLinesSpreadAngle = -1.0f;
+
+	mutable FVector2D CachedLinesSize = FVector2D::ZeroVector;
+
+	UFUNCTION()
+	void OnWeaponSpreadChanged(float SpreadAngle);
+
+	void HideHitMarker();
+
+	/** Rebuilds the crosshair lines if the spread or widget size changed since they were last built */
+	void UpdateCrosshairLines(const FVector2D& LocalSize) const;
+
 	UFUNCTION(BlueprintImplementableEvent)
 	void OnWeaponChanged();
 
@@ -10,7 +10,7 @@
 #include "TPPWeaponInfoWidget.generated.h"
 
 /**
- * 
+ * Shows the observed weapon's ammo. Ammo is cached when the weapon reports a change instead of being polled through bindings.
  */
 UCLASS()
 class THIRDPERSONPROJECT_API UTPPWeaponInfoWidget : public UUserWidget, public ITPPWeaponObserver
@@ -31,6 +31,21 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent)
 	void OnWeaponChanged();
 
+	/** Called when the cached ammo counts change. Blueprints should update their text here rather than binding to the weapon. */
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnAmmoChanged();
+
+	UPROPERTY(Transient, BlueprintReadOnly)
+	int32 CachedLoadedAmmo = 0;
+
+	UPROPERTY(Transient, BlueprintReadOnly)
+	int32 CachedPooledAmmo = 0;
+
+	/** Caches the observed weapon's ammo and notifies blueprints if it changed */
+	void RefreshAmmo();
+
+	virtual void NativeDestruct() override;
+
 	virtual void OnWeaponFired_Implementation();
 
 	virtual void OnWeaponReloaded_Implementation();
@@ -22,7 +22,24 @@
 #include "TPPBlueprintFunctionLibrary.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Engine/ActorChannel.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "Game/TPPSignificanceSubsystem.h"
+#include "Game/TPPRagdollSubsystem.h"
+#include "Game/TPPSpecialMoveSubsystem.h"
+#include "Game/TPPPickupSubsystem.h"
+#include "Debug/TPPLatencySubsystem.h"
+#include "Game/TPPAssetStreamingSubsystem.h"
+#include "ThirdPersonProject.h"
+#include "Debug/TPPStartupProfiler.h"
+#include "TPPAnimInstance.h"
+
+DECLARE_CYCLE_STAT(TEXT("Character Tick"), STAT_TPPCharacterTick, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Special Moves Allocated"), STAT_TPPSpecialMovesAllocated, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Special Moves Reused"), STAT_TPPSpecialMovesReused, STATGROUP_ThirdPersonProject);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Capability Updates"), STAT_TPPCapabilityUpdates, STATGROUP_ThirdPersonProject);
 
 ATPPPlayerCharacter::ATPPPlayerCharacter(const FObjectInitializer& ObjectInitialzer) :
 	Super(ObjectInitialzer.SetDefaultSubobjectClass<UTPPMovementComponent>(ACharacter::CharacterMovementComponentName))
@@ -65,13 +82,63 @@ ATPPPlayerCharacter::ATPPPlayerCharacter(const FObjectInitializer& ObjectInitial
 	HealthRegenTime = 2.1f;
 }
 
+void ATPPPlayerCharacter::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	CachedTPPMovementComponent = Cast<UTPPMovementComponent>(GetCharacterMovement());
+
+	// Class defaults are the same on every machine, so indices into this array are safe to replicate.
+	ReplicatedSpecialMoveClasses.AddUnique(AutoLedgeClimbClass);
+	ReplicatedSpecialMoveClasses.AddUnique(LedgeClimbClass);
+	ReplicatedSpecialMoveClasses.AddUnique(LedgeHangClass);
+	ReplicatedSpecialMoveClasses.AddUnique(WallRunClass);
+	ReplicatedSpecialMoveClasses.Remove(nullptr);
+
+	UpdateCapabilities();
+}
+
 void ATPPPlayerCharacter::BeginPlay()
 {
+	FTPPScopedStartupTimer StartupTimer(this);
 	Super::BeginPlay();
 
+	UpdateCachedControllerReferences();
+
+#if !UE_BUILD_SHIPPING
+	const UAnimInstance* AnimInstance = GetMesh() ? GetMesh()->GetAnimInstance() : nullptr;
+	if (AnimInstance && !AnimInstance->IsA<UTPPAnimInstance>())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s uses %s, which isn't a UTPPAnimInstance, so the native anim update won't run. Run the TPPReparentAnimBlueprint commandlet."),
+			*GetName(), *AnimInstance->GetClass()->GetName());
+	}
+#endif
+
+	UTPPSignificanceSubsystem* SignificanceSubsystem = UTPPSignificanceSubsystem::Get(this);
+	if (SignificanceSubsystem)
+	{
+		SignificanceSubsystem->RegisterActor(this);
+	}
+
+	UTPPPickupSubsystem* PickupSubsystem = UTPPPickupSubsystem::Get(this);
+	if (PickupSubsystem)
+	{
+		PickupSubsystem->RegisterCharacter(this);
+	}
+
+	if (FTPPStartupProfiler::ShouldDeferStartupInit())
+	{
+		GetWorldTimerManager().SetTimerForNextTick(this, &ATPPPlayerCharacter::RequestStreamedAssets);
+	}
+	else
+	{
+		RequestStreamedAssets();
+	}
+
 	if (HasAuthority())
 	{
 		CurrentAnimationBlendSlot = EAnimationBlendSlot::None;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, CurrentAnimationBlendSlot, this);
 
 		UCharacterMovementComponent* MovementComp = GetTPPMovementComponent();
 		if (MovementComp)
@@ -80,6 +147,7 @@ void ATPPPlayerCharacter::BeginPlay()
 		}
 
 		CurrentAbility = MovementAbilityClass ? NewObject<UTPPAbilityBase>(this, MovementAbilityClass) : nullptr;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, CurrentAbility, this);
 		if (CurrentAbility)
 		{
 			CurrentAbility->SetOwningCharacter(this);
@@ -89,10 +157,10 @@ void ATPPPlayerCharacter::BeginPlay()
 		ServerStopAiming();
 		SetWallMovementState(EWallMovementState::None);
 
-		bShouldRegenHealth = false;
 		CachedHealthRegenDelta = MaxHealth / HealthRegenTime;
 	}
 
+#if TPP_WITH_COSMETICS
 	ATPPPlayerController* PlayerController = GetTPPPlayerController();
 	if (PlayerController)
 	{
@@ -106,33 +174,113 @@ void ATPPPlayerCharacter::BeginPlay()
 			}
 		}
 	}
+#endif
+}
+
+void ATPPPlayerCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UTPPSignificanceSubsystem* SignificanceSubsystem = UTPPSignificanceSubsystem::Get(this);
+	if (SignificanceSubsystem)
+	{
+		SignificanceSubsystem->UnregisterActor(this);
+	}
+
+	UTPPRagdollSubsystem* RagdollSubsystem = UTPPRagdollSubsystem::Get(this);
+	if (RagdollSubsystem)
+	{
+		RagdollSubsystem->UnregisterRagdoll(GetMesh());
+	}
+
+	UTPPSpecialMoveSubsystem* SpecialMoveSubsystem = UTPPSpecialMoveSubsystem::Get(this);
+	if (SpecialMoveSubsystem && CurrentSpecialMove)
+	{
+		SpecialMoveSubsystem->UnregisterSpecialMove(CurrentSpecialMove);
+	}
+
+	UTPPPickupSubsystem* PickupSubsystem = UTPPPickupSubsystem::Get(this);
+	if (PickupSubsystem)
+	{
+		PickupSubsystem->UnregisterCharacter(this);
+	}
+
+	UTPPAssetStreamingSubsystem* StreamingSubsystem = UTPPAssetStreamingSubsystem::Get(this);
+	if (StreamingSubsystem)
+	{
+		StreamingSubsystem->ReleaseAssets(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ATPPPlayerCharacter::RequestStreamedAssets()
+{
+	FTPPScopedStartupTimer StartupTimer(TEXT("Request Streamed Assets"));
+
+	UTPPAssetStreamingSubsystem* StreamingSubsystem = UTPPAssetStreamingSubsystem::Get(this);
+	if (!StreamingSubsystem)
+	{
+		return;
+	}
+
+	TArray<FSoftObjectPath> StreamedAssets;
+#if TPP_WITH_COSMETICS
+	StreamedAssets.Add(HitReactions.HeadHitReactMontage.ToSoftObjectPath());
+	StreamedAssets.Add(HitReactions.UpperBodyHitReactMontage.ToSoftObjectPath());
+#endif
+
+	TArray<UClass*, TInlineAllocator<16>> SpecialMoveClasses = { DeathSpecialMove, LedgeHangClass, AutoLedgeClimbClass, LedgeClimbClass, WallRunClass };
+	for (const TSubclassOf<UTPPSpecialMove>& SpecialMoveClass : ReplicatedSpecialMoveClasses)
+	{
+		SpecialMoveClasses.Add(SpecialMoveClass);
+	}
+
+	for (UClass* SpecialMoveClass : SpecialMoveClasses)
+	{
+		const UTPPSpecialMove* SpecialMoveCDO = SpecialMoveClass ? SpecialMoveClass->GetDefaultObject<UTPPSpecialMove>() : nullptr;
+		if (SpecialMoveCDO)
+		{
+			SpecialMoveCDO->GetStreamedAssets(StreamedAssets);
+		}
+	}
 
+	StreamingSubsystem->RequestAssets(this, StreamedAssets);
 }
 
 void ATPPPlayerCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(ATPPPlayerCharacter, bIsSprinting);
-	DOREPLIFETIME(ATPPPlayerCharacter, bIsAiming);
+	// Properties are push based, so they are only compared after being marked dirty where they are written.
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
 
-	DOREPLIFETIME(ATPPPlayerCharacter, CurrentAnimationBlendSlot);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerCharacter, bIsSprinting, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerCharacter, bIsAiming, Params);
 
-	DOREPLIFETIME(ATPPPlayerCharacter, DefaultRotationRate);
-	DOREPLIFETIME(ATPPPlayerCharacter, SprintRotationRate);
-	DOREPLIFETIME(ATPPPlayerCharacter, ADSRotationRate);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerCharacter, CurrentAnimationBlendSlot, Params);
 
-	DOREPLIFETIME(ATPPPlayerCharacter, AimRotationDelta);
-	DOREPLIFETIME(ATPPPlayerCharacter, ControllerRelativeMovementSpeed);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerCharacter, AimRotationDelta, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerCharacter, ControllerRelativeMovementSpeed, Params);
 
-	DOREPLIFETIME(ATPPPlayerCharacter, CurrentAbility);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerCharacter, CurrentAbility, Params);
 
-	DOREPLIFETIME(ATPPPlayerCharacter, WallMovementState);
-	DOREPLIFETIME(ATPPPlayerCharacter, CurrentWallMovementProperties);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerCharacter, WallMovementState, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerCharacter, CurrentWallMovementProperties, Params);
 
-	DOREPLIFETIME(ATPPPlayerCharacter, EquippedWeapon);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerCharacter, EquippedWeapon, Params);
 
-	DOREPLIFETIME(ATPPPlayerCharacter, bShouldRegenHealth);
+	FDoRepLifetimeParams SkipOwnerParams;
+	SkipOwnerParams.bIsPushBased = true;
+	SkipOwnerParams.Condition = COND_SkipOwner;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerCharacter, ReplicatedSpecialMove, SkipOwnerParams);
+
+	// Rotation rates are set in defaults and never change after spawn.
+	FDoRepLifetimeParams InitialOnlyParams;
+	InitialOnlyParams.bIsPushBased = true;
+	InitialOnlyParams.Condition = COND_InitialOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerCharacter, DefaultRotationRate, InitialOnlyParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerCharacter, SprintRotationRate, InitialOnlyParams);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ATPPPlayerCharacter, ADSRotationRate, InitialOnlyParams);
 }
 
 bool ATPPPlayerCharacter::ReplicateSubobjects(UActorChannel* Channel, FOutBunch* Bunch, FReplicationFlags* RepFlags)
@@ -146,16 +294,23 @@ bool ATPPPlayerCharacter::ReplicateSubobjects(UActorChannel* Channel, FOutBunch*
 
 void ATPPPlayerCharacter::Tick(float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_TPPCharacterTick);
+
 	Super::Tick(DeltaTime);
 
-	if (CurrentSpecialMove)
+	// Wall movement is derived from replicated state, so it's updated locally rather than sending updates every frame.
+	if (WallMovementState == EWallMovementState::WallLedgeClimb)
+	{
+		DoLedgeClimb();
+	}
+	else if (WallMovementState == EWallMovementState::WallRunUp && HasAuthority())
 	{
-		CurrentSpecialMove->Tick(DeltaTime);
+		DoWallRun();
 	}
 
 	if (IsCharacterAlive())
 	{
-		if (IsLocallyControlled() && Controller && Controller->GetClass()->IsChildOf(ATPPPlayerController::StaticClass()))
+		if (CachedTPPPlayerController && IsLocallyControlled())
 		{
 			if (bWantsToAim && !bIsAiming && CanPlayerBeginAiming())
 			{
@@ -182,25 +337,16 @@ void ATPPPlayerCharacter::Tick(float DeltaTime)
 				ServerStopSprint();
 			}
 
-			UpdateAimRotationDelta();
-			UpdateControllerRelativeMovementSpeed();
-
-			if (!GetCharacterMovement()->IsMovingOnGround())
+			// Special moves drive their own animation, so don't send aim and movement updates while one is running.
+			if (!CurrentSpecialMove)
 			{
-				ServerTryBeginWallMovement();
+				UpdateAimRotationDelta();
+				UpdateControllerRelativeMovementSpeed();
 			}
-		}
 
-		if (HasAuthority())
-		{
-			if (bShouldRegenHealth)
+			if (WallMovementState == EWallMovementState::None && !GetCharacterMovement()->IsMovingOnGround())
 			{
-				ATPPPlayerState* PS = GetTPPPlayerState();
-				if (PS)
-				{
-					ModifyHealth(CachedHealthRegenDelta * DeltaTime);
-					bShouldRegenHealth = PS->GetHealth() < MaxHealth;
-				}
+				ServerTryBeginWallMovement();
 			}
 		}
 	}
@@ -216,6 +362,7 @@ void ATPPPlayerCharacter::ServerBeginSprint_Implementation()
 	if (GetLocalRole() == ROLE_Authority)
 	{
 		bIsSprinting = true;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, bIsSprinting, this);
 		OnRep_IsSprinting();
 	}
 }
@@ -225,6 +372,7 @@ void ATPPPlayerCharacter::ServerStopSprint_Implementation()
 	if (GetLocalRole() == ROLE_Authority)
 	{
 		bIsSprinting = false;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, bIsSprinting, this);
 		OnRep_IsSprinting();
 	}
 }
@@ -247,15 +395,13 @@ void ATPPPlayerCharacter::OnRep_IsSprinting()
 
 bool ATPPPlayerCharacter::CanSprint() const
 {
-	const bool bBlockedBySpecialMove = CurrentSpecialMove && CurrentSpecialMove->bDisablesSprint;
-	const UTPPMovementComponent* MovementComp = GetTPPMovementComponent();
 	const ATPPPlayerController* PC = GetTPPPlayerController();
-	return !bBlockedBySpecialMove && !bIsAiming && MovementComp->IsMovingOnGround() && !bIsCrouched && PC->GetInputAxisValue(FName("FireWeapon")) < PC->FireWeaponThreshold;
+	return PC && HasCapabilities(ETPPCharacterCapability::Sprint) && !PC->IsFireWeaponAxisHeld();
 }
 
 bool ATPPPlayerCharacter::CanCrouch() const
 {
-	return !(CurrentSpecialMove && CurrentSpecialMove->bDisablesCrouch) && Super::CanCrouch();
+	return HasCapabilities(ETPPCharacterCapability::Crouch) && Super::CanCrouch();
 }
 
 void ATPPPlayerCharacter::Crouch(bool bIsClientSimulation)
@@ -270,7 +416,7 @@ void ATPPPlayerCharacter::Crouch(bool bIsClientSimulation)
 	}
 	else
 	{
-		UTPPMovementComponent* MovementComponent = Cast<UTPPMovementComponent>(GetCharacterMovement());
+		UTPPMovementComponent* MovementComponent = GetTPPMovementComponent();
 		if (MovementComponent)
 		{
 			if (MovementComponent->IsSliding())
@@ -291,7 +437,7 @@ void ATPPPlayerCharacter::Crouch(bool bIsClientSimulation)
 
 void ATPPPlayerCharacter::UnCrouch(bool bIsClientSimulation)
 {
-	UTPPMovementComponent* MovementComponent = Cast<UTPPMovementComponent>(GetCharacterMovement());
+	UTPPMovementComponent* MovementComponent = GetTPPMovementComponent();
 	if (MovementComponent)
 	{
 		MovementComponent->bWantsToSlide = false;
@@ -302,22 +448,23 @@ void ATPPPlayerCharacter::UnCrouch(bool bIsClientSimulation)
 void ATPPPlayerCharacter::OnStartCrouch(float HalfHeightAdjust, float ScaledHalfHeightAdjust)
 {
 	Super::OnStartCrouch(HalfHeightAdjust, ScaledHalfHeightAdjust);
+	UpdateCapabilities();
 	ServerStopSprint();
 }
 
 void ATPPPlayerCharacter::OnEndCrouch(float HalfHeightAdjust, float ScaledHalfHeightAdjust)
 {
 	Super::OnEndCrouch(HalfHeightAdjust, ScaledHalfHeightAdjust);
+	UpdateCapabilities();
 }
 
 bool ATPPPlayerCharacter::CanSlide() const
 {
-	UTPPMovementComponent* MovementComponent = Cast<UTPPMovementComponent>(GetCharacterMovement());
+	UTPPMovementComponent* MovementComponent = GetTPPMovementComponent();
 	ATPPPlayerController* PlayerController = GetTPPPlayerController();
 	if (MovementComponent && PlayerController)
 	{	
-		return MovementComponent->CanSlide() && !PlayerController->GetDesiredMovementDirection().IsNearlyZero() &&
-			!(CurrentSpecialMove && CurrentSpecialMove->bDisablesCrouch);
+		return HasCapabilities(ETPPCharacterCapability::Slide) && MovementComponent->CanSlide() && !PlayerController->GetDesiredMovementDirection().IsNearlyZero();
 	}
 
 	return false;
@@ -325,27 +472,27 @@ bool ATPPPlayerCharacter::CanSlide() const
 
 void ATPPPlayerCharacter::OnStartSlide()
 {
-	GetTPPPlayerController()->SetMovementInputEnabled(false);
+	// Movement input stays enabled so the slide can be steered.
+	UpdateCapabilities();
 }
 
 void ATPPPlayerCharacter::OnEndSlide()
 {
-	GetTPPPlayerController()->SetMovementInputEnabled(true);
+	UpdateCapabilities();
 }
 
 bool ATPPPlayerCharacter::CanJumpInternal_Implementation() const
 {
-	UTPPMovementComponent* MovementComponent = GetTPPMovementComponent();
-	const bool bBlockedBySpecialMove = CurrentSpecialMove && CurrentSpecialMove->bDisablesJump;
-	return MovementComponent && !MovementComponent->IsSliding() && !bBlockedBySpecialMove && Super::CanJumpInternal_Implementation();
+	return HasCapabilities(ETPPCharacterCapability::Jump) && Super::CanJumpInternal_Implementation();
 }
 
-void ATPPPlayerCharacter::AttemptToJump()
+bool ATPPPlayerCharacter::AttemptToJump()
 {
 	UCharacterMovementComponent* MovementComp = GetCharacterMovement();
 	if (MovementComp->IsMovingOnGround())
 	{
 		Jump();
+		return CanJump();
 	}
 	else
 	{
@@ -353,8 +500,11 @@ void ATPPPlayerCharacter::AttemptToJump()
 		if (bCanExecuteWallKick)
 		{
 			ServerDoWallKick();
+			return true;
 		}
 	}
+
+	return false;
 }
 
 void ATPPPlayerCharacter::Landed(const FHitResult& HitResult)
@@ -376,14 +526,28 @@ void ATPPPlayerCharacter::Landed(const FHitResult& HitResult)
 	Super::Landed(HitResult);
 }
 
-UTPPMovementComponent* ATPPPlayerCharacter::GetTPPMovementComponent() const
+void ATPPPlayerCharacter::UpdateCachedControllerReferences()
 {
-	return Cast<UTPPMovementComponent>(GetCharacterMovement());
+	CachedTPPPlayerController = Cast<ATPPPlayerController>(GetController());
+	CachedTPPPlayerState = Cast<ATPPPlayerState>(GetPlayerState());
 }
 
-ATPPPlayerController* ATPPPlayerCharacter::GetTPPPlayerController() const
+void ATPPPlayerCharacter::PossessedBy(AController* NewController)
 {
-	return Cast<ATPPPlayerController>(GetController());
+	Super::PossessedBy(NewController);
+	UpdateCachedControllerReferences();
+}
+
+void ATPPPlayerCharacter::UnPossessed()
+{
+	Super::UnPossessed();
+	UpdateCachedControllerReferences();
+}
+
+void ATPPPlayerCharacter::OnRep_Controller()
+{
+	Super::OnRep_Controller();
+	UpdateCachedControllerReferences();
 }
 
 void ATPPPlayerCharacter::UpdateAimRotationDelta_Implementation()
@@ -392,7 +556,12 @@ void ATPPPlayerCharacter::UpdateAimRotationDelta_Implementation()
 	const ATPPPlayerController* PC = GetTPPPlayerController();
 	if (PC)
 	{
-		AimRotationDelta = bSpecialMoveDisablesAiming ? FRotator::ZeroRotator : (PC->GetReplicatedControlRotation() - GetActorRotation());
+		const FRotator NewAimRotationDelta = bSpecialMoveDisablesAiming ? FRotator::ZeroRotator : (PC->GetReplicatedControlRotation() - GetActorRotation());
+		if (NewAimRotationDelta != AimRotationDelta)
+		{
+			AimRotationDelta = NewAimRotationDelta;
+			MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, AimRotationDelta, this);
+		}
 	}
 }
 
@@ -414,7 +583,12 @@ void ATPPPlayerCharacter::UpdateControllerRelativeMovementSpeed_Implementation()
 
 	const float ForwardSpeed = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::X) | Velocity;
 	const float RightSpeed = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::Y) | Velocity;
-	ControllerRelativeMovementSpeed = FVector(ForwardSpeed, RightSpeed, 0.0f);
+	const FVector NewMovementSpeed(ForwardSpeed, RightSpeed, 0.0f);
+	if (NewMovementSpeed != ControllerRelativeMovementSpeed)
+	{
+		ControllerRelativeMovementSpeed = NewMovementSpeed;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, ControllerRelativeMovementSpeed, this);
+	}
 }
 
 void ATPPPlayerCharacter::ResetCameraToPlayerRotation()
@@ -431,11 +605,90 @@ void ATPPPlayerCharacter::OnRep_CurrentAbility()
 
 }
 
-void ATPPPlayerCharacter::TryActivateAbility()
+bool ATPPPlayerCharacter::TryActivateAbility()
 {
 	if (!CurrentSpecialMove && CurrentAbility && CurrentAbility->CanActivate())
 	{
-		CurrentAbility->ActivateAbility();
+		return CurrentAbility->PredictActivation();
+	}
+
+	return false;
+}
+
+void ATPPPlayerCharacter::ServerActivateAbility_Implementation(uint16 PredictionKey)
+{
+	const bool bAccepted = CurrentAbility && CurrentAbility->ConfirmActivation(PredictionKey);
+	if (!bAccepted)
+	{
+		RejectPredictionKey(PredictionKey);
+	}
+	else if (PredictionKey != 0)
+	{
+		static const int32 MaxAcceptedPredictionKeys = 8;
+		if (AcceptedPredictionKeys.Num() >= MaxAcceptedPredictionKeys)
+		{
+			AcceptedPredictionKeys.RemoveAt(0, 1, false);
+		}
+		AcceptedPredictionKeys.Add(PredictionKey);
+	}
+
+	ClientAbilityActivationResult(PredictionKey, bAccepted);
+}
+
+void ATPPPlayerCharacter::RejectPredictionKey(uint16 PredictionKey)
+{
+	if (PredictionKey == 0)
+	{
+		return;
+	}
+
+	// Keys wrap around, so only the last few are kept. The client stops sending a key once it hears about the rejection.
+	static const int32 MaxRejectedPredictionKeys = 8;
+	if (RejectedPredictionKeys.Num() >= MaxRejectedPredictionKeys)
+	{
+		RejectedPredictionKeys.RemoveAt(0, 1, false);
+	}
+	RejectedPredictionKeys.Add(PredictionKey);
+
+	// The activation request is sent first, but a reordered root motion move may already have started.
+	if (ReplicatedSpecialMove.PredictionKey == PredictionKey)
+	{
+		ReplicatedSpecialMove = FTPPReplicatedSpecialMove();
+		MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, ReplicatedSpecialMove, this);
+		OnRep_ReplicatedSpecialMove();
+	}
+
+	UTPPMovementComponent* MovementComp = GetTPPMovementComponent();
+	if (MovementComp && MovementComp->GetRootMotionMovePredictionKey() == PredictionKey)
+	{
+		MovementComp->StopRootMotionMove();
+	}
+}
+
+bool ATPPPlayerCharacter::ConsumeAcceptedPredictionKey(TSubclassOf<UTPPSpecialMove> MoveClass, uint16 PredictionKey)
+{
+	const TSubclassOf<UTPPSpecialMove> AbilityMoveClass = CurrentAbility ? CurrentAbility->ActivatedSpecialMoveClass : nullptr;
+	if (PredictionKey == 0 || !MoveClass || !AbilityMoveClass || !MoveClass->IsChildOf(AbilityMoveClass))
+	{
+		return false;
+	}
+
+	return AcceptedPredictionKeys.RemoveSingle(PredictionKey) > 0;
+}
+
+void ATPPPlayerCharacter::ClientAbilityActivationResult_Implementation(uint16 PredictionKey, bool bAccepted)
+{
+	if (CurrentAbility)
+	{
+		CurrentAbility->OnActivationResult(PredictionKey, bAccepted);
+	}
+}
+
+void ATPPPlayerCharacter::RollbackPredictedSpecialMove(uint16 PredictionKey)
+{
+	if (CurrentSpecialMove && PredictionKey != 0 && CurrentSpecialMove->PredictionKey == PredictionKey && !CurrentSpecialMove->IsSimulatedMove())
+	{
+		CurrentSpecialMove->InterruptSpecialMove();
 	}
 }
 
@@ -443,7 +696,7 @@ void ATPPPlayerCharacter::ExecuteSpecialMoveByClass(TSubclassOf<UTPPSpecialMove>
 {
 	if (SpecialMoveClass)
 	{
-		UTPPSpecialMove* SpecialMove = NewObject<UTPPSpecialMove>(this, SpecialMoveClass);
+		UTPPSpecialMove* SpecialMove = AcquireSpecialMove(SpecialMoveClass);
 		if (SpecialMove)
 		{
 			ExecuteSpecialMove(SpecialMove, bShouldInterruptCurrentMove);
@@ -462,8 +715,35 @@ void ATPPPlayerCharacter::ExecuteSpecialMove(UTPPSpecialMove* SpecialMove, bool
 
 		CurrentSpecialMove = SpecialMove;
 		CurrentSpecialMove->OwningCharacter = this;
+		CurrentSpecialMove->PredictionKey = SpecialMove->IsSimulatedMove() ? 0 : ScopedPredictionKey;
 
 		CurrentSpecialMove->BeginSpecialMove();
+		UpdateCapabilities();
+
+		UTPPSpecialMoveSubsystem* SpecialMoveSubsystem = UTPPSpecialMoveSubsystem::Get(this);
+		if (SpecialMoveSubsystem && CurrentSpecialMove == SpecialMove)
+		{
+			SpecialMoveSubsystem->RegisterSpecialMove(SpecialMove);
+		}
+
+		if (CurrentSpecialMove == SpecialMove && IsLocallyControlled() && !SpecialMove->IsSimulatedMove())
+		{
+			UTPPLatencySubsystem* LatencySubsystem = UTPPLatencySubsystem::Get(this);
+			if (LatencySubsystem)
+			{
+				LatencySubsystem->MarkLatestStage(this, ETPPLatencyTrace::Movement, ETPPLatencyStage::SpecialMoveBegin);
+			}
+
+			const int32 MoveClassIndex = ReplicatedSpecialMoveClasses.IndexOfByKey(SpecialMove->GetClass());
+			if (MoveClassIndex != INDEX_NONE)
+			{
+				FTPPReplicatedSpecialMove NewReplicatedMove;
+				NewReplicatedMove.MoveClassIndex = (uint8)(MoveClassIndex + 1);
+				NewReplicatedMove.PredictionKey = SpecialMove->PredictionKey;
+				SpecialMove->GetReplicatedSpecialMoveParams(NewReplicatedMove);
+				ServerSetReplicatedSpecialMove(NewReplicatedMove);
+			}
+		}
 	}
 }
 
@@ -474,10 +754,28 @@ void ATPPPlayerCharacter::OnSpecialMoveEnded(UTPPSpecialMove* SpecialMove)
 	{
 		bOldSpecialMoveEnded = true;
 		CurrentSpecialMove = nullptr;
+		UpdateCapabilities();
+	}
+
+	UTPPSpecialMoveSubsystem* SpecialMoveSubsystem = UTPPSpecialMoveSubsystem::Get(this);
+	if (SpecialMoveSubsystem)
+	{
+		SpecialMoveSubsystem->UnregisterSpecialMove(SpecialMove);
+	}
+
+	EndedSpecialMoves.AddUnique(SpecialMove);
+	if (EndedSpecialMoves.Num() == 1)
+	{
+		GetWorldTimerManager().SetTimerForNextTick(this, &ATPPPlayerCharacter::ReleaseEndedSpecialMoves);
 	}
 
 	if (IsLocallyControlled())
 	{
+		if (bOldSpecialMoveEnded && !SpecialMove->IsSimulatedMove() && IsReplicatedSpecialMoveClass(SpecialMove->GetClass()))
+		{
+			ServerSetReplicatedSpecialMove(FTPPReplicatedSpecialMove());
+		}
+
 		if (bOldSpecialMoveEnded && DoesPlayerWantToAim() && CanPlayerBeginAiming())
 		{
 			if (!bIsAiming)
@@ -493,9 +791,172 @@ void ATPPPlayerCharacter::OnSpecialMoveEnded(UTPPSpecialMove* SpecialMove)
 				MovementComp->ServerSetUseControllerDesiredRotation(true);
 			}
 		}
+
+		if (bOldSpecialMoveEnded && CachedTPPPlayerController)
+		{
+			CachedTPPPlayerController->OnBlockingSpecialMoveEnded();
+		}
 	}
 }
 
+UTPPSpecialMove* ATPPPlayerCharacter::AcquireSpecialMove(TSubclassOf<UTPPSpecialMove> SpecialMoveClass)
+{
+	if (!SpecialMoveClass)
+	{
+		return nullptr;
+	}
+
+	FTPPSpecialMovePool* Pool = SpecialMovePools.Find(SpecialMoveClass);
+	if (Pool && Pool->IdleSpecialMoves.Num() > 0)
+	{
+		INC_DWORD_STAT(STAT_TPPSpecialMovesReused);
+		UTPPSpecialMove* SpecialMove = Pool->IdleSpecialMoves.Pop(false);
+		SpecialMove->ResetSpecialMove();
+		return SpecialMove;
+	}
+
+	INC_DWORD_STAT(STAT_TPPSpecialMovesAllocated);
+	return NewObject<UTPPSpecialMove>(this, SpecialMoveClass);
+}
+
+void ATPPPlayerCharacter::ReleaseSpecialMove(UTPPSpecialMove* SpecialMove)
+{
+	if (!SpecialMove || SpecialMove->GetOuter() != this)
+	{
+		return;
+	}
+
+	FTPPSpecialMovePool& Pool = SpecialMovePools.FindOrAdd(SpecialMove->GetClass());
+	if (Pool.IdleSpecialMoves.Num() < MaxPooledSpecialMovesPerClass)
+	{
+		Pool.IdleSpecialMoves.AddUnique(SpecialMove);
+	}
+}
+
+void ATPPPlayerCharacter::ReleaseEndedSpecialMoves()
+{
+	for (UTPPSpecialMove* SpecialMove : EndedSpecialMoves)
+	{
+		ReleaseSpecialMove(SpecialMove);
+	}
+	EndedSpecialMoves.Reset();
+}
+
+void ATPPPlayerCharacter::UpdateCapabilities()
+{
+	INC_DWORD_STAT(STAT_TPPCapabilityUpdates);
+
+	ETPPCharacterCapability NewCapabilities = ~ETPPCharacterCapability::None;
+	if (CurrentSpecialMove)
+	{
+		NewCapabilities &= ~CurrentSpecialMove->GetBlockedCapabilities();
+	}
+
+	const UTPPMovementComponent* MovementComp = GetTPPMovementComponent();
+	const bool bIsMovingOnGround = MovementComp && MovementComp->IsMovingOnGround();
+	if (!bIsMovingOnGround || bIsCrouched || bIsAiming || WallMovementState != EWallMovementState::None)
+	{
+		NewCapabilities &= ~ETPPCharacterCapability::Sprint;
+	}
+
+	if (!MovementComp || MovementComp->IsSliding())
+	{
+		NewCapabilities &= ~(ETPPCharacterCapability::Jump | ETPPCharacterCapability::Aim);
+	}
+
+	if (MovementComp && MovementComp->HasCharacterStartedSlide())
+	{
+		NewCapabilities &= ~ETPPCharacterCapability::Reload;
+	}
+
+	if (WallMovementState != EWallMovementState::None)
+	{
+		NewCapabilities &= ~ETPPCharacterCapability::Slide;
+	}
+
+	if (!EquippedWeapon)
+	{
+		NewCapabilities &= ~(ETPPCharacterCapability::Aim | ETPPCharacterCapability::Fire | ETPPCharacterCapability::Reload);
+	}
+
+	Capabilities = NewCapabilities;
+}
+
+void ATPPPlayerCharacter::ServerSetReplicatedSpecialMove_Implementation(const FTPPReplicatedSpecialMove& NewReplicatedMove)
+{
+	if (IsPredictionKeyRejected(NewReplicatedMove.PredictionKey))
+	{
+		return;
+	}
+
+	ReplicatedSpecialMove = NewReplicatedMove;
+	ReplicatedSpecialMove.StartServerTime = GetServerWorldTimeSeconds();
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, ReplicatedSpecialMove, this);
+
+	// The server runs remotely controlled moves the same way simulated proxies do.
+	OnRep_ReplicatedSpecialMove();
+}
+
+void ATPPPlayerCharacter::OnRep_ReplicatedSpecialMove()
+{
+	if (IsLocallyControlled())
+	{
+		return;
+	}
+
+	const int32 MoveClassIndex = (int32)ReplicatedSpecialMove.MoveClassIndex - 1;
+	const bool bHasNewMove = ReplicatedSpecialMoveClasses.IsValidIndex(MoveClassIndex);
+
+	// Only end moves started from replication. Locally started moves, such as death, take priority.
+	if (CurrentSpecialMove && CurrentSpecialMove->IsSimulatedMove())
+	{
+		if (bHasNewMove)
+		{
+			CurrentSpecialMove->InterruptSpecialMove();
+		}
+		else
+		{
+			CurrentSpecialMove->EndSpecialMove();
+		}
+	}
+
+	if (bHasNewMove && !CurrentSpecialMove)
+	{
+		UTPPSpecialMove* SpecialMove = AcquireSpecialMove(ReplicatedSpecialMoveClasses[MoveClassIndex]);
+		if (SpecialMove)
+		{
+			SpecialMove->InitFromReplicatedSpecialMove(ReplicatedSpecialMove);
+			ExecuteSpecialMove(SpecialMove);
+		}
+	}
+}
+
+float ATPPPlayerCharacter::GetServerWorldTimeSeconds() const
+{
+	const UWorld* World = GetWorld();
+	const AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+	if (GameState)
+	{
+		return GameState->GetServerWorldTimeSeconds();
+	}
+
+	return World ? World->GetTimeSeconds() : 0.0f;
+}
+
+float ATPPPlayerCharacter::GetPredictedServerWorldTimeSeconds() const
+{
+	float ServerWorldTimeSeconds = GetServerWorldTimeSeconds();
+
+	// The replicated server time is already a one way trip old, and moves made now take another one way trip to reach the server.
+	const APlayerState* CharacterPlayerState = GetPlayerState();
+	if (GetLocalRole() == ROLE_AutonomousProxy && CharacterPlayerState)
+	{
+		ServerWorldTimeSeconds += CharacterPlayerState->ExactPing * 0.001f;
+	}
+
+	return ServerWorldTimeSeconds;
+}
+
 void ATPPPlayerCharacter::ServerPlaySpecialMoveMontage_Implementation(UAnimMontage* Montage, bool bShouldEndAllMontages)
 {
 	if (HasAuthority())
@@ -505,13 +966,18 @@ void ATPPPlayerCharacter::ServerPlaySpecialMoveMontage_Implementation(UAnimMonta
 }
 
 void ATPPPlayerCharacter::PlaySpecialMoveAnimMontage_Implementation(UAnimMontage* Montage, bool bShouldEndAllMontages)
+{
+	PlayLocalSpecialMoveMontage(Montage, bShouldEndAllMontages);
+}
+
+void ATPPPlayerCharacter::PlayLocalSpecialMoveMontage(UAnimMontage* Montage, bool bShouldEndAllMontages, float StartTime)
 {
 	if (Montage)
 	{
 		UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
 		if (AnimInstance)
 		{
-			AnimInstance->Montage_Play(Montage, 1.0f, EMontagePlayReturnType::MontageLength, 0.0f, bShouldEndAllMontages);
+			AnimInstance->Montage_Play(Montage, 1.0f, EMontagePlayReturnType::MontageLength, StartTime, bShouldEndAllMontages);
 		}
 	}
 }
@@ -539,6 +1005,7 @@ void ATPPPlayerCharacter::EndAnimMontage_Implementation(UAnimMontage* MontageToE
 void ATPPPlayerCharacter::SetAnimationBlendSlot_Implementation(const EAnimationBlendSlot NewSlot)
 {
 	CurrentAnimationBlendSlot = NewSlot;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, CurrentAnimationBlendSlot, this);
 	OnRep_AnimationBlendSlot();
 }
 
@@ -575,23 +1042,27 @@ void ATPPPlayerCharacter::ServerEquipWeapon_Implementation(ATPPWeaponBase* NewEq
 		NewEquippedWeapon->ServerEquip(this);
 
 		EquippedWeapon = NewEquippedWeapon;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, EquippedWeapon, this);
 		OnRep_EquippedWeapon();
 	}
 }
 
 void ATPPPlayerCharacter::OnRep_EquippedWeapon()
 {
+	CachedEquippedFirearm = Cast<ATPPWeaponFirearm>(EquippedWeapon);
+	UpdateCapabilities();
+
+	if (EquippedWeapon)
+	{
+		EquippedWeapon->SetActorTickInterval(SignificanceTierSettings.TickInterval);
+	}
+
 	OnWeaponEquipped.Broadcast(EquippedWeapon);
 }
 
 void ATPPPlayerCharacter::TryToFireWeapon()
 {
-	if (!EquippedWeapon)
-	{
-		return;
-	}
-
-	if (CurrentSpecialMove && CurrentSpecialMove->IsMoveBlockingWeaponUse())
+	if (!EquippedWeapon || !HasCapabilities(ETPPCharacterCapability::Fire))
 	{
 		return;
 	}
@@ -611,13 +1082,13 @@ void ATPPPlayerCharacter::SetPlayerWantsToAim(bool bIsTryingToAim)
 
 bool ATPPPlayerCharacter::CanPlayerBeginAiming() const
 {
-	UTPPMovementComponent* MovementComp = GetTPPMovementComponent();
-	return EquippedWeapon && (MovementComp && !MovementComp->IsSliding()) && (!CurrentSpecialMove || !CurrentSpecialMove->bDisablesAiming);
+	return HasCapabilities(ETPPCharacterCapability::Aim);
 }
 
 void ATPPPlayerCharacter::ServerBeginAiming_Implementation()
 {
 	bIsAiming = true;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, bIsAiming, this);
 
 	ServerStopSprint();
 
@@ -632,6 +1103,7 @@ void ATPPPlayerCharacter::ServerBeginAiming_Implementation()
 void ATPPPlayerCharacter::ServerStopAiming_Implementation()
 {
 	bIsAiming = false;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, bIsAiming, this);
 
 	bUseControllerRotationYaw = false;
 
@@ -644,55 +1116,51 @@ void ATPPPlayerCharacter::ServerStopAiming_Implementation()
 
 void ATPPPlayerCharacter::OnRep_IsAiming()
 {
+	UpdateCapabilities();
+
 	UTPPMovementComponent* MovementComp = GetTPPMovementComponent();
 
 	if (bIsAiming)
 	{
+#if TPP_WITH_COSMETICS
 		FollowCamera->SetRelativeLocation(ADSCameraOffset);
+		CameraBoom->TargetArmLength = ADSCameraArmLength;
+#endif
 
 		if (IsLocallyControlled() && (!CurrentSpecialMove || !CurrentSpecialMove->bDisablesCharacterRotation))
 		{
 			MovementComp->ServerSetUseControllerDesiredRotation(true);
 		}
 		MovementComp->RotationRate = FRotator(0.0f, ADSRotationRate, 0.0f);
-
-		CameraBoom->TargetArmLength = ADSCameraArmLength;
 	}
 	else
 	{
+#if TPP_WITH_COSMETICS
 		FollowCamera->SetRelativeLocation(HipAimCameraOffset);
+		CameraBoom->TargetArmLength = HipAimCameraArmLength;
+#endif
 		bUseControllerRotationYaw = false;
 
 		MovementComp->bOrientRotationToMovement = true;
 		MovementComp->RotationRate = FRotator(0.0f, DefaultRotationRate, 0.0f);
-
-		CameraBoom->TargetArmLength = HipAimCameraArmLength;
 	}
 }
 
-void ATPPPlayerCharacter::TryToReloadWeapon()
+bool ATPPPlayerCharacter::TryToReloadWeapon()
 {
-	ATPPWeaponFirearm* WeaponFirearm = Cast<ATPPWeaponFirearm>(EquippedWeapon);
-	if (!WeaponFirearm)
-	{
-		return;
-	}
-
-	if (CurrentSpecialMove && CurrentSpecialMove->IsMoveBlockingWeaponUse())
-	{
-		return;
-	}
-
-	UTPPMovementComponent* MoveComp = GetTPPMovementComponent();
-	if (MoveComp->HasCharacterStartedSlide())
+	ATPPWeaponFirearm* WeaponFirearm = CachedEquippedFirearm;
+	if (!WeaponFirearm || !HasCapabilities(ETPPCharacterCapability::Reload))
 	{
-		return;
+		return false;
 	}
 
 	if (WeaponFirearm->CanReloadWeapon())
 	{
 		WeaponFirearm->StartWeaponReload();
+		return true;
 	}
+
+	return false;
 }
 
 void ATPPPlayerCharacter::Log(ELogLevel LoggingLevel, FString Message, ELogOutput LogOutput)
@@ -738,10 +1206,10 @@ float ATPPPlayerCharacter::TakeDamage(float Damage, FDamageEvent const& DamageEv
 		return 0.0f;
 	}
 
+	PS->StopHealthRegen();
 	const float HealthDamaged = FMath::Min(Damage, PS->GetHealth());
 	PS->SetPlayerHealth(PS->GetHealth() - HealthDamaged);
 
-	bShouldRegenHealth = false;
 	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
 	TimerManager.ClearTimer(HealthRegenTimerHandle);
 
@@ -771,14 +1239,16 @@ void ATPPPlayerCharacter::ClientOnDamageTaken_Implementation(float Damage, FDama
 		}
 	}
 
+#if TPP_WITH_COSMETICS
 	if (Damage > 0 && IsCharacterAlive() && !CurrentSpecialMove)
 	{
-		UAnimMontage* HitReactMontage = bWasHitInHead ? HitReactions.HeadHitReactMontage : HitReactions.UpperBodyHitReactMontage;
+		UAnimMontage* HitReactMontage = UTPPAssetStreamingSubsystem::GetLoadedAsset(bWasHitInHead ? HitReactions.HeadHitReactMontage : HitReactions.UpperBodyHitReactMontage);
 		if (HitReactMontage)
 		{
 			PlaySpecialMoveAnimMontage(HitReactMontage);
 		}
 	}
+#endif
 
 	DamageReceived.Broadcast(Damage, DamageEvent);
 }
@@ -795,13 +1265,21 @@ void ATPPPlayerCharacter::ModifyHealth_Implementation(float HealthToGain)
 
 float ATPPPlayerCharacter::GetPlayerHealth() const
 {
-	ATPPPlayerState* PS = Cast<ATPPPlayerState>(GetPlayerState());
-	return PS ? PS->GetHealth() : 0.0f;
+	return CachedTPPPlayerState ? CachedTPPPlayerState->GetHealth() : 0.0f;
 }
 
 void ATPPPlayerCharacter::OnHealthRegenTimerExpired()
 {
-	bShouldRegenHealth = true;
+	ATPPPlayerState* PS = GetTPPPlayerState();
+	if (PS)
+	{
+		PS->BeginHealthRegen(CachedHealthRegenDelta, MaxHealth);
+	}
+}
+
+bool ATPPPlayerCharacter::IsRegeneratingHealth() const
+{
+	return CachedTPPPlayerState ? CachedTPPPlayerState->IsRegeneratingHealth() : false;
 }
 
 void ATPPPlayerCharacter::OnPlayerHealthDepleted()
@@ -830,8 +1308,7 @@ void ATPPPlayerCharacter::BecomeDefeated()
 
 bool ATPPPlayerCharacter::IsCharacterAlive() const
 {
-	ATPPPlayerState* PS = Cast<ATPPPlayerState>(GetPlayerState());
-	return PS ? PS->IsPlayerCharacterAlive() : false;
+	return CachedTPPPlayerState ? CachedTPPPlayerState->IsPlayerCharacterAlive() : false;
 }
 
 void ATPPPlayerCharacter::OnDeath()
@@ -856,6 +1333,12 @@ void ATPPPlayerCharacter::BeginRagdoll()
 	{
 		SkeletalMesh->SetCollisionProfileName(FName(TEXT("Ragdoll")));
 		SkeletalMesh->SetAllBodiesBelowSimulatePhysics(FName(TEXT("Root")), true, true);
+
+		UTPPRagdollSubsystem* RagdollSubsystem = UTPPRagdollSubsystem::Get(this);
+		if (RagdollSubsystem)
+		{
+			RagdollSubsystem->RegisterRagdoll(SkeletalMesh);
+		}
 	}
 
 	UMovementComponent* MovementComp = GetCharacterMovement();
@@ -1091,7 +1574,7 @@ void ATPPPlayerCharacter::ServerTryBeginWallMovement_Implementation()
 						UTPP_SPM_LedgeClimb* LedgeClimbCDO = Cast<UTPP_SPM_LedgeClimb>(AutoLedgeClimbClass.GetDefaultObject());
 						if (LedgeClimbCDO)
 						{
-							WallMoveProps.ClimbAnimLength = LedgeClimbCDO->ClimbMontage->GetPlayLength() / LedgeClimbCDO->ClimbMontage->RateScale;
+							WallMoveProps.ClimbAnimLength = LedgeClimbCDO->GetClimbMontageLength();
 							SetWallMovementState(EWallMovementState::WallLedgeClimb, WallMoveProps);
 						}
 					}
@@ -1120,19 +1603,6 @@ void ATPPPlayerCharacter::ServerTryBeginWallMovement_Implementation()
 				}
 			}
 		}
-		else
-		{
-			switch (WallMovementState)
-			{
-			case EWallMovementState::WallLedgeClimb:
-				DoLedgeClimb();
-				break;
-			// Ledge hang should be handled by special move logic in owning character
-			case EWallMovementState::WallRunUp:
-				DoWallRun();
-				break;
-			}
-		}
 	}
 }
 
@@ -1156,7 +1626,7 @@ void ATPPPlayerCharacter::DoLedgeHang_Implementation()
 				UTPP_SPM_LedgeClimb* LedgeClimbCDO = Cast<UTPP_SPM_LedgeClimb>(LedgeClimbClass.GetDefaultObject());
 				if (LedgeClimbCDO)
 				{
-					CurrentWallMovementProperties.ClimbAnimLength = LedgeClimbCDO->ClimbMontage->GetPlayLength() / LedgeClimbCDO->ClimbMontage->RateScale;
+					CurrentWallMovementProperties.ClimbAnimLength = LedgeClimbCDO->GetClimbMontageLength();
 					SetWallMovementState(EWallMovementState::WallLedgeClimb, CurrentWallMovementProperties);
 				}
 
@@ -1171,48 +1641,55 @@ void ATPPPlayerCharacter::DoLedgeHang_Implementation()
 	
 }
 
-void ATPPPlayerCharacter::DoLedgeClimb_Implementation()
+bool ATPPPlayerCharacter::WantsToLeaveLedgeHang() const
 {
-	const float DeltaTime = GetWorld()->GetDeltaSeconds();
-	if (CurrentWallMovementProperties.ClimbAnimLength > 0.0f)
+	const ATPPPlayerController* PC = GetTPPPlayerController();
+	if (!PC || PC->GetDesiredMovementDirection().IsNearlyZero())
 	{
-		const float AnimTimeRatio = CurrentWallMovementProperties.ClimbElapsedTime / CurrentWallMovementProperties.ClimbAnimLength;
-		const float NewZ = FMath::Lerp(CurrentWallMovementProperties.WallAttachPoint.Z, CurrentWallMovementProperties.WallClimbExitPoint.Z, AnimTimeRatio);
-		float NewX = CurrentWallMovementProperties.WallAttachPoint.X;
-		float NewY = CurrentWallMovementProperties.WallAttachPoint.Y;
-		if (NewZ >= CurrentWallMovementProperties.ClimbLateralThresholdPoint.Z)
-		{
-			if (CurrentWallMovementProperties.ClimbLateralAnimLength == 0.0f)
-			{
-				CurrentWallMovementProperties.ClimbLateralAnimLength = CurrentWallMovementProperties.ClimbAnimLength - CurrentWallMovementProperties.ClimbElapsedTime;
-			}
-
-			const float LateralElapsedTimeRatio = CurrentWallMovementProperties.ClimbLateralLerpElapsedTime / CurrentWallMovementProperties.ClimbLateralAnimLength;
-			NewX = FMath::Lerp(CurrentWallMovementProperties.WallAttachPoint.X, CurrentWallMovementProperties.WallClimbExitPoint.X, LateralElapsedTimeRatio);
-			NewY = FMath::Lerp(CurrentWallMovementProperties.WallAttachPoint.Y, CurrentWallMovementProperties.WallClimbExitPoint.Y, LateralElapsedTimeRatio);
+		return false;
+	}
 
-			CurrentWallMovementProperties.ClimbLateralLerpElapsedTime += DeltaTime;
-		}
+	const FVector ControllerRelativeMovementDirection = PC->GetControllerRelativeMovementRotation().Vector();
+	const float DesiredDirectionWallDot = FVector::DotProduct(ControllerRelativeMovementDirection, CurrentWallMovementProperties.WallTraceImpactResult.ImpactNormal);
+	return -DesiredDirectionWallDot >= HangToClimbInputDot || -DesiredDirectionWallDot <= -EndHangInputDot;
+}
 
-		const FVector FinalPosition = FVector(NewX, NewY, NewZ);
-		SetActorLocation(FinalPosition);
-		ClientLedgeClimbUpdate(GetActorLocation());
+void ATPPPlayerCharacter::DoLedgeClimb()
+{
+	if (CurrentWallMovementProperties.ClimbAnimLength > 0.0f)
+	{
+		const float ElapsedTime = GetPredictedServerWorldTimeSeconds() - CurrentWallMovementProperties.ClimbStartServerTime;
+		SetActorLocation(ComputeLedgeClimbLocation(CurrentWallMovementProperties, ElapsedTime));
 	}
-	else
+	else if (HasAuthority())
 	{
 		SetWallMovementState(EWallMovementState::None);
 	}
-
-	CurrentWallMovementProperties.ClimbElapsedTime += DeltaTime;
-
 }
 
-void ATPPPlayerCharacter::ClientLedgeClimbUpdate_Implementation(const FVector& NewLocation)
+FVector ATPPPlayerCharacter::ComputeLedgeClimbLocation(const FTPPWallMovementProps& WallMoveProps, const float ElapsedTime)
 {
-	SetActorLocation(NewLocation);
+	const FVector& AttachPoint = WallMoveProps.WallAttachPoint;
+	const FVector& ExitPoint = WallMoveProps.WallClimbExitPoint;
+	const float AnimTimeRatio = FMath::Clamp(ElapsedTime / WallMoveProps.ClimbAnimLength, 0.0f, 1.0f);
+
+	FVector ClimbLocation = AttachPoint;
+	ClimbLocation.Z = FMath::Lerp(AttachPoint.Z, ExitPoint.Z, AnimTimeRatio);
+
+	// Lateral movement begins once the climb passes the threshold height and finishes with the animation.
+	const float ClimbHeight = ExitPoint.Z - AttachPoint.Z;
+	const float LateralStartRatio = FMath::IsNearlyZero(ClimbHeight) ? 0.0f : FMath::Clamp((WallMoveProps.ClimbLateralThresholdPoint.Z - AttachPoint.Z) / ClimbHeight, 0.0f, 1.0f);
+	if (AnimTimeRatio >= LateralStartRatio && LateralStartRatio < 1.0f)
+	{
+		const float LateralRatio = (AnimTimeRatio - LateralStartRatio) / (1.0f - LateralStartRatio);
+		ClimbLocation.X = FMath::Lerp(AttachPoint.X, ExitPoint.X, LateralRatio);
+		ClimbLocation.Y = FMath::Lerp(AttachPoint.Y, ExitPoint.Y, LateralRatio);
+	}
+
+	return ClimbLocation;
 }
 
-void ATPPPlayerCharacter::DoWallRun_Implementation()
+void ATPPPlayerCharacter::DoWallRun()
 {
 	UTPPMovementComponent* MovementComp = GetTPPMovementComponent();
 	MovementComp->Velocity = FVector(0.0f, 0.0f, WallRunVerticalSpeed);
@@ -1380,12 +1857,20 @@ void ATPPPlayerCharacter::SetWallMovementState_Implementation(EWallMovementState
 
 	WallMovementState = NewWallMovementState;
 	CurrentWallMovementProperties = WallMoveProps;
+	if (NewWallMovementState == EWallMovementState::WallLedgeClimb)
+	{
+		CurrentWallMovementProperties.ClimbStartServerTime = GetServerWorldTimeSeconds();
+	}
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, WallMovementState, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ATPPPlayerCharacter, CurrentWallMovementProperties, this);
 
 	OnRep_WallMovementState(PrevState);
 }
 
 void ATPPPlayerCharacter::OnRep_WallMovementState(EWallMovementState PreviousState)
 {
+	UpdateCapabilities();
+
 	if (IsLocallyControlled())
 	{
 		if (WallMovementState != EWallMovementState::None && CurrentSpecialMove)
@@ -1405,7 +1890,7 @@ void ATPPPlayerCharacter::OnRep_WallMovementState(EWallMovementState PreviousSta
 		}
 		case EWallMovementState::WallLedgeClimb:
 		{
-			UTPP_SPM_LedgeClimb* LedgeClimbSPM = NewObject<UTPP_SPM_LedgeClimb>(this, PreviousState == EWallMovementState::WallLedgeHang ? LedgeClimbClass : AutoLedgeClimbClass);
+			UTPP_SPM_LedgeClimb* LedgeClimbSPM = AcquireSpecialMove<UTPP_SPM_LedgeClimb>(PreviousState == EWallMovementState::WallLedgeHang ? LedgeClimbClass : AutoLedgeClimbClass);
 			if (LedgeClimbSPM)
 			{
 				ExecuteSpecialMove(LedgeClimbSPM);
@@ -1414,7 +1899,7 @@ void ATPPPlayerCharacter::OnRep_WallMovementState(EWallMovementState PreviousSta
 		}
 		case EWallMovementState::WallLedgeHang:
 		{
-			UTPP_SPM_LedgeHang* LedgeHangSPM = NewObject<UTPP_SPM_LedgeHang>(this, LedgeHangClass);
+			UTPP_SPM_LedgeHang* LedgeHangSPM = AcquireSpecialMove<UTPP_SPM_LedgeHang>(LedgeHangClass);
 			if (LedgeHangSPM)
 			{
 				ExecuteSpecialMove(LedgeHangSPM);
@@ -1423,7 +1908,7 @@ void ATPPPlayerCharacter::OnRep_WallMovementState(EWallMovementState PreviousSta
 		}
 		case EWallMovementState::WallRunUp:
 		{
-			UTPP_SPM_WallRun* WallRunSPM = NewObject<UTPP_SPM_WallRun>(this, WallRunClass);
+			UTPP_SPM_WallRun* WallRunSPM = AcquireSpecialMove<UTPP_SPM_WallRun>(WallRunClass);
 			if (WallRunSPM)
 			{
 				ExecuteSpecialMove(WallRunSPM);
@@ -1448,9 +1933,38 @@ void ATPPPlayerCharacter::OnMovementModeChanged(EMovementMode PrevMovementMode,
 	{
 		bIsWallRunCooldownActive = false;
 	}
+
+	UTPPLatencySubsystem* LatencySubsystem = IsLocallyControlled() ? UTPPLatencySubsystem::Get(this) : nullptr;
+	if (LatencySubsystem)
+	{
+		LatencySubsystem->MarkLatestStage(this, ETPPLatencyTrace::Movement, ETPPLatencyStage::MovementModeChanged, true);
+	}
+
+	UpdateCapabilities();
 }
 
 void ATPPPlayerCharacter::OnRep_PlayerState()
 {
+	Super::OnRep_PlayerState();
+	UpdateCachedControllerReferences();
+}
+
+void ATPPPlayerCharacter::OnSignificanceTierChanged(ETPPSignificanceTier NewTier, const FTPPSignificanceTierSettings& TierSettings)
+{
+	SignificanceTier = NewTier;
+	SignificanceTierSettings = TierSettings;
+
+	SetActorTickInterval(TierSettings.TickInterval);
+
+	USkeletalMeshComponent* SkeletalMesh = GetMesh();
+	if (SkeletalMesh)
+	{
+		SkeletalMesh->bEnableUpdateRateOptimizations = TierSettings.bUseUpdateRateOptimizations;
+		SkeletalMesh->VisibilityBasedAnimTickOption = TierSettings.AnimTickOption;
+	}
 
+	if (EquippedWeapon)
+	{
+		EquippedWeapon->SetActorTickInterval(TierSettings.TickInterval);
+	}
 }
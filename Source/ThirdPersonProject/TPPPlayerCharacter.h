@@ -17,6 +17,7 @@
 #include "SpecialMove/TPP_SPM_LedgeHang.h"
 #include "SpecialMove/TPP_SPM_WallRun.h"
 #include "Game/TPPPlayerState.h"
+#include "Interfaces/TPPSignificanceInterface.h"
 #include "TPPPlayerCharacter.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWeaponEquipped, ATPPWeaponBase*, WeaponEquipped);
@@ -25,6 +26,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnHealthRestored, float, HealthGain
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnHealthDepleted);
 
 class ATPPPlayerController;
+class ATPPWeaponFirearm;
 class UTPPMovementComponent;
 class TPPHUD;
 
@@ -70,20 +72,15 @@ struct FTPPWallMovementProps
 	UPROPERTY()
 	FVector WallClimbExitPoint = FVector::ZeroVector;
 
+	/** Server world time the ledge climb started. Climb location is derived from this so it never needs to be replicated per frame. */
 	UPROPERTY(Transient)
-	float ClimbElapsedTime = 0.0f;
-
-	UPROPERTY(Transient)
-	float ClimbLateralLerpElapsedTime = 0.0f;
+	float ClimbStartServerTime = 0.0f;
 
 	UPROPERTY(Transient)
 	float ClimbAnimLength = 0.0f;
 
 	UPROPERTY(Transient)
 	FVector ClimbLateralThresholdPoint = FVector::ZeroVector;
-
-	UPROPERTY(Transient)
-	float ClimbLateralAnimLength = 0.0f;
 };
 
 UENUM(BlueprintType)
@@ -124,17 +121,27 @@ struct FTPPHitReactions
 
 	/** Hit react to play upon taking damage to the head */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
-	UAnimMontage* HeadHitReactMontage = nullptr;
+	TSoftObjectPtr<UAnimMontage> HeadHitReactMontage;
 
 	/** Hit react to play upon taking damage to upper body */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
-	UAnimMontage* UpperBodyHitReactMontage = nullptr;
+	TSoftObjectPtr<UAnimMontage> UpperBodyHitReactMontage;
+};
+
+/** Idle special move instances of a single class, reused instead of allocating a new move each time one starts */
+USTRUCT()
+struct FTPPSpecialMovePool
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<UTPPSpecialMove*> IdleSpecialMoves;
 };
 
 #pragma endregion Structs_And_Enums
 
 UCLASS(config=Game,Blueprintable)
-class ATPPPlayerCharacter : public ACharacter
+class ATPPPlayerCharacter : public ACharacter, public ITPPSignificanceInterface
 {
 	GENERATED_BODY()
 
@@ -172,6 +179,10 @@ public:
 
 	void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void PostInitializeComponents() override;
+
 protected:
 
 	// Required network scaffolding
@@ -248,15 +259,33 @@ public:
 
 	virtual void Landed(const FHitResult& LandHit) override;
 
-	void AttemptToJump();
+	/** Jumps or wall kicks. Returns false if neither could be done. */
+	bool AttemptToJump();
 
 public:
 
 	UFUNCTION(BlueprintPure)
-	UTPPMovementComponent* GetTPPMovementComponent() const;
+	UTPPMovementComponent* GetTPPMovementComponent() const { return CachedTPPMovementComponent; }
 
 	UFUNCTION(BlueprintPure)
-	ATPPPlayerController* GetTPPPlayerController() const;
+	ATPPPlayerController* GetTPPPlayerController() const { return CachedTPPPlayerController; }
+
+protected:
+
+	/** Typed movement component. Cached once components are initialized */
+	UPROPERTY(Transient)
+	UTPPMovementComponent* CachedTPPMovementComponent = nullptr;
+
+	/** Typed player controller. Cached on possession and controller replication */
+	UPROPERTY(Transient)
+	ATPPPlayerController* CachedTPPPlayerController = nullptr;
+
+	/** Typed player state. Cached on possession and player state replication */
+	UPROPERTY(Transient)
+	ATPPPlayerState* CachedTPPPlayerState = nullptr;
+
+	/** Refreshes the cached controller and player state. Should be called whenever either changes. */
+	void UpdateCachedControllerReferences();
 
 protected:
 
@@ -268,15 +297,81 @@ protected:
 	UPROPERTY(Transient)
 	UTPPSpecialMove* CurrentSpecialMove;
 
+	/** Capabilities allowed by the current special move, movement, wall and aim state. Recomputed by UpdateCapabilities when any of them change. */
+	UPROPERTY(Transient)
+	ETPPCharacterCapability Capabilities = ETPPCharacterCapability::None;
+
+	/** Idle special moves keyed by class */
+	UPROPERTY(Transient)
+	TMap<UClass*, FTPPSpecialMovePool> SpecialMovePools;
+
+	/** Ended special moves waiting to go back to their pools once EndSpecialMove has returned */
+	UPROPERTY(Transient)
+	TArray<UTPPSpecialMove*> EndedSpecialMoves;
+
+	/** Max idle instances to keep per special move class */
+	UPROPERTY(EditDefaultsOnly)
+	int32 MaxPooledSpecialMovesPerClass = 2;
+
+	/** Special moves that are replicated to non-owning machines and run there locally. Moves started from blueprints, such as the dodge roll, are listed here on the character blueprint. Wall movement classes are added automatically. */
+	UPROPERTY(EditDefaultsOnly)
+	TArray<TSubclassOf<UTPPSpecialMove>> ReplicatedSpecialMoveClasses;
+
+	/** Special move the owning player is running. Skips the owner, who started it. */
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_ReplicatedSpecialMove)
+	FTPPReplicatedSpecialMove ReplicatedSpecialMove;
+
 public:
 
 	/** Ability to activate for special movement key */
 	UPROPERTY(EditDefaultsOnly)
 	TSubclassOf<UTPPAbilityBase> MovementAbilityClass;
 
+protected:
+
+	/** Prediction key applied to special moves started while a predicted ability activates */
+	uint16 ScopedPredictionKey = 0;
+
+	/** Server. Most recent prediction keys of activations the server rejected. Anything the client sends tagged with one is dropped. */
+	TArray<uint16, TInlineAllocator<8>> RejectedPredictionKeys;
+
+	/** Server. Most recent prediction keys of confirmed activations that haven't started their root motion move yet */
+	TArray<uint16, TInlineAllocator<8>> AcceptedPredictionKeys;
+
+	/** Server. Remembers a rejected key and undoes the replicated special move and root motion move it already started */
+	void RejectPredictionKey(uint16 PredictionKey);
+
 public:
 
-	void TryActivateAbility();
+	/** Returns true if the ability was activated */
+	bool TryActivateAbility();
+
+	/** Asks the server to confirm an ability activation the owning client predicted */
+	UFUNCTION(Server, Reliable)
+	void ServerActivateAbility(uint16 PredictionKey);
+
+	UFUNCTION(Client, Reliable)
+	void ClientAbilityActivationResult(uint16 PredictionKey, bool bAccepted);
+
+	void SetScopedPredictionKey(const uint16 NewPredictionKey) { ScopedPredictionKey = NewPredictionKey; }
+
+	/** Interrupts the current special move if it was started by the rejected prediction */
+	void RollbackPredictedSpecialMove(uint16 PredictionKey);
+
+	/** Server. Returns true if the key belongs to a recently rejected activation */
+	bool IsPredictionKeyRejected(uint16 PredictionKey) const { return PredictionKey != 0 && RejectedPredictionKeys.Contains(PredictionKey); }
+
+	/**
+	 * Server. Returns true if the key belongs to a confirmed activation of the current ability and the move is the ability's special move.
+	 * The key is used up, so each confirmed activation can only start one root motion move.
+	 */
+	bool ConsumeAcceptedPredictionKey(TSubclassOf<UTPPSpecialMove> MoveClass, uint16 PredictionKey);
+
+	/** Recomputes allowed capabilities. Needs to be called whenever any state they depend on changes. */
+	void UpdateCapabilities();
+
+	/** Returns true if all of the given capabilities are currently allowed */
+	bool HasCapabilities(const ETPPCharacterCapability RequiredCapabilities) const { return EnumHasAllFlags(Capabilities, RequiredCapabilities); }
 
 	/** Gets current special move */
 	UFUNCTION(BlueprintPure)
@@ -291,6 +386,40 @@ public:
 
 	void OnSpecialMoveEnded(UTPPSpecialMove* SpecialMove);
 
+	/** Returns a reset idle special move of the given class, only allocating a new one if none are pooled */
+	UTPPSpecialMove* AcquireSpecialMove(TSubclassOf<UTPPSpecialMove> SpecialMoveClass);
+
+	template<class T>
+	T* AcquireSpecialMove(TSubclassOf<UTPPSpecialMove> SpecialMoveClass)
+	{
+		return Cast<T>(AcquireSpecialMove(SpecialMoveClass));
+	}
+
+	/** Returns an ended special move to its class pool */
+	void ReleaseSpecialMove(UTPPSpecialMove* SpecialMove);
+
+	/** Pools the moves ended last frame. Deferred so EndSpecialMove overrides can finish with the move before it is reset and reused. */
+	void ReleaseEndedSpecialMoves();
+
+	bool IsReplicatedSpecialMoveClass(const UClass* SpecialMoveClass) const { return ReplicatedSpecialMoveClasses.Contains(SpecialMoveClass); }
+
+	/** Sent once when the owning player starts or ends a replicated special move */
+	UFUNCTION(Server, Reliable)
+	void ServerSetReplicatedSpecialMove(const FTPPReplicatedSpecialMove& NewReplicatedMove);
+
+	/** Starts or ends the simulated copy of the owning player's special move */
+	UFUNCTION()
+	void OnRep_ReplicatedSpecialMove();
+
+	/** Plays a special move montage on this machine only */
+	void PlayLocalSpecialMoveMontage(UAnimMontage* Montage, bool bShouldEndAllMontages = false, float StartTime = 0.0f);
+
+	/** Returns the server world time, falling back to local world time if no game state has replicated yet */
+	float GetServerWorldTimeSeconds() const;
+
+	/** Server world time at which moves made now are run on the server. Ahead of GetServerWorldTimeSeconds by the round trip on the owning client. */
+	float GetPredictedServerWorldTimeSeconds() const;
+
 	UFUNCTION(Server, Reliable)
 	void ServerPlaySpecialMoveMontage(UAnimMontage* Montage, bool bShouldEndAllMontages = false);
 
@@ -362,6 +491,9 @@ protected:
 	UPROPERTY(Transient, ReplicatedUsing=OnRep_EquippedWeapon)
 	ATPPWeaponBase* EquippedWeapon = nullptr;
 
+	UPROPERTY(Transient)
+	ATPPWeaponFirearm* CachedEquippedFirearm = nullptr;
+
 	/** True if the player intends to aim down the sights when able */
 	UPROPERTY(Transient)
 	bool bWantsToAim = false;
@@ -378,6 +510,10 @@ protected:
 
 public:
 
+	FRotator GetAimRotationDelta() const { return AimRotationDelta; }
+
+	FVector GetControllerRelativeMovementSpeed() const { return ControllerRelativeMovementSpeed; }
+
 	UPROPERTY(BlueprintAssignable)
 	FOnWeaponEquipped OnWeaponEquipped;
 
@@ -389,11 +525,14 @@ public:
 	UFUNCTION(BlueprintPure)
 	ATPPWeaponBase* GetCurrentEquippedWeapon() const { return EquippedWeapon; }
 
+	/** Returns the equipped weapon if it is a firearm. Cached when the equipped weapon changes. */
+	ATPPWeaponFirearm* GetCurrentEquippedFirearm() const { return CachedEquippedFirearm; }
+
 	/** Tries to fire the currently equipped weapon */
 	void TryToFireWeapon();
 
-	/** Try to reload weapon */
-	void TryToReloadWeapon();
+	/** Try to reload weapon. Returns true if the reload started. */
+	bool TryToReloadWeapon();
 
 	/** Set player's intent to begin aiming */
 	UFUNCTION(BlueprintCallable)
@@ -465,6 +604,9 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character|Gameplay|Damage")
 	FTPPHitReactions HitReactions;
 
+	/** Streams in hit reacts and the assets of every special move this character can perform */
+	void RequestStreamedAssets();
+
 protected:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
@@ -609,15 +751,17 @@ public:
 	UFUNCTION(Server, Reliable)
 	void DoLedgeHang();
 
-	UFUNCTION(Server, Reliable)
+	/** Returns true if the player's input should make them climb up or drop from the ledge they're hanging on */
+	bool WantsToLeaveLedgeHang() const;
+
+	/** Updates wall run velocity. Authority only. */
 	void DoWallRun();
 
-	UFUNCTION(Server, Reliable)
+	/** Moves the character along the ledge climb. Run on every machine since it only depends on replicated wall movement properties. */
 	void DoLedgeClimb();
 
-	/** Called on clients to replicate updated location during ledge climb. Used to keep clients in sync and reduce jitter */
-	UFUNCTION(NetMulticast, Reliable)
-	void ClientLedgeClimbUpdate(const FVector& NewLocation);
+	/** Returns the ledge climb location for the time since the climb started */
+	static FVector ComputeLedgeClimbLocation(const FTPPWallMovementProps& WallMoveProps, const float ElapsedTime);
 
 	UFUNCTION(Server, Reliable)
 	void SetWallMovementState(EWallMovementState NewMovementState, const FTPPWallMovementProps& NewMovementProps = FTPPWallMovementProps());
@@ -652,10 +796,6 @@ public:
 
 protected:
 
-	/** True if regen can begin */
-	UPROPERTY(Transient, Replicated)
-	bool bShouldRegenHealth = false;
-
 	/** Cached health regen rate */
 	UPROPERTY(Transient)
 	float CachedHealthRegenDelta = 0.0f;
@@ -684,7 +824,7 @@ public:
 
 	/** Returns true if health regen is active */
 	UFUNCTION(BlueprintPure)
-	bool IsRegeneratingHealth() const { return bShouldRegenHealth; }
+	bool IsRegeneratingHealth() const;
 
 	/** Modify Health in player state */
 	UFUNCTION(Server, Reliable)
@@ -696,9 +836,35 @@ public:
 
 public:
 
-	ATPPPlayerState* GetTPPPlayerState() { return Controller ? Cast<ATPPPlayerState>(GetPlayerState()) : nullptr; }
+	ATPPPlayerState* GetTPPPlayerState() const { return Controller ? CachedTPPPlayerState : nullptr; }
 
 	void OnRep_PlayerState() override;
 
+	virtual void OnRep_Controller() override;
+
+	virtual void PossessedBy(AController* NewController) override;
+
+	virtual void UnPossessed() override;
+
+public:
+
+	virtual void OnSignificanceTierChanged(ETPPSignificanceTier NewTier, const FTPPSignificanceTierSettings& TierSettings) override;
+
+	/** Characters controlled or simulated authoritatively on this machine always update at full rate */
+	virtual bool IsAlwaysSignificant() const override { return IsLocallyControlled() || HasAuthority(); }
+
+	ETPPSignificanceTier GetSignificanceTier() const { return SignificanceTier; }
+
+	/** Returns settings for the current significance tier. Used by the equipped weapon to skip work for insignificant characters. */
+	const FTPPSignificanceTierSettings& GetSignificanceTierSettings() const { return SignificanceTierSettings; }
+
+protected:
+
+	UPROPERTY(Transient)
+	ETPPSignificanceTier SignificanceTier = ETPPSignificanceTier::High;
+
+	UPROPERTY(Transient)
+	FTPPSignificanceTierSettings SignificanceTierSettings;
+
 };
 
@@ -8,7 +8,16 @@ public class ThirdPersonProject : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay", "UMG", "GameplayTags" });
-		PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay", "UMG", "GameplayTags", "ReplicationGraph" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore", "NetCore" });
+
+		// Dedicated servers never render or play audio, so particles, decals, sounds, HUD and camera changes are compiled out of them.
+		PublicDefinitions.Add("TPP_WITH_COSMETICS=" + (Target.Type == TargetType.Server ? "0" : "1"));
+
+		// Only needed by the commandlet that reparents anim blueprints.
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(new string[] { "UnrealEd", "BlueprintGraph" });
+		}
 	}
 }
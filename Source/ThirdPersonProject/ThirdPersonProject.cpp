@@ -2,6 +2,22 @@
 
 #include "ThirdPersonProject.h"
 #include "Modules/ModuleManager.h"
+#include "Debug/TPPStartupProfiler.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ThirdPersonProject, "ThirdPersonProject" );
+class FThirdPersonProjectModule : public FDefaultGameModuleImpl
+{
+public:
+
+	virtual void StartupModule() override
+	{
+		FTPPStartupProfiler::Get().Initialize();
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FTPPStartupProfiler::Get().Shutdown();
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FThirdPersonProjectModule, ThirdPersonProject, "ThirdPersonProject" );
  
\ No newline at end of file
@@ -4,3 +4,5 @@
 
 #include "CoreMinimal.h"
 #include "Engine.h"
+
+DECLARE_STATS_GROUP(TEXT("ThirdPersonProject"), STATGROUP_ThirdPersonProject, STATCAT_Advanced);
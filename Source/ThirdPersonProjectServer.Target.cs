@@ -0,0 +1,20 @@
+// Copyright 1998-2019 Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+public class ThirdPersonProjectServerTarget : TargetRules
+{
+	public ThirdPersonProjectServerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+		DefaultBuildSettings = BuildSettingsVersion.V2;
+		ExtraModuleNames.Add("ThirdPersonProject");
+
+		// Replicated properties are push based and only compared after being marked dirty.
+		// Push model changes engine defines, so it needs its own build environment and therefore a source build of the engine.
+		// The game and editor targets build against the installed engine, where MARK_PROPERTY_DIRTY compiles to nothing.
+		BuildEnvironment = TargetBuildEnvironment.Unique;
+		bWithPushModel = true;
+	}
+}